@@ -33,3 +33,27 @@
 #define YENXO_ENABLE_TYPE_SAFE 1
 #endif
 #endif
+
+#ifdef YENXO_DOXYGEN_INVOKED
+/// \ingroup group-config
+/// Whether exceptions are enabled, detected from the compiler. Without them the
+/// throwing API aborts on errors and `tryFromVariant` should be used instead.
+#define YENXO_EXCEPTIONS 1
+#else
+#ifndef YENXO_EXCEPTIONS
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define YENXO_EXCEPTIONS 1
+#else
+#define YENXO_EXCEPTIONS 0
+#endif
+#endif
+#endif
+
+/// \ingroup group-config
+/// Throw the exception, or abort if exceptions are disabled
+#if YENXO_EXCEPTIONS
+#define YENXO_THROW(...) throw __VA_ARGS__
+#else
+#include <cstdlib>
+#define YENXO_THROW(...) std::abort()
+#endif
@@ -24,7 +24,10 @@
 
 #pragma once
 
+#include <yenxo/enum_traits.hpp>
+#include <yenxo/exception.hpp>
 #include <yenxo/preprocessor.hpp>
+#include <yenxo/string_conversion.hpp>
 #include <yenxo/type_name.hpp>
 
 #include <boost/hana/detail/preprocessor.hpp>
@@ -35,23 +38,7 @@
 #include <cassert>
 #include <iostream>
 #include <stdexcept>
-
-namespace yenxo {
-
-/// Enum value is not handled or the value is not of the enum at all
-///
-/// \ingroup group-exceptions
-class BadEnumValue : public std::runtime_error {
-public:
-    template <class E>
-    explicit BadEnumValue(E v)
-            : std::runtime_error("'" + std::to_string(std::underlying_type_t<E>(v)) + "'"
-                                 + " is not of type '"
-                                 + std::string(typeName(boost::hana::type_c<E>)) + "'") {
-    }
-};
-
-} // namespace yenxo
+#include <type_traits>
 
 // Enum init
 // Given a tuple (x) || (x,) || (x,1,) || (x,1,"x") || (x,,"x") || (x,,)
@@ -129,9 +116,64 @@ auto DEFINE_ENUM(...) = ;
 #define DEFINE_STRUCT(Type, ...) see documentation
 #else
 #define DEFINE_ENUM(Type, ...)                                                           \
-    DEFINE_ENUM_IMPL(BOOST_HANA_PP_NARG(__VA_ARGS__), Type, __VA_ARGS__)
+    DEFINE_ENUM_IMPL(BOOST_HANA_PP_NARG(__VA_ARGS__), Type, __VA_ARGS__)                 \
+    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
+        return {};                                                                       \
+    }                                                                                    \
+    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
+        return os << Type##Traits::toString(e);                                          \
+    }                                                                                    \
+    struct ANONYMOUS_STRUCT
+#endif
+
+/// Generates a flags enum, `yenxo::EnumTraits` marking it as flags and the bitwise
+/// operators for it
+/// \ingroup group-enum
+///
+/// The values are listed as for `DEFINE_ENUM` and are given their bits explicitly. A
+/// value with several bits names their combination, it is accepted by `fromString` and
+/// `fromVariant` but never produced. `toString` joins the names of the set bits with `|`,
+/// `toVariant` lists them.
+///
+/// \code
+/// DEFINE_FLAGS_ENUM(Permission, (read, 1), (write, 2), (exec, 4), (all, 7));
+///
+/// toString(Permission::read | Permission::exec); // "read|exec"
+/// fromVariant<Permission>(Variant(VariantVec{"all"})); // read | write | exec
+/// \endcode
+#ifdef YENXO_DOXYGEN_INVOKED
+auto DEFINE_FLAGS_ENUM(...) = ;
+#else
+#define DEFINE_FLAGS_ENUM(Type, ...)                                                     \
+    DEFINE_ENUM_IMPL(BOOST_HANA_PP_NARG(__VA_ARGS__), Type, __VA_ARGS__)                 \
+    struct [[maybe_unused]] Type##FlagsTraits : Type##Traits {                           \
+        [[maybe_unused]] static constexpr bool flags = true;                             \
+    };                                                                                   \
+    [[maybe_unused]] inline Type##FlagsTraits traits(Type) {                             \
+        return {};                                                                       \
+    }                                                                                    \
+    FLAGS_OPERATORSe(Type, |)                                                            \
+    FLAGS_OPERATORSe(Type, &)                                                            \
+    FLAGS_OPERATORSe(Type, ^)                                                            \
+    [[maybe_unused]] constexpr Type operator~(Type x) noexcept {                         \
+        return Type(~std::underlying_type_t<Type>(x));                                   \
+    }                                                                                    \
+    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
+        return os << yenxo::toString(e);                                                 \
+    }                                                                                    \
+    struct ANONYMOUS_STRUCT
 #endif
 
+// Bitwise operator `op` and its compound assignment for the flags enum `Type`
+#define FLAGS_OPERATORSe(Type, op)                                                       \
+    [[maybe_unused]] constexpr Type operator op(Type a, Type b) noexcept {               \
+        using U = std::underlying_type_t<Type>;                                          \
+        return Type(U(a) op U(b));                                                       \
+    }                                                                                    \
+    [[maybe_unused]] constexpr Type& operator op##=(Type& a, Type b) noexcept {          \
+        return a = a op b;                                                               \
+    }
+
 #define DEFINE_ENUM_IMPL(N, Type, ...)                                                   \
     BOOST_HANA_PP_CONCAT(DEFINE_ENUM_IMPL_, N)                                           \
     (Type, __VA_ARGS__)
@@ -158,14 +200,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_2(Type, e1, e2)                                                 \
     DEFINE_ENUM_IMPL_2_(Type, RESOLVE_VALUEe(e1), RESOLVE_VALUEe(e2))
@@ -194,14 +229,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_3(Type, e1, e2, e3)                                             \
     DEFINE_ENUM_IMPL_3_(Type, RESOLVE_VALUEe(e1), RESOLVE_VALUEe(e2), RESOLVE_VALUEe(e3))
@@ -234,14 +262,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_4(Type, e1, e2, e3, e4)                                         \
     DEFINE_ENUM_IMPL_4_(Type,                                                            \
@@ -283,14 +304,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_5(Type, e1, e2, e3, e4, e5)                                     \
     DEFINE_ENUM_IMPL_5_(Type,                                                            \
@@ -337,14 +351,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_6(Type, e1, e2, e3, e4, e5, e6)                                 \
     DEFINE_ENUM_IMPL_6_(Type,                                                            \
@@ -400,14 +407,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_7(Type, e1, e2, e3, e4, e5, e6, e7)                             \
     DEFINE_ENUM_IMPL_7_(Type,                                                            \
@@ -469,14 +469,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_8(Type, e1, e2, e3, e4, e5, e6, e7, e8)                         \
     DEFINE_ENUM_IMPL_8_(Type,                                                            \
@@ -544,14 +537,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_9(Type, e1, e2, e3, e4, e5, e6, e7, e8, e9)                     \
     DEFINE_ENUM_IMPL_9_(Type,                                                            \
@@ -625,14 +611,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_10(Type, e1, e2, e3, e4, e5, e6, e7, e8, e9, e10)               \
     DEFINE_ENUM_IMPL_10_(Type,                                                           \
@@ -712,14 +691,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_11(Type, e1, e2, e3, e4, e5, e6, e7, e8, e9, e10, e11)          \
     DEFINE_ENUM_IMPL_11_(Type,                                                           \
@@ -805,14 +777,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_12(Type, e1, e2, e3, e4, e5, e6, e7, e8, e9, e10, e11, e12)     \
     DEFINE_ENUM_IMPL_12_(Type,                                                           \
@@ -904,14 +869,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_13(                                                             \
         Type, e1, e2, e3, e4, e5, e6, e7, e8, e9, e10, e11, e12, e13)                    \
@@ -1011,14 +969,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_14(                                                             \
         Type, e1, e2, e3, e4, e5, e6, e7, e8, e9, e10, e11, e12, e13, e14)               \
@@ -1124,14 +1075,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_15(                                                             \
         Type, e1, e2, e3, e4, e5, e6, e7, e8, e9, e10, e11, e12, e13, e14, e15)          \
@@ -1243,14 +1187,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_16(                                                             \
         Type, e1, e2, e3, e4, e5, e6, e7, e8, e9, e10, e11, e12, e13, e14, e15, e16)     \
@@ -1368,14 +1305,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_17(Type,                                                        \
                             e1,                                                          \
@@ -1531,14 +1461,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_18(Type,                                                        \
                             e1,                                                          \
@@ -1702,14 +1625,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_19(Type,                                                        \
                             e1,                                                          \
@@ -1881,14 +1797,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_20(Type,                                                        \
                             e1,                                                          \
@@ -2040,14 +1949,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_21(Type,                                                        \
                             e1,                                                          \
@@ -2206,14 +2108,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_22(Type,                                                        \
                             e1,                                                          \
@@ -2379,14 +2274,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_23(Type,                                                        \
                             e1,                                                          \
@@ -2558,14 +2446,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_24(Type,                                                        \
                             e1,                                                          \
@@ -2743,14 +2624,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_25(Type,                                                        \
                             e1,                                                          \
@@ -2935,14 +2809,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_26(Type,                                                        \
                             e1,                                                          \
@@ -3134,14 +3001,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_27(Type,                                                        \
                             e1,                                                          \
@@ -3339,14 +3199,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_28(Type,                                                        \
                             e1,                                                          \
@@ -3551,14 +3404,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_29(Type,                                                        \
                             e1,                                                          \
@@ -3769,14 +3615,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_30(Type,                                                        \
                             e1,                                                          \
@@ -3993,14 +3832,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_31(Type,                                                        \
                             e1,                                                          \
@@ -4225,14 +4057,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_32(Type,                                                        \
                             e1,                                                          \
@@ -4463,14 +4288,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_33(Type,                                                        \
                             e1,                                                          \
@@ -4707,14 +4525,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_34(Type,                                                        \
                             e1,                                                          \
@@ -4958,14 +4769,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_35(Type,                                                        \
                             e1,                                                          \
@@ -5215,14 +5019,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_36(Type,                                                        \
                             e1,                                                          \
@@ -5479,14 +5276,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_37(Type,                                                        \
                             e1,                                                          \
@@ -5750,14 +5540,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_38(Type,                                                        \
                             e1,                                                          \
@@ -6027,14 +5810,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_39(Type,                                                        \
                             e1,                                                          \
@@ -6310,14 +6086,7 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
 
 #define DEFINE_ENUM_IMPL_40(Type,                                                        \
                             e1,                                                          \
@@ -6600,11 +6369,4 @@ auto DEFINE_ENUM(...) = ;
         [[maybe_unused]] static constexpr std::string_view typeName() noexcept {         \
             return BOOST_HANA_PP_STRINGIZE(Type);                                        \
         }                                                                                \
-    };                                                                                   \
-    [[maybe_unused]] inline Type##Traits traits(Type) {                                  \
-        return {};                                                                       \
-    }                                                                                    \
-    [[maybe_unused]] inline std::ostream& operator<<(std::ostream& os, Type e) {         \
-        return os << Type##Traits::toString(e);                                          \
-    }                                                                                    \
-    struct ANONYMOUS_STRUCT
+    };
@@ -25,9 +25,22 @@
 #pragma once
 
 #include <yenxo/meta.hpp>
+#include <yenxo/string_hash.hpp>
 #include <yenxo/when.hpp>
 
+#include <boost/hana/at.hpp>
+#include <boost/hana/bool.hpp>
+#include <boost/hana/for_each.hpp>
+#include <boost/hana/length.hpp>
+#include <boost/hana/range.hpp>
+#include <boost/hana/unpack.hpp>
+
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <type_traits>
 
 namespace yenxo {
 
@@ -87,4 +100,192 @@ struct EnumTraits<
                      T> && detail::Valid<decltype(traits(std::declval<T>()))>::value>>
         : decltype(traits(std::declval<T>())) {};
 
+namespace detail {
+
+/// Number of the spellings of the values of `E`, including the alternative ones
+/// \ingroup group-details
+template <class E>
+constexpr std::size_t enumSpellingCount() noexcept {
+    if constexpr (hasStrings(boost::hana::type_c<EnumTraits<E>>)) {
+        return boost::hana::unpack(EnumTraits<E>::strings(), [](auto const&... x) {
+            return (std::size_t(0) + ... + decltype(boost::hana::length(x))::value);
+        });
+    } else {
+        return EnumTraits<E>::count;
+    }
+}
+
+/// Open addressing table from the spellings of the values of `E` to the values
+/// \ingroup group-details
+///
+/// A spelling shared by several values resolves to the first of them, as a linear scan
+/// over `EnumTraits<E>::values` would.
+template <class E>
+class EnumIndex {
+public:
+    static constexpr std::size_t size = enumSpellingCount<E>();
+
+    EnumIndex() noexcept {
+        slots_.fill(size);
+        std::size_t n = 0;
+        auto const add = [&](std::string_view name, E value) {
+            auto s = fnv1a(name) & (capacity - 1);
+            for (; slots_[s] != size; s = (s + 1) & (capacity - 1)) {
+                if (entries_[slots_[s]].name == name) {
+                    return;
+                }
+            }
+            entries_[n] = {name, value};
+            slots_[s] = n++;
+        };
+        if constexpr (hasStrings(boost::hana::type_c<EnumTraits<E>>)) {
+            boost::hana::for_each(
+                    boost::hana::make_range(boost::hana::size_c<0>,
+                                            boost::hana::size_c<EnumTraits<E>::count>),
+                    [&](auto i) {
+                        auto const names = boost::hana::at(EnumTraits<E>::strings(), i);
+                        boost::hana::for_each(names, [&](auto name) {
+                            add(name, EnumTraits<E>::values[i]);
+                        });
+                    });
+        } else {
+            for (auto const e : EnumTraits<E>::values) {
+                add(EnumTraits<E>::toString(e), e);
+            }
+        }
+    }
+
+    /// \return the value spelled `x` if any
+    std::optional<E> find(std::string_view x) const noexcept {
+        for (auto s = fnv1a(x) & (capacity - 1);; s = (s + 1) & (capacity - 1)) {
+            auto const i = slots_[s];
+            if (i == size) {
+                return std::nullopt;
+            }
+            if (entries_[i].name == x) {
+                return entries_[i].value;
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        std::string_view name;
+        E value;
+    };
+
+    static constexpr std::size_t capacity = [] {
+        std::size_t x = 1;
+        while (x < 2 * size) {
+            x *= 2;
+        }
+        return x;
+    }();
+
+    std::array<Entry, size> entries_{};
+    std::array<std::size_t, capacity> slots_;
+};
+
+} // namespace detail
+
+/// Find the value of `E` spelled `x`
+/// \ingroup group-enum
+///
+/// Every spelling listed by `EnumTraits<E>` is recognized, the lookup is a hash table
+/// probe built on the first use.
+template <class E>
+std::optional<E> enumFromString(std::string_view x) noexcept {
+    static detail::EnumIndex<E> const index;
+    return index.find(x);
+}
+
+namespace detail {
+
+template <class E, class = void>
+struct IsFlagsEnum : std::false_type {};
+
+template <class E>
+struct IsFlagsEnum<E, std::void_t<decltype(EnumTraits<E>::flags)>>
+        : std::bool_constant<EnumTraits<E>::flags> {};
+
+} // namespace detail
+
+/// Check if `type` is an enum type whose `EnumTraits` define
+/// `static constexpr bool flags = true`
+/// \ingroup group-enum
+///
+/// A flags enum converts to and from a list of the names of the bits set in the value.
+inline constexpr auto isFlagsEnum = [](auto type) {
+    return boost::hana::bool_c<detail::IsFlagsEnum<typename decltype(type)::type>::value>;
+};
+
+namespace detail {
+
+/// Unsigned integer holding the bits of the flags enum `E`
+/// \ingroup group-details
+template <class E>
+using FlagsMask = std::make_unsigned_t<std::underlying_type_t<E>>;
+
+/// Index of the lowest set bit of `x`, `x` is not zero
+/// \ingroup group-details
+constexpr unsigned lowestBit(uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+    unsigned ret = 0;
+    for (; (x & 1) == 0; x >>= 1) {
+        ++ret;
+    }
+    return ret;
+#endif
+}
+
+/// Names of the single-bit values of the flags enum `E` by bit position
+/// \ingroup group-details
+///
+/// Values with several bits or none are aliases of combinations, they are recognized by
+/// `enumFromString` but never produced.
+template <class E>
+class FlagsIndex {
+public:
+    FlagsIndex() noexcept {
+        for (auto const e : EnumTraits<E>::values) {
+            auto const m = static_cast<FlagsMask<E>>(e);
+            if (m != 0 && (m & (m - 1)) == 0 && !(known_ & m)) {
+                names_[lowestBit(m)] = EnumTraits<E>::toString(e);
+                known_ |= m;
+            }
+        }
+    }
+
+    /// Bits named by some value
+    FlagsMask<E> known() const noexcept {
+        return known_;
+    }
+
+    /// Name of the bit `i`, the bit is known
+    char const* name(unsigned i) const noexcept {
+        return names_[i];
+    }
+
+private:
+    std::array<char const*, sizeof(FlagsMask<E>) * 8> names_{};
+    FlagsMask<E> known_{};
+};
+
+} // namespace detail
+
+/// Call `f` with the name of every bit set in the flags `x`, the lowest bit first
+/// \ingroup group-enum
+/// \return the bits of `x` that no value of `E` names
+template <class E, class F>
+detail::FlagsMask<E> forEachFlag(E x, F&& f) {
+    static detail::FlagsIndex<E> const index;
+    auto const m = static_cast<detail::FlagsMask<E>>(x);
+    for (auto rest = m & index.known(); rest != 0; rest &= rest - 1) {
+        f(index.name(detail::lowestBit(rest)));
+    }
+    return static_cast<detail::FlagsMask<E>>(m & ~index.known());
+}
+
 } // namespace yenxo
@@ -28,42 +28,106 @@
 
 #include <boost/hana/type.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
 
 namespace yenxo {
 
+namespace detail {
+
+template <class T>
+std::string typeNameOf() {
+    return std::string(typeName(boost::hana::type_c<T>));
+}
+
+/// Path to a failed value as a stack of frames, the innermost first
+/// \ingroup group-details
+///
+/// Recording a frame does not format anything, the JSON pointer is rendered on request.
+class ErrorPath {
+public:
+    void prependIndex(std::size_t i) {
+        frames_.emplace_back(i);
+    }
+
+    void prependKey(std::string key) {
+        frames_.emplace_back(std::move(key));
+    }
+
+    bool empty() const noexcept {
+        return frames_.empty();
+    }
+
+    /// The JSON pointer, empty for the root
+    std::string render() const;
+
+private:
+    std::vector<std::variant<std::size_t, std::string>> frames_;
+};
+
+} // namespace detail
+
 /// An error identifying `Variant` error
 /// \ingroup group-exceptions
+///
+/// The message and the path are rendered on the first call of `what()` and `path()`, so
+/// an error that is caught and dropped costs no formatting. The rendering is not
+/// synchronized, an error object should not be inspected by several threads at once.
 class VariantErr : public std::runtime_error {
 public:
     explicit VariantErr(std::string const& msg)
             : runtime_error(msg) {
     }
 
+    /// Record the enclosing member
     void prependPath(std::string val) {
-        replace_all(val, "~", "~0");
-        replace_all(val, "/", "~1");
-        path_ += "/" + val + path_;
+        frames_.prependKey(std::move(val));
+        path_ready_ = false;
     }
 
-    std::string const& path() const noexcept {
-        return path_;
+    /// Record the enclosing list element
+    void prependPath(std::size_t i) {
+        frames_.prependIndex(i);
+        path_ready_ = false;
     }
 
-private:
-    static void replace_all(std::string& val,
-                            std::string_view old,
-                            std::string_view new_) {
-        size_t i{};
-        while ((i = val.find(old, i)) != std::string::npos) {
-            val.replace(i, 1, new_);
-            i += new_.size();
-        }
+    /// JSON pointer to the failed value
+    std::string const& path() const noexcept;
+
+    char const* what() const noexcept override;
+
+protected:
+    using TypeNameFn = std::string (*)();
+
+    enum class Kind : uint8_t { text, empty, bad_type, bad_value, overflow };
+
+    VariantErr(Kind kind, TypeNameFn expected, TypeNameFn actual, std::string value)
+            : runtime_error("")
+            , kind_(kind)
+            , expected_(expected)
+            , actual_(actual)
+            , value_(std::move(value)) {
     }
 
-    std::string path_;
+private:
+    std::string render() const;
+
+    Kind kind_{Kind::text};
+    TypeNameFn expected_{};
+    TypeNameFn actual_{};
+    std::string value_;
+    detail::ErrorPath frames_;
+    mutable std::string message_;
+    mutable std::string path_;
+    mutable bool message_ready_{false};
+    mutable bool path_ready_{true};
 };
 
 /// Empty Variant error
@@ -71,8 +135,8 @@ private:
 class VariantEmpty final : public VariantErr {
 public:
     template <class T>
-    explicit VariantEmpty(boost::hana::basic_type<T> t)
-            : VariantErr("expected '" + std::string(typeName(t)) + "', actual: 'Empty'") {
+    explicit VariantEmpty(boost::hana::basic_type<T>)
+            : VariantErr(Kind::empty, &detail::typeNameOf<T>, nullptr, {}) {
     }
 };
 
@@ -81,9 +145,11 @@ public:
 class VariantBadType final : public VariantErr {
 public:
     template <class E, class A>
-    VariantBadType(boost::hana::basic_type<E> e, boost::hana::basic_type<A> a)
-            : VariantErr("expected '" + std::string(typeName(e)) + "', actual '"
-                         + std::string(typeName(a)) + "'") {
+    VariantBadType(boost::hana::basic_type<E>, boost::hana::basic_type<A>)
+            : VariantErr(Kind::bad_type,
+                         &detail::typeNameOf<E>,
+                         &detail::typeNameOf<A>,
+                         {}) {
     }
 
     VariantBadType(std::string const& msg)
@@ -91,9 +157,11 @@ public:
     }
 
     template <class T>
-    VariantBadType(std::string const& value, boost::hana::basic_type<T> t)
-            : VariantErr("'" + value + "'" + " is not of type '"
-                         + std::string(typeName(t)) + "'") {
+    VariantBadType(std::string value, boost::hana::basic_type<T>)
+            : VariantErr(Kind::bad_value,
+                         &detail::typeNameOf<T>,
+                         nullptr,
+                         std::move(value)) {
     }
 };
 
@@ -105,6 +173,14 @@ public:
             : VariantErr("The type '" + type_name + "' can not hold the value '" + value
                          + "'") {
     }
+
+    template <class T>
+    VariantIntegralOverflow(boost::hana::basic_type<T>, std::string value)
+            : VariantErr(Kind::overflow,
+                         &detail::typeNameOf<T>,
+                         nullptr,
+                         std::move(value)) {
+    }
 };
 
 /// String conversion error
@@ -123,4 +199,17 @@ struct StringConversionError : public std::logic_error {
     }
 };
 
+/// Enum value is not handled or the value is not of the enum at all
+///
+/// \ingroup group-exceptions
+class BadEnumValue : public std::runtime_error {
+public:
+    template <class E>
+    explicit BadEnumValue(E v)
+            : std::runtime_error("'" + std::to_string(std::underlying_type_t<E>(v)) + "'"
+                                 + " is not of type '"
+                                 + std::string(typeName(boost::hana::type_c<E>)) + "'") {
+    }
+};
+
 } // namespace yenxo
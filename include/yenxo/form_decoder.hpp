@@ -0,0 +1,122 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <yenxo/from_query_string.hpp>
+#include <yenxo/query_string.hpp>
+#include <yenxo/variant_fwd.hpp>
+#include <yenxo/variant_traits.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace yenxo {
+
+/// Streaming decoder of `application/x-www-form-urlencoded` bodies
+/// \ingroup group-http
+///
+/// Decodes the grammar of `query_string` into the same objects, a `Variant` or a struct
+/// as `fromQueryString` does, from a body fed chunk by chunk. Only the unfinished
+/// parameter at the end of a chunk is kept until the next one, so a chunk may end
+/// anywhere, inside a percent-encoding as well. The limits are set for forms rather
+/// than URLs. A decoder is reusable, keep one per thread.
+///
+/// \code
+/// FormDecoder decoder;
+/// Variant form;
+/// decoder.start(form);
+/// while (auto const chunk = read()) {
+///     decoder.feed(*chunk);
+/// }
+/// decoder.finish();
+/// \endcode
+class FormDecoder {
+public:
+    struct Options {
+        std::size_t array_length{1000};
+        std::size_t object_depth{20};
+        std::size_t object_property_count{1000};
+
+        /// Length of an encoded parameter, bounds the state kept between the chunks
+        std::size_t param_length{std::size_t(1) << 20};
+
+        /// Decode `+` as space, as browsers encode forms
+        bool plus_as_space{true};
+    };
+
+    /// Decoder with the default options
+    FormDecoder();
+
+    explicit FormDecoder(Options const& options);
+
+    ~FormDecoder() noexcept;
+
+    FormDecoder(FormDecoder&& rhs) noexcept;
+    FormDecoder& operator=(FormDecoder&& rhs) noexcept;
+
+    Options const& options() const noexcept;
+
+    /// Start decoding a body into `out`, the previous content of `out` is replaced
+    ///
+    /// `out` is to stay alive till `finish`.
+    void start(Variant& out);
+
+    /// Start decoding a body into `out`, see `fromQueryString`
+    ///
+    /// `out` is reset to `T()` first, so nothing is left from a previous body. `out` is
+    /// to stay alive till `finish`.
+    template <class T, class Policy = trait::VarPolicy>
+    void start(T& out) {
+        out = T();
+        auto decoder = std::make_unique<detail::QueryDecoder>(
+                queryLimits(), detail::queryTarget<T, Policy>(out));
+        startDecoder(std::move(decoder));
+    }
+
+    /// Decode the next chunk of the body
+    /// \throw QueryStringError
+    void feed(std::string_view chunk);
+
+    /// Decode the rest of the body
+    /// \throw QueryStringError
+    void finish();
+
+private:
+    struct Impl;
+
+    QueryStringParser::Limits queryLimits() const noexcept;
+    void startDecoder(std::unique_ptr<detail::QueryDecoder> decoder);
+
+    std::unique_ptr<Impl> impl_;
+};
+
+/// Decode the whole `application/x-www-form-urlencoded` body `str`
+/// \ingroup group-http
+/// \throw QueryStringError
+/// \return VariantMap
+Variant decodeForm(std::string_view str, FormDecoder::Options const& options = {});
+
+} // namespace yenxo
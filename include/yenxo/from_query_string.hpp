@@ -0,0 +1,584 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <yenxo/enum_traits.hpp>
+#include <yenxo/meta.hpp>
+#include <yenxo/query_string.hpp>
+#include <yenxo/type_name.hpp>
+#include <yenxo/variant_traits.hpp>
+#include <yenxo/when.hpp>
+
+#include <boost/hana.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace yenxo {
+namespace detail {
+
+class QueryDecoder;
+
+/// Type-erased position in the object being decoded from a query string
+/// \ingroup group-details
+struct QueryTarget {
+    struct Ops {
+        /// Called once the value comes to existence with its key, may be null
+        void (*created)(void* obj, QueryDecoder& decoder, std::string key);
+        QueryTarget (*property)(void* obj, std::string_view key, QueryDecoder& decoder);
+        QueryTarget (*index)(void* obj, uint64_t i, QueryDecoder& decoder);
+        void (*emptyIndex)(void* obj, QueryDecoder& decoder);
+        void (*value)(void* obj, std::string_view x, QueryDecoder& decoder);
+    };
+
+    void* obj;
+    Ops const* ops;
+};
+
+/// Decodes the parameters reported by `QueryStringParser::scan` into a `QueryTarget`
+/// \ingroup group-details
+///
+/// Keeps the key of the current target for the error messages, counts the depth and
+/// tracks the members of the decoded structs to fill the missing ones in `finish`.
+class QueryDecoder final : public QueryStringParser::Handler {
+public:
+    /// Fill the members of a struct not marked in `seen`
+    /// \return the name of the first required member without a default
+    using Finish = std::optional<std::string> (*)(void* obj, char const* seen);
+
+    QueryDecoder(QueryStringParser::Limits const& limits, QueryTarget root);
+
+    void paramName(std::string_view name) override;
+    void indexOp(uint64_t i) override;
+    void propertyOp(std::string_view key) override;
+    void emptyIndexOp() override;
+    void value(std::string_view key, std::string_view x) override;
+
+    /// Fill the missing members of the decoded structs
+    /// \throw QueryStringError if a required member is missing
+    void finish();
+
+    QueryStringParser::Limits const& limits() const noexcept {
+        return limits_;
+    }
+
+    /// Key of the current target, e.g. `a[0][b]`, empty for the root
+    std::string const& key() const noexcept {
+        return key_;
+    }
+
+    /// Key of the member `x` of the current target
+    std::string childKey(std::string_view x) const;
+
+    /// Key of the element `i` of the current target
+    std::string childKey(uint64_t i) const;
+
+    /// Start tracking the members of the struct `obj`
+    void track(void* obj, std::size_t field_count, Finish finish, std::string key);
+
+    /// Mark the member `i` of the tracked struct `obj`
+    /// \return true if the member is marked for the first time
+    bool mark(void const* obj, Finish finish, std::size_t i) noexcept;
+
+    /// Follow the tracked structs moved from `[old, old + size)` to `now`
+    void relocated(void const* old, std::size_t size, void const* now) noexcept;
+
+    /// \throw QueryStringError
+    /// @{
+    [[noreturn]] void mixedTypes(char const* expected, char const* actual) const;
+    [[noreturn]] void badValue(std::string_view x, std::string_view type) const;
+    [[noreturn]] void unknownMember(std::string_view x) const;
+    [[noreturn]] void propertyCountExceeded() const;
+    [[noreturn]] void arrayIndexExceeded() const;
+    [[noreturn]] void arrayLengthExceeded() const;
+    /// @}
+
+private:
+    struct Tracked {
+        void const* obj;
+        Finish finish;
+        std::size_t first;
+        std::string key;
+    };
+
+    QueryStringParser::Limits limits_;
+    QueryTarget root_;
+    QueryTarget current_;
+    std::string param_name_;
+    std::string key_;
+    std::size_t depth_{0};
+    std::vector<Tracked> tracked_;
+    std::vector<char> seen_;
+};
+
+template <class T, class Policy, class = void>
+struct QueryOpsImpl : QueryOpsImpl<T, Policy, When<true>> {};
+
+/// Operations of `T` as a `QueryTarget`
+/// \ingroup group-details
+template <class T, class Policy>
+inline constexpr QueryTarget::Ops query_ops{QueryOpsImpl<T, Policy>::created,
+                                            QueryOpsImpl<T, Policy>::property,
+                                            QueryOpsImpl<T, Policy>::index,
+                                            QueryOpsImpl<T, Policy>::emptyIndex,
+                                            QueryOpsImpl<T, Policy>::value};
+
+template <class T, class Policy>
+QueryTarget queryTarget(T& x) noexcept {
+    return {&x, &query_ops<T, Policy>};
+}
+
+/// Shared parts of the operations, a target rejects what it does not override
+template <class T, char const* kind>
+struct QueryOpsBase {
+    /// If `created` tracks the value
+    static constexpr bool tracked = false;
+    static constexpr void (*created)(void*, QueryDecoder&, std::string) = nullptr;
+
+    static QueryTarget property(void*, std::string_view, QueryDecoder& decoder) {
+        decoder.mixedTypes("map", kind);
+    }
+
+    static QueryTarget index(void*, uint64_t, QueryDecoder& decoder) {
+        decoder.mixedTypes("vec", kind);
+    }
+
+    static void emptyIndex(void*, QueryDecoder& decoder) {
+        decoder.mixedTypes("vec", kind);
+    }
+
+    static void value(void*, std::string_view, QueryDecoder& decoder) {
+        decoder.mixedTypes(kind, "string");
+    }
+
+    static T& self(void* obj) noexcept {
+        return *static_cast<T*>(obj);
+    }
+};
+
+inline constexpr char query_kind_map[] = "map";
+inline constexpr char query_kind_vec[] = "vec";
+inline constexpr char query_kind_string[] = "string";
+
+template <class T, class Policy, bool condition>
+struct QueryOpsImpl<T, Policy, When<condition>> {
+    static_assert(T::is_not_decodable_from_query_string);
+};
+
+/// Target of an unknown parameter, swallows everything
+struct QueryIgnored {};
+
+template <class Policy>
+struct QueryOpsImpl<QueryIgnored, Policy>
+        : QueryOpsBase<QueryIgnored, query_kind_string> {
+    static QueryTarget property(void* obj, std::string_view, QueryDecoder&) noexcept {
+        return {obj, &query_ops<QueryIgnored, Policy>};
+    }
+
+    static QueryTarget index(void* obj, uint64_t, QueryDecoder&) noexcept {
+        return {obj, &query_ops<QueryIgnored, Policy>};
+    }
+
+    static void emptyIndex(void*, QueryDecoder&) noexcept {
+    }
+
+    static void value(void*, std::string_view, QueryDecoder&) noexcept {
+    }
+};
+
+inline constexpr auto hasEnumTypeName = boost::hana::is_valid(
+        [](auto t) -> decltype((void)EnumTraits<
+                               typename decltype(t)::type>::typeName()) {});
+
+/// Name of the scalar `T` in the error messages
+template <class T>
+constexpr std::string_view queryTypeName() noexcept {
+    if constexpr (std::is_same_v<T, bool>) {
+        return "boolean";
+    } else if constexpr (std::is_same_v<T, char>) {
+        return "char";
+    } else if constexpr (std::is_integral_v<T>) {
+        constexpr std::string_view names[] = {
+                "uint8", "uint16", "uint32", "uint64", "int8", "int16", "int32", "int64"};
+        constexpr std::size_t size = sizeof(T) == 1 ? 0
+                                   : sizeof(T) == 2 ? 1
+                                   : sizeof(T) == 4 ? 2
+                                                    : 3;
+        return names[(std::is_signed_v<T> ? 4 : 0) + size];
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return "double";
+    } else if constexpr (hasEnumTypeName(boost::hana::type_c<T>)) {
+        return EnumTraits<T>::typeName();
+    } else {
+        return "enum";
+    }
+}
+
+/// Parse the percent-decoded `x`
+template <class T>
+void parseQueryValue(T& ret, std::string_view x, QueryDecoder& decoder) {
+    auto const type = boost::hana::type_c<T>;
+    constexpr auto type_name = queryTypeName<T>();
+    auto const first = x.data();
+    auto const last = first + x.size();
+    if constexpr (isString(type)) {
+        ret.assign(first, last);
+    } else if constexpr (std::is_same_v<T, bool>) {
+        if (x == "true") {
+            ret = true;
+        } else if (x == "false") {
+            ret = false;
+        } else {
+            decoder.badValue(x, type_name);
+        }
+    } else if constexpr (std::is_same_v<T, char>) {
+        if (x.size() != 1) {
+            decoder.badValue(x, type_name);
+        }
+        ret = x.front();
+    } else if constexpr (std::is_integral_v<T>) {
+        auto const [end, ec] = std::from_chars(first, last, ret);
+        if (ec != std::errc() || end != last) {
+            decoder.badValue(x, type_name);
+        }
+    } else if constexpr (std::is_floating_point_v<T>) {
+#if defined(__cpp_lib_to_chars)
+        auto const [end, ec] = std::from_chars(first, last, ret);
+        if (ec != std::errc() || end != last) {
+            decoder.badValue(x, type_name);
+        }
+#else
+        // `strtod` wants a terminated string
+        char buf[64];
+        if (x.empty() || x.size() >= sizeof(buf)) {
+            decoder.badValue(x, type_name);
+        }
+        *std::copy(first, last, buf) = '\0';
+        char* end;
+        ret = static_cast<T>(std::strtod(buf, &end));
+        if (end != buf + x.size()) {
+            decoder.badValue(x, type_name);
+        }
+#endif
+    } else {
+        if (auto const e = enumFromString<T>(x)) {
+            ret = *e;
+        } else {
+            decoder.badValue(x, type_name);
+        }
+    }
+}
+
+/// Strings, numbers and enums, a repeated parameter takes the last value
+template <class T, class Policy>
+struct QueryOpsImpl<T,
+                    Policy,
+                    When<(isString(boost::hana::type_c<T>) || std::is_arithmetic_v<T>
+                          || isReflectiveEnum(boost::hana::type_c<T>))
+                         && !isFlagsEnum(boost::hana::type_c<T>)>>
+        : QueryOpsBase<T, query_kind_string> {
+    static void value(void* obj, std::string_view x, QueryDecoder& decoder) {
+        parseQueryValue(*static_cast<T*>(obj), x, decoder);
+    }
+};
+
+/// Boost.Hana strings, the tag of a struct, the value must equal the string
+template <class T, class Policy>
+struct QueryOpsImpl<T, Policy, When<boost::hana::is_a<boost::hana::string_tag, T>>>
+        : QueryOpsBase<T, query_kind_string> {
+    static void value(void*, std::string_view x, QueryDecoder& decoder) {
+        if (x != boost::hana::to<char const*>(T())) {
+            decoder.badValue(x, typeName(boost::hana::type_c<T>));
+        }
+    }
+};
+
+/// Flags enums, the values of repeated parameters and `|`-separated names are combined
+template <class T, class Policy>
+struct QueryOpsImpl<T, Policy, When<isFlagsEnum(boost::hana::type_c<T>)>>
+        : QueryOpsBase<T, query_kind_vec> {
+    static void emptyIndex(void*, QueryDecoder&) noexcept {
+    }
+
+    static void value(void* obj, std::string_view x, QueryDecoder& decoder) {
+        using Mask = FlagsMask<T>;
+        auto& self = *static_cast<T*>(obj);
+        auto mask = static_cast<Mask>(self);
+        while (!x.empty()) {
+            auto const n = std::min(x.find('|'), x.size());
+            T e;
+            parseQueryValue(e, x.substr(0, n), decoder);
+            mask |= static_cast<Mask>(e);
+            x.remove_prefix(std::min(n + 1, x.size()));
+        }
+        self = static_cast<T>(mask);
+    }
+};
+
+template <class T, class Policy>
+struct QueryOpsImpl<T, Policy, When<isOptional(boost::hana::type_c<T>)>> {
+    using Value = typename T::value_type;
+
+    static constexpr bool tracked = false;
+    static constexpr void (*created)(void*, QueryDecoder&, std::string) = nullptr;
+
+    static QueryTarget property(void* obj, std::string_view key, QueryDecoder& decoder) {
+        return query_ops<Value, Policy>.property(get(obj, decoder), key, decoder);
+    }
+
+    static QueryTarget index(void* obj, uint64_t i, QueryDecoder& decoder) {
+        return query_ops<Value, Policy>.index(get(obj, decoder), i, decoder);
+    }
+
+    static void emptyIndex(void* obj, QueryDecoder& decoder) {
+        query_ops<Value, Policy>.emptyIndex(get(obj, decoder), decoder);
+    }
+
+    static void value(void* obj, std::string_view x, QueryDecoder& decoder) {
+        query_ops<Value, Policy>.value(get(obj, decoder), x, decoder);
+    }
+
+private:
+    static Value* get(void* obj, QueryDecoder& decoder) {
+        auto& self = *static_cast<T*>(obj);
+        if (!self) {
+            self.emplace();
+            if constexpr (QueryOpsImpl<Value, Policy>::tracked) {
+                QueryOpsImpl<Value, Policy>::created(&*self, decoder, decoder.key());
+            }
+        }
+        return &*self;
+    }
+};
+
+/// Maps with string keys
+template <class T, class Policy>
+struct QueryOpsImpl<T,
+                    Policy,
+                    When<isContainer(boost::hana::type_c<T>)
+                         && isKeyValue(boost::hana::type_c<typename T::value_type>)>>
+        : QueryOpsBase<T, query_kind_map> {
+    using Value = typename T::mapped_type;
+
+    static QueryTarget property(void* obj, std::string_view key, QueryDecoder& decoder) {
+        auto& self = *static_cast<T*>(obj);
+        auto const [it, inserted] = self.try_emplace(typename T::key_type(key));
+        if (inserted) {
+            if (self.size() > decoder.limits().object_property_count) {
+                decoder.propertyCountExceeded();
+            }
+            if constexpr (QueryOpsImpl<Value, Policy>::tracked) {
+                QueryOpsImpl<Value, Policy>::created(
+                        &it->second, decoder, decoder.childKey(key));
+            }
+        }
+        return queryTarget<Value, Policy>(it->second);
+    }
+};
+
+/// Sequences, a repeated parameter or `[]` appends
+template <class T, class Policy>
+struct QueryOpsImpl<T,
+                    Policy,
+                    When<isContainer(boost::hana::type_c<T>)
+                         && !isKeyValue(boost::hana::type_c<typename T::value_type>)
+                         && detail::Valid<decltype(std::declval<T&>().resize(0))>::value>>
+        : QueryOpsBase<T, query_kind_vec> {
+    using Value = typename T::value_type;
+
+    static QueryTarget index(void* obj, uint64_t i, QueryDecoder& decoder) {
+        auto& self = *static_cast<T*>(obj);
+        if (i >= decoder.limits().array_length) {
+            decoder.arrayIndexExceeded();
+        }
+        if (i >= self.size()) {
+            grow(self, i + 1, decoder);
+        }
+        return queryTarget<Value, Policy>(*std::next(self.begin(), i));
+    }
+
+    static void emptyIndex(void*, QueryDecoder&) noexcept {
+    }
+
+    static void value(void* obj, std::string_view x, QueryDecoder& decoder) {
+        auto& self = *static_cast<T*>(obj);
+        if (self.size() >= decoder.limits().array_length) {
+            decoder.arrayLengthExceeded();
+        }
+        grow(self, self.size() + 1, decoder);
+        query_ops<Value, Policy>.value(&self.back(), x, decoder);
+    }
+
+private:
+    static void grow(T& self, std::size_t n, QueryDecoder& decoder) {
+        auto const size = self.size();
+        if constexpr (detail::Valid<decltype(std::declval<T&>().data())>::value) {
+            // the tracked structs move along with the elements
+            auto const old = self.data();
+            self.resize(n);
+            if (old != self.data() && size != 0) {
+                decoder.relocated(old, size * sizeof(Value), self.data());
+            }
+        } else {
+            self.resize(n);
+        }
+        if constexpr (QueryOpsImpl<Value, Policy>::tracked) {
+            auto it = std::next(self.begin(), size);
+            for (auto i = size; i < n; ++i, ++it) {
+                QueryOpsImpl<Value, Policy>::created(
+                        &*it, decoder, decoder.childKey(uint64_t(i)));
+            }
+        }
+    }
+};
+
+template <class T, class Policy, std::size_t I>
+QueryTarget queryField(void* obj) noexcept {
+    auto const accessor = boost::hana::at_c<I>(boost::hana::accessors<T>());
+    auto& field = boost::hana::second(accessor)(*static_cast<T*>(obj));
+    return queryTarget<std::remove_reference_t<decltype(field)>, Policy>(field);
+}
+
+template <class T, class Policy, std::size_t... I>
+constexpr std::array<QueryTarget (*)(void*) noexcept, sizeof...(I)> makeQueryFields(
+        std::index_sequence<I...>) {
+    return {{&queryField<T, Policy, I>...}};
+}
+
+/// Member targets of `T` by member index
+/// \ingroup group-details
+template <class T, class Policy>
+constexpr auto query_fields = makeQueryFields<T, Policy>(
+        std::make_index_sequence<trait::detail::field_count<T>>());
+
+/// Boost.Hana.Structs, the members are found by the renamed names
+///
+/// With a `Policy::tag` the struct requires the `__tag` parameter, which is tracked
+/// after the members.
+template <class T, class Policy>
+struct QueryOpsImpl<T, Policy, When<boost::hana::Struct<T>::value>>
+        : QueryOpsBase<T, query_kind_map> {
+    static constexpr bool tracked = true;
+
+    static void created(void* obj, QueryDecoder& decoder, std::string key) {
+        decoder.track(obj, field_count + has_tag, &finish, std::move(key));
+    }
+
+    static QueryTarget property(void* obj, std::string_view key, QueryDecoder& decoder) {
+        auto const i = trait::detail::fieldIndex<T, Policy>().find(key);
+        if (i == trait::detail::fieldIndex<T, Policy>().npos) {
+            if constexpr (has_tag) {
+                if (key == "__tag") {
+                    static Tag tag;
+                    decoder.mark(obj, &finish, field_count);
+                    return queryTarget<Tag, Policy>(tag);
+                }
+            }
+            if constexpr (!Policy::allow_additional_properties) {
+                decoder.unknownMember(key);
+            }
+            static QueryIgnored ignored;
+            return queryTarget<QueryIgnored, Policy>(ignored);
+        }
+        auto const ret = query_fields<T, Policy>[i](obj);
+        if (decoder.mark(obj, &finish, i) && ret.ops->created) {
+            ret.ops->created(ret.obj, decoder, decoder.childKey(key));
+        }
+        return ret;
+    }
+
+private:
+    using Tag = std::remove_const_t<decltype(Policy::tag)>;
+    static constexpr auto field_count = trait::detail::field_count<T>;
+    static constexpr bool has_tag = !std::is_same_v<Tag, typename Policy::NoTag>;
+
+    static std::optional<std::string> finish(void* obj, char const* seen) {
+        if (has_tag && !seen[field_count]) {
+            return "__tag";
+        }
+        std::array<bool, field_count> tmp{};
+        std::copy(seen, seen + tmp.size(), tmp.begin());
+        return trait::detail::fillMissing<T, Policy>(*static_cast<T*>(obj), tmp);
+    }
+};
+
+} // namespace detail
+
+/// Decode a query string into `T` using `parser`
+/// \ingroup group-http
+///
+/// The counterpart of `fromVariantImpl<T, Policy>(query_string(str))` without the
+/// intermediate `Variant`: the parameters are dispatched to the members through the
+/// renamed names of `T` and the values are parsed from the percent-decoded text.
+///
+/// Supported members are
+/// * strings, `bool` (`true` or `false`), numbers and enums, a repeated parameter takes
+/// the last value;
+/// * flags enums, the names of the repeated parameters are combined;
+/// * sequences, indexed by `[i]`, appended to by a repeated parameter or `[]`;
+/// * maps with string keys, indexed by `[key]`;
+/// * `std::optional` of the above;
+/// * Boost.Hana.Structs, decoded with `Policy`.
+///
+/// Missing members are filled and `Policy::tag` is checked as `fromVariantImpl` does, the
+/// elements skipped by an index are value-initialized. `parser`'s limits apply.
+///
+/// \code
+/// struct Query {
+///     BOOST_HANA_DEFINE_STRUCT(Query, (int, page), (std::vector<std::string>, tag));
+/// };
+/// auto const q = fromQueryString<Query>("page=2&tag=a&tag=b");
+/// \endcode
+///
+/// \throw QueryStringError
+template <class T, class Policy = trait::VarPolicy>
+T fromQueryString(QueryStringParser& parser, std::string_view str) {
+    T ret;
+    detail::QueryDecoder decoder(parser.limits(), detail::queryTarget<T, Policy>(ret));
+    parser.scan(str, decoder);
+    decoder.finish();
+    return ret;
+}
+
+/// Decode a query string into `T` with the limits of `query_string`
+/// \ingroup group-http
+/// \throw QueryStringError
+template <class T, class Policy = trait::VarPolicy>
+T fromQueryString(std::string_view str) {
+    return fromQueryString<T, Policy>(detail::threadQueryStringParser(), str);
+}
+
+} // namespace yenxo
@@ -0,0 +1,379 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <yenxo/variant.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+namespace yenxo {
+
+/// Immutable compact copy of a `Variant`
+/// \ingroup group-datatypes
+///
+/// The whole tree lives in a single allocation: a pre-order tape of fixed-size tagged
+/// entries followed by a pool with the string data. Map keys are kept sorted, so a lookup
+/// is a binary search over adjacent entries.
+///
+/// `Node`s and ranges obtained from the object are invalidated when it is destroyed or
+/// moved from.
+class FrozenVariant {
+public:
+    class Node;
+    class Vec;
+    class Map;
+
+    /// Freeze null, shares a static tape
+    FrozenVariant() noexcept;
+
+    /// Freeze `var`
+    /// \throw std::length_error if `var` does not fit 32-bit offsets
+    explicit FrozenVariant(Variant const& var);
+
+    ~FrozenVariant() noexcept;
+
+    // copy
+    FrozenVariant(FrozenVariant const& rhs);
+    FrozenVariant& operator=(FrozenVariant const& rhs);
+
+    // move, leaves `rhs` a frozen null
+    FrozenVariant(FrozenVariant&& rhs) noexcept;
+    FrozenVariant& operator=(FrozenVariant&& rhs) noexcept;
+
+    /// Get the root node
+    Node root() const noexcept;
+
+    /// Restore a mutable `Variant`
+    Variant thaw() const;
+
+    /// Number of bytes occupied by the tape and the string pool
+    std::size_t byteSize() const noexcept;
+
+    bool operator==(FrozenVariant const& rhs) const;
+    bool operator!=(FrozenVariant const& rhs) const;
+
+private:
+    struct Entry;
+    struct Impl;
+
+    /// Frees the tape unless it is the static null one
+    struct Deleter {
+        void operator()(Entry* tape) const noexcept;
+    };
+
+    std::unique_ptr<Entry[], Deleter> tape_;
+    uint32_t entry_count_;
+    uint32_t pool_size_;
+};
+
+/// Read-only handle to a value in `FrozenVariant`
+/// \ingroup group-datatypes
+///
+/// The accessors follow the ones of `Variant` and throw the same exceptions.
+class FrozenVariant::Node {
+public:
+    using TypeTag = Variant::TypeTag;
+
+    TypeTag type() const noexcept;
+
+    /// Check if the node contains null
+    bool null() const noexcept {
+        return type() == TypeTag::null;
+    }
+
+    /// Test if the value is a scalar
+    bool isScalar() const noexcept {
+        return type() != TypeTag::map && type() != TypeTag::vec;
+    }
+
+    /// \throw VariantEmpty, VariantBadType, VariantIntegralOverflow
+    /// @{
+    bool boolean() const;
+    char character() const;
+    int8_t int8() const;
+    uint8_t uint8() const;
+    int16_t int16() const;
+    uint16_t uint16() const;
+    int32_t int32() const;
+    uint32_t uint32() const;
+    int64_t int64() const;
+    uint64_t uint64() const;
+    double floating() const;
+    /// @}
+
+    /// Get string, the view is valid as long as the owning `FrozenVariant`
+    /// \throw VariantEmpty, VariantBadType
+    std::string_view str() const;
+
+    /// Get array
+    /// \throw VariantEmpty, VariantBadType
+    Vec vec() const;
+
+    /// Get object
+    /// \throw VariantEmpty, VariantBadType
+    Map map() const;
+
+    /// Get raw JSON
+    /// \throw VariantEmpty, VariantBadType
+    RawJson raw() const;
+
+    /// Restore a mutable `Variant` of the subtree
+    Variant thaw() const;
+
+private:
+    friend class FrozenVariant;
+    friend class Vec;
+    friend class Map;
+
+    Node(FrozenVariant const* owner, uint32_t index) noexcept
+            : owner_(owner)
+            , index_(index) {
+    }
+
+    Entry const& entry() const noexcept;
+    Variant scalar() const;
+
+    FrozenVariant const* owner_;
+    uint32_t index_;
+};
+
+/// Array view of `FrozenVariant::Node`
+/// \ingroup group-datatypes
+class FrozenVariant::Vec {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Node;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Node;
+
+        const_iterator() noexcept = default;
+
+        Node operator*() const noexcept {
+            return Vec(node_)[i_];
+        }
+
+        const_iterator& operator++() noexcept {
+            ++i_;
+            return *this;
+        }
+        const_iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++i_;
+            return tmp;
+        }
+        const_iterator& operator--() noexcept {
+            --i_;
+            return *this;
+        }
+        const_iterator operator--(int) noexcept {
+            auto tmp = *this;
+            --i_;
+            return tmp;
+        }
+        const_iterator& operator+=(difference_type n) noexcept {
+            i_ = static_cast<uint32_t>(static_cast<difference_type>(i_) + n);
+            return *this;
+        }
+        const_iterator& operator-=(difference_type n) noexcept {
+            return *this += -n;
+        }
+        const_iterator operator+(difference_type n) const noexcept {
+            auto tmp = *this;
+            return tmp += n;
+        }
+        const_iterator operator-(difference_type n) const noexcept {
+            auto tmp = *this;
+            return tmp -= n;
+        }
+        difference_type operator-(const_iterator const& rhs) const noexcept {
+            return static_cast<difference_type>(i_) - static_cast<difference_type>(rhs.i_);
+        }
+        Node operator[](difference_type n) const noexcept {
+            return *(*this + n);
+        }
+
+        bool operator==(const_iterator const& rhs) const noexcept {
+            return i_ == rhs.i_;
+        }
+        bool operator!=(const_iterator const& rhs) const noexcept {
+            return i_ != rhs.i_;
+        }
+        bool operator<(const_iterator const& rhs) const noexcept {
+            return i_ < rhs.i_;
+        }
+        bool operator>(const_iterator const& rhs) const noexcept {
+            return i_ > rhs.i_;
+        }
+        bool operator<=(const_iterator const& rhs) const noexcept {
+            return i_ <= rhs.i_;
+        }
+        bool operator>=(const_iterator const& rhs) const noexcept {
+            return i_ >= rhs.i_;
+        }
+
+    private:
+        friend class Vec;
+
+        const_iterator(Node node, uint32_t i) noexcept
+                : node_(node)
+                , i_(i) {
+        }
+
+        Node node_{nullptr, 0};
+        uint32_t i_{};
+    };
+
+    using iterator = const_iterator;
+
+    std::size_t size() const noexcept;
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /// Get element `i`, no bounds check
+    Node operator[](std::size_t i) const noexcept;
+
+    /// Get element `i`
+    /// \throw std::out_of_range
+    Node at(std::size_t i) const;
+
+    const_iterator begin() const noexcept {
+        return {node_, 0};
+    }
+
+    const_iterator end() const noexcept {
+        return {node_, static_cast<uint32_t>(size())};
+    }
+
+private:
+    friend class Node;
+
+    explicit Vec(Node node) noexcept
+            : node_(node) {
+    }
+
+    Node node_;
+};
+
+/// Object view of `FrozenVariant::Node`
+/// \ingroup group-datatypes
+///
+/// Iteration yields the members ordered by key.
+class FrozenVariant::Map {
+public:
+    using value_type = std::pair<std::string_view, Node>;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        const_iterator() noexcept = default;
+
+        value_type operator*() const noexcept {
+            return Map(node_).member(i_);
+        }
+
+        const_iterator& operator++() noexcept {
+            ++i_;
+            return *this;
+        }
+        const_iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++i_;
+            return tmp;
+        }
+
+        bool operator==(const_iterator const& rhs) const noexcept {
+            return i_ == rhs.i_;
+        }
+        bool operator!=(const_iterator const& rhs) const noexcept {
+            return i_ != rhs.i_;
+        }
+
+    private:
+        friend class Map;
+
+        const_iterator(Node node, uint32_t i) noexcept
+                : node_(node)
+                , i_(i) {
+        }
+
+        Node node_{nullptr, 0};
+        uint32_t i_{};
+    };
+
+    using iterator = const_iterator;
+
+    std::size_t size() const noexcept;
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /// Find the member `key`
+    std::optional<Node> find(std::string_view key) const noexcept;
+
+    std::size_t count(std::string_view key) const noexcept {
+        return find(key) ? 1 : 0;
+    }
+
+    /// Get the member `key`
+    /// \throw std::out_of_range
+    Node at(std::string_view key) const;
+
+    const_iterator begin() const noexcept {
+        return {node_, 0};
+    }
+
+    const_iterator end() const noexcept {
+        return {node_, static_cast<uint32_t>(size())};
+    }
+
+private:
+    friend class Node;
+
+    explicit Map(Node node) noexcept
+            : node_(node) {
+    }
+
+    value_type member(uint32_t i) const noexcept;
+
+    Node node_;
+};
+
+} // namespace yenxo
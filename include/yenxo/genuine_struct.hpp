@@ -25,6 +25,7 @@
 #pragma once
 
 #include <yenxo/comparison_traits.hpp>
+#include <yenxo/hash.hpp>
 #include <yenxo/ostream_traits.hpp>
 #include <yenxo/variant_traits.hpp>
 
@@ -33,11 +34,12 @@ namespace yenxo {
 /// Genuine struct
 /// \ingroup group-traits-opt-in
 ///
-/// Opts-in `trait::Var`, `trait::EqualityComparison`, `trait::OStream`.
+/// Opts-in `trait::Var`, `trait::EqualityComparison`, `trait::OStream`, `trait::Hash`.
 template <class T, class Policy = trait::VarPolicy>
 struct GenuineStruct
         : yenxo::trait::Var<T, Policy>
         , yenxo::trait::EqualityComparison<T>
-        , yenxo::trait::OStream<T> {};
+        , yenxo::trait::OStream<T>
+        , yenxo::trait::Hash<T> {};
 
 } // namespace yenxo
@@ -0,0 +1,233 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <yenxo/meta.hpp>
+
+#include <boost/hana.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+namespace yenxo {
+
+/// Spread the bits of `x`, the finalizer of SplitMix64
+/// \ingroup group-utility
+constexpr uint64_t hashMix(uint64_t x) noexcept {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+/// Combine the hash `seed` with the hash `x`, the result depends on the order
+/// \ingroup group-utility
+constexpr std::size_t hashCombine(std::size_t seed, std::size_t x) noexcept {
+    return static_cast<std::size_t>(
+            hashMix(seed + 0x9e3779b97f4a7c15ull + (static_cast<uint64_t>(x) << 1)));
+}
+
+/// Hash `size` bytes at `data`
+/// \ingroup group-utility
+inline std::size_t hashBytes(void const* data, std::size_t size) noexcept {
+    return std::hash<std::string_view>{}(
+            std::string_view(static_cast<char const*>(data), size));
+}
+
+#ifndef YENXO_DOXYGEN_INVOKED
+namespace detail {
+
+template <class T, class = void>
+struct HasHashValue : HasHashValue<T, When<true>> {};
+
+template <class T, bool condition>
+struct HasHashValue<T, When<condition>> : std::false_type {};
+
+template <class T>
+struct HasHashValue<T, When<Valid<decltype(hashValue(std::declval<T const&>()))>::value>>
+        : std::true_type {};
+
+template <class T, class = void>
+struct IsContiguous : IsContiguous<T, When<true>> {};
+
+template <class T, bool condition>
+struct IsContiguous<T, When<condition>> : std::false_type {};
+
+template <class T>
+struct IsContiguous<
+        T,
+        When<std::is_same_v<decltype(std::data(std::declval<T const&>())),
+                            typename T::value_type const*>>> : std::true_type {};
+
+template <class T, class = void>
+struct IsUnordered : IsUnordered<T, When<true>> {};
+
+template <class T, bool condition>
+struct IsUnordered<T, When<condition>> : std::false_type {};
+
+template <class T>
+struct IsUnordered<T, When<Valid<typename T::hasher>::value>> : std::true_type {};
+
+} // namespace detail
+#endif
+
+template <class T>
+std::size_t hashStruct(T const& x);
+
+/// Hash `x` consistently with `operator==`
+/// \ingroup group-utility
+///
+/// In the order of preference:
+/// * `hashValue(x)` found by ADL, provided by `Variant`, `trait::Hash` and
+///   `YENXO_HASH_FUNCTION`;
+/// * arithmetic types and enums;
+/// * strings;
+/// * `std::optional`, `std::pair` and containers, element-wise, or as bytes when the
+///   container is contiguous and the elements have unique object representations;
+///   unordered containers ignore the order of the elements;
+/// * Boost.Hana.Struct, see `hashStruct`;
+/// * `std::hash<T>`.
+template <class T>
+std::size_t hashOf(T const& x) {
+    constexpr auto type = boost::hana::type_c<T>;
+    if constexpr (detail::HasHashValue<T>::value) {
+        return static_cast<std::size_t>(hashValue(x));
+    } else if constexpr (std::is_enum_v<T>) {
+        using Underlying = std::underlying_type_t<T>;
+        return static_cast<std::size_t>(
+                hashMix(static_cast<uint64_t>(static_cast<Underlying>(x))));
+    } else if constexpr (std::is_integral_v<T>) {
+        return static_cast<std::size_t>(hashMix(static_cast<uint64_t>(x)));
+    } else if constexpr (std::is_floating_point_v<T>) {
+        // -0.0 == 0.0
+        return std::hash<T>{}(x == 0 ? T(0) : x);
+    } else if constexpr (isString(type) || std::is_convertible_v<T, std::string_view>) {
+        return std::hash<std::string_view>{}(std::string_view(x));
+    } else if constexpr (isOptional(type)) {
+        return x ? hashCombine(1, hashOf(*x)) : 0;
+    } else if constexpr (isPair(type)) {
+        return hashCombine(hashOf(x.first), hashOf(x.second));
+    } else if constexpr (isContainer(type)) {
+        using Value = typename T::value_type;
+        if constexpr (detail::IsContiguous<T>::value
+                      && std::has_unique_object_representations_v<Value>) {
+            return hashCombine(std::size(x),
+                               hashBytes(std::data(x), std::size(x) * sizeof(Value)));
+        } else if constexpr (detail::IsUnordered<T>::value) {
+            std::size_t sum = 0;
+            std::size_t count = 0;
+            for (auto const& e : x) {
+                sum += hashMix(hashOf(e));
+                ++count;
+            }
+            return hashCombine(count, sum);
+        } else {
+            std::size_t ret = 0;
+            for (auto const& e : x) {
+                ret = hashCombine(ret, hashOf(e));
+            }
+            return ret;
+        }
+    } else if constexpr (boost::hana::Struct<T>::value) {
+        return hashStruct(x);
+    } else {
+        static_assert(std::is_default_constructible_v<std::hash<T>>, "T is not hashable");
+        return std::hash<T>{}(x);
+    }
+}
+
+/// Hash the members of `x`
+/// \ingroup group-utility
+/// \pre `T` should be a Boost.Hana.Struct.
+///
+/// A struct with unique object representations, without padding and floating point
+/// members, is hashed as a block of bytes.
+template <class T>
+std::size_t hashStruct(T const& x) {
+    if constexpr (std::has_unique_object_representations_v<T>) {
+        return hashBytes(std::addressof(x), sizeof(T));
+    } else {
+        return boost::hana::fold_left(boost::hana::members(x),
+                                      std::size_t(0),
+                                      [](std::size_t seed, auto const& member) {
+                                          return hashCombine(seed, hashOf(member));
+                                      });
+    }
+}
+
+/// Hash functor for the unordered containers, see `hashOf`
+/// \ingroup group-utility
+///
+/// \code
+/// std::unordered_set<Person, yenxo::Hash> persons;
+/// \endcode
+struct Hash {
+    template <class T>
+    std::size_t operator()(T const& x) const {
+        return hashOf(x);
+    }
+};
+
+namespace trait {
+
+/// Enables `hashValue(Derived)` for `Derived`, see `hashStruct`
+/// \ingroup group-traits-opt-in
+/// \pre `Derived` should be a Boost.Hana.Struct.
+///
+/// Use `yenxo::Hash` or `YENXO_STD_HASH` to key unordered containers with `Derived`.
+template <typename Derived>
+struct Hash {
+    friend std::size_t hashValue(Derived const& x) {
+        return hashStruct(x);
+    }
+
+protected:
+    ~Hash() = default;
+};
+
+} // namespace trait
+} // namespace yenxo
+
+/// Enables `hashValue(T)` for `T`
+/// \ingroup group-traits-opt-in
+/// \pre `T` should be a Boost.Hana.Struct.
+/// \see yenxo::trait::Hash.
+#define YENXO_HASH_FUNCTION(T)                                                           \
+    friend std::size_t hashValue(T const& x) {                                           \
+        return yenxo::hashStruct(x);                                                     \
+    }
+
+/// Specializes `std::hash` for `T` with `yenxo::hashOf`, use at the global scope
+/// \ingroup group-traits-opt-in
+#define YENXO_STD_HASH(T)                                                                \
+    template <>                                                                          \
+    struct std::hash<T> {                                                                \
+        std::size_t operator()(T const& x) const {                                       \
+            return yenxo::hashOf(x);                                                     \
+        }                                                                                \
+    };
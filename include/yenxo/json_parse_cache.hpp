@@ -0,0 +1,87 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <yenxo/variant.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace yenxo {
+
+/// Bounded cache of parsed JSON documents, addressed by their content
+/// \ingroup group-datatypes
+///
+/// Repeated identical inputs are parsed once and share one immutable `Variant`. An
+/// entry is found by the hash of the input bytes and confirmed by comparing them, so
+/// the cache keeps a copy of every cached input. The least recently used entry is
+/// evicted when either the entry count or the total input size would exceed the
+/// capacity; inputs larger than the byte capacity are parsed but not cached.
+///
+/// The cache is safe to use from several threads; parsing happens outside the lock.
+///
+/// \code
+/// JsonParseCache cache({/*entries*/ 64, /*bytes*/ 16 << 20});
+/// std::shared_ptr<Variant const> const config = cache.parse(body);
+/// \endcode
+class JsonParseCache {
+public:
+    struct Capacity {
+        std::size_t entries{128};
+        std::size_t bytes{std::size_t(64) << 20};
+    };
+
+    /// Cache with the default capacity
+    JsonParseCache();
+
+    /// `numbers` is passed to `Variant::fromJson`
+    explicit JsonParseCache(Capacity const& capacity,
+                            Variant::NumberParsing numbers = {});
+
+    ~JsonParseCache() noexcept;
+
+    JsonParseCache(JsonParseCache const&) = delete;
+    JsonParseCache& operator=(JsonParseCache const&) = delete;
+
+    /// Get the document of `json`, parsing it if it is not cached
+    /// \throw std::runtime_error on `json` parse
+    std::shared_ptr<Variant const> parse(std::string_view json);
+
+    /// Number of cached documents
+    std::size_t size() const;
+
+    /// Total size of the cached inputs
+    std::size_t byteSize() const;
+
+    void clear();
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace yenxo
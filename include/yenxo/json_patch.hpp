@@ -0,0 +1,82 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <yenxo/variant.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace yenxo {
+
+/// JSON Patch application error
+/// \ingroup group-exceptions
+class JsonPatchError : public std::runtime_error {
+public:
+    JsonPatchError(std::string const& error, std::size_t operation)
+            : std::runtime_error("operation " + std::to_string(operation) + ": " + error)
+            , operation_(operation) {
+    }
+
+    /// Index of the failed operation in the patch
+    std::size_t operation() const noexcept {
+        return operation_;
+    }
+
+private:
+    std::size_t operation_;
+};
+
+/// Compute the JSON Patch (RFC 6902) turning `from` into `to`
+/// \ingroup group-utility
+///
+/// The patch consists of `add`, `remove` and `replace` operations. Members are compared
+/// by key, arrays by position after skipping their common prefix and suffix, so an
+/// insertion or a removal in the middle of an array is a single operation. Subtrees are
+/// compared with `operator==`, pre-checked by their hashes, which are computed once for
+/// every container node; thus an unchanged subtree is skipped after a hash comparison
+/// and one confirming traversal.
+///
+/// \return VariantVec of the operations
+Variant diff(Variant const& from, Variant const& to);
+
+/// Apply the JSON Patch (RFC 6902) `patch` to `target` in place
+/// \ingroup group-utility
+///
+/// Only the containers on the operation paths are touched, through `Variant::modifyMap`
+/// and `Variant::modifyVec`. The `test` operation compares with `operator==`, so the
+/// type tags have to match as well: `true` does not match `1`, nor `1` match `1.0`. On
+/// failure the operations before the failed one stay applied; apply to a copy when the
+/// target has to stay intact.
+/// \throw JsonPatchError
+/// @{
+void apply(Variant& target, Variant const& patch);
+
+/// The values of `patch` are moved into `target`
+void apply(Variant& target, Variant&& patch);
+/// @}
+
+} // namespace yenxo
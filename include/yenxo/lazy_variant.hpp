@@ -0,0 +1,305 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <yenxo/variant.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace yenxo {
+
+/// JSON document which builds `Variant`s on demand
+/// \ingroup group-datatypes
+///
+/// Parsing validates the input and records an index of its values; nothing is copied.
+/// A string is unescaped, and an object or array is turned into a `Variant`, only when
+/// it is first asked for, and the result is cached. Members are looked up through the
+/// index without touching their siblings.
+///
+/// Accessors of `Node` behave exactly as those of the `Variant` produced by
+/// `Variant::fromJson` for the same input, and so does `toJson`.
+///
+/// The caches are filled by `const` accessors, so a document must not be accessed
+/// concurrently. `Node`s and ranges are invalidated when the document is destroyed or
+/// moved from.
+class LazyVariant {
+public:
+    class Node;
+    class Vec;
+    class Map;
+
+    /// \throw std::runtime_error on `json` parse
+    static LazyVariant fromJson(std::string json);
+
+    ~LazyVariant() noexcept;
+
+    // copy
+    LazyVariant(LazyVariant const& rhs);
+    LazyVariant& operator=(LazyVariant const& rhs);
+
+    // move
+    LazyVariant(LazyVariant&& rhs) noexcept;
+    LazyVariant& operator=(LazyVariant&& rhs) noexcept;
+
+    /// Get the root value
+    Node root() const noexcept;
+
+    /// Get the whole document as `Variant`
+    Variant const& variant() const;
+
+    std::string toJson() const;
+    std::string toPrettyJson() const;
+
+private:
+    struct Entry;
+    struct Impl;
+
+    LazyVariant() noexcept;
+
+    std::string json_;
+    std::vector<Entry> index_;
+    mutable std::unordered_map<uint32_t, Variant> cache_;
+};
+
+/// Value of `LazyVariant`
+/// \ingroup group-datatypes
+class LazyVariant::Node {
+public:
+    using TypeTag = Variant::TypeTag;
+
+    TypeTag type() const noexcept;
+
+    /// Check if the node contains null
+    bool null() const noexcept {
+        return type() == TypeTag::null;
+    }
+
+    /// Test if the value is a scalar
+    bool isScalar() const noexcept {
+        return type() != TypeTag::map && type() != TypeTag::vec;
+    }
+
+    /// \throw VariantEmpty, VariantBadType, VariantIntegralOverflow
+    /// @{
+    bool boolean() const;
+    char character() const;
+    int8_t int8() const;
+    uint8_t uint8() const;
+    int16_t int16() const;
+    uint16_t uint16() const;
+    int32_t int32() const;
+    uint32_t uint32() const;
+    int64_t int64() const;
+    uint64_t uint64() const;
+    double floating() const;
+    /// @}
+
+    /// Get string, unescaped on the first call
+    /// \throw VariantEmpty, VariantBadType
+    std::string const& str() const;
+
+    /// Get array elements
+    /// \throw VariantEmpty, VariantBadType
+    Vec vec() const;
+
+    /// Get object members
+    /// \throw VariantEmpty, VariantBadType
+    Map map() const;
+
+    /// Get the value as `Variant`, built on the first call
+    Variant const& variant() const;
+
+    /// Get the value as JSON text; strings and containers are copied from the source,
+    /// other values are serialized
+    RawJson raw() const;
+
+private:
+    friend class LazyVariant;
+    friend class Vec;
+    friend class Map;
+
+    Node(LazyVariant const* owner, uint32_t index) noexcept
+            : owner_(owner)
+            , index_(index) {
+    }
+
+    Entry const& entry() const noexcept;
+    Variant scalar() const;
+
+    LazyVariant const* owner_;
+    uint32_t index_;
+};
+
+/// Array view of `LazyVariant::Node`
+/// \ingroup group-datatypes
+class LazyVariant::Vec {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Node;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Node;
+
+        const_iterator() noexcept = default;
+
+        Node operator*() const noexcept {
+            return node_;
+        }
+
+        const_iterator& operator++() noexcept;
+        const_iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const_iterator const& rhs) const noexcept {
+            return node_.index_ == rhs.node_.index_;
+        }
+        bool operator!=(const_iterator const& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+    private:
+        friend class Vec;
+
+        explicit const_iterator(Node node) noexcept
+                : node_(node) {
+        }
+
+        Node node_{nullptr, 0};
+    };
+
+    using iterator = const_iterator;
+
+    std::size_t size() const noexcept;
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /// Get element `i`
+    /// \throw std::out_of_range
+    Node at(std::size_t i) const;
+
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+
+private:
+    friend class Node;
+
+    explicit Vec(Node node) noexcept
+            : node_(node) {
+    }
+
+    Node node_;
+};
+
+/// Object view of `LazyVariant::Node`
+/// \ingroup group-datatypes
+///
+/// Iteration yields the members in document order. When a key repeats, the last
+/// occurrence wins as in `Variant::fromJson`.
+class LazyVariant::Map {
+public:
+    using value_type = std::pair<std::string_view, Node>;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        const_iterator() noexcept = default;
+
+        value_type operator*() const;
+
+        const_iterator& operator++() noexcept;
+        const_iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const_iterator const& rhs) const noexcept {
+            return key_.index_ == rhs.key_.index_;
+        }
+        bool operator!=(const_iterator const& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+    private:
+        friend class Map;
+
+        const_iterator(Node key, uint32_t end) noexcept;
+
+        Node key_{nullptr, 0};
+        uint32_t end_{};
+    };
+
+    using iterator = const_iterator;
+
+    std::size_t size() const noexcept;
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /// Find the member `key`
+    std::optional<Node> find(std::string_view key) const;
+
+    std::size_t count(std::string_view key) const {
+        return find(key) ? 1 : 0;
+    }
+
+    /// Get the member `key`
+    /// \throw std::out_of_range
+    Node at(std::string_view key) const;
+
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+
+private:
+    friend class Node;
+
+    explicit Map(Node node) noexcept
+            : node_(node) {
+    }
+
+    Node node_;
+};
+
+} // namespace yenxo
@@ -0,0 +1,74 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <yenxo/variant.hpp>
+
+#include <cstdint>
+
+namespace yenxo {
+
+/// How `merge` combines an array with an array
+/// \ingroup group-utility
+enum class ArrayMerge : uint8_t {
+    /// The source array replaces the target one
+    replace,
+    /// The source elements are appended to the target ones
+    append,
+    /// Elements are merged by index, the extra source elements are appended
+    merge_elements
+};
+
+/// \ingroup group-utility
+struct MergeOptions {
+    ArrayMerge arrays{ArrayMerge::replace};
+
+    /// A null source member removes the target member instead of being stored
+    bool null_removes{false};
+};
+
+/// Deep merge `source` into `target`
+/// \ingroup group-utility
+///
+/// Maps are merged member by member, only the members present in `source` are
+/// touched; arrays are combined according to `options.arrays`; any other source value
+/// replaces the target value. A map merged into a non-map replaces it with an empty
+/// map first. The members of an expiring `source` are moved into `target`, nodes
+/// included, so nothing is copied.
+/// @{
+void merge(Variant& target, Variant&& source, MergeOptions const& options = {});
+void merge(Variant& target, Variant const& source, MergeOptions const& options = {});
+/// @}
+
+/// Apply the JSON Merge Patch (RFC 7396) `patch` to `target` in place
+/// \ingroup group-utility
+///
+/// The same as `merge` with arrays replaced and null members removing.
+/// @{
+void mergePatch(Variant& target, Variant&& patch);
+void mergePatch(Variant& target, Variant const& patch);
+/// @}
+
+} // namespace yenxo
@@ -42,6 +42,7 @@
 
 #include <array>
 #include <optional>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -260,6 +261,12 @@ constexpr auto hasEmplace = boost::hana::is_valid(
         [](auto x) -> decltype((void)boost::hana::traits::declval(x).emplace(
                            std::declval<typename decltype(x)::type::value_type>())) {});
 
+/// Test if `type` is has `reserve` method
+/// \ingroup group-meta
+constexpr auto hasReserve = boost::hana::is_valid(
+        [](auto type) -> decltype((void)boost::hana::traits::declval(type).reserve(
+                              std::size_t())) {});
+
 #if YENXO_ENABLE_TYPE_SAFE
 /// Tests if type is `type_safe::strong_typedef`
 /// \ingroup group-meta
@@ -26,7 +26,12 @@
 
 #include <yenxo/variant_fwd.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <stdexcept>
+#include <string_view>
+#include <vector>
 
 namespace yenxo {
 
@@ -37,11 +42,13 @@ public:
     explicit QueryStringError(std::string const& error,
                               std::string const& input = {},
                               std::string const& expected = {},
-                              std::size_t error_pos = std::string::npos)
+                              std::size_t error_pos = std::string::npos,
+                              std::size_t input_offset = 0)
             : std::runtime_error(error)
             , input(input)
             , expected(expected)
-            , error_pos(error_pos) {
+            , error_pos(error_pos)
+            , input_offset(input_offset) {
     }
 
     /// Test if the error is parse error
@@ -58,10 +65,17 @@ public:
 
     std::string prettyParseError() const;
 
+    /// Offset of the parse error in the whole input, of which the input shown by
+    /// `prettyParseError` may be a part, `std::string::npos` if it is not a parse error
+    std::size_t errorOffset() const noexcept {
+        return isParseError() ? input_offset + error_pos : std::string::npos;
+    }
+
 private:
     std::string input;
     std::string expected;
     std::size_t error_pos;
+    std::size_t input_offset;
 };
 
 /// Parse a query string
@@ -73,6 +87,8 @@ private:
 /// * object_depth_limit=20;
 /// * array_length_limit=20.
 ///
+/// `QueryStringParser` takes other limits.
+///
 /// Examples
 /// --------
 /// Scalar parameter:
@@ -109,4 +125,118 @@ private:
 /// \return VariantMap
 Variant query_string(std::string const& str);
 
+/// Reusable query string parser
+/// \ingroup group-http
+///
+/// Parses the same grammar as `query_string` with a hand-written scanner that decodes
+/// into a buffer kept by the parser. A malformed input is parsed again by the
+/// Boost.Spirit grammar to describe the error the same way. A parser keeps the state of
+/// the current parse, so it is not to be shared by threads; keep one per thread.
+///
+/// \code
+/// thread_local QueryStringParser parser({/*array_length*/ 100});
+/// Variant params;
+/// parser.parse("a=1&b[]=2", params);
+/// \endcode
+class QueryStringParser {
+public:
+    /// Dimension limits of the result
+    struct Limits {
+        std::size_t array_length{20};
+        std::size_t object_depth{20};
+        std::size_t object_property_count{20};
+    };
+
+    /// Decoded parameter, the key keeps its operators, e.g. `a[b][0][]`
+    struct Param {
+        std::string_view key;
+        std::string_view value;
+    };
+
+    /// Receiver of the decoded parameters, see `scan`
+    ///
+    /// A parameter is reported as its name, the index and property operators of its key
+    /// in order, an optional empty index operator and the value.
+    class Handler {
+    public:
+        virtual void paramName(std::string_view name) = 0;
+        virtual void indexOp(uint64_t i) = 0;
+        virtual void propertyOp(std::string_view key) = 0;
+        virtual void emptyIndexOp() = 0;
+
+        /// `key` is the whole decoded key of the parameter
+        virtual void value(std::string_view key, std::string_view value) = 0;
+
+    protected:
+        ~Handler() noexcept = default;
+    };
+
+    /// Parser with the limits of `query_string`
+    QueryStringParser();
+
+    explicit QueryStringParser(Limits const& limits);
+
+    ~QueryStringParser() noexcept;
+
+    QueryStringParser(QueryStringParser&& rhs) noexcept;
+    QueryStringParser& operator=(QueryStringParser&& rhs) noexcept;
+
+    Limits const& limits() const noexcept;
+
+    /// Parse a query string into `out`
+    ///
+    /// The previous content of `out` is replaced, an object reuses its storage. On error
+    /// `out` holds the parameters parsed so far.
+    /// \throw QueryStringError
+    void parse(std::string_view str, Variant& out);
+
+    /// Parse a query string
+    /// \throw QueryStringError
+    /// \return VariantMap
+    Variant parse(std::string_view str);
+
+    /// Decode the parameters of a query string without building an object
+    ///
+    /// The limits do not apply. The result and its views are valid until the next call.
+    /// \throw QueryStringError if `str` is malformed
+    std::vector<Param> const& scan(std::string_view str);
+
+    /// Report the decoded parameters of a query string to `handler`
+    ///
+    /// The limits do not apply. The views passed to `handler` are valid until it
+    /// returns. A malformed `str` is reported once the scanner reaches the error.
+    /// \throw QueryStringError if `str` is malformed, whatever `handler` throws
+    void scan(std::string_view str, Handler& handler);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+namespace detail {
+
+/// The parser of the calling thread, used by `query_string`
+/// \ingroup group-details
+QueryStringParser& threadQueryStringParser();
+
+/// The Boost.Spirit implementation of `QueryStringParser::parse`
+/// \ingroup group-details
+///
+/// Used to describe syntax errors, and as the baseline of the benchmarks.
+class SpiritQueryStringParser {
+public:
+    explicit SpiritQueryStringParser(QueryStringParser::Limits const& limits);
+    ~SpiritQueryStringParser() noexcept;
+
+    /// `offset` is where `str` starts in the whole input, see `errorOffset`
+    /// \throw QueryStringError
+    void parse(std::string_view str, Variant& out, std::size_t offset = 0);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace detail
+
 } // namespace yenxo
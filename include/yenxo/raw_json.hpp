@@ -0,0 +1,90 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace yenxo {
+
+class Variant;
+
+/// JSON text kept verbatim
+/// \ingroup group-datatypes
+///
+/// The text is validated once, on construction, and `Variant::toJson` writes it out
+/// unchanged. Passing an opaque sub-document through therefore costs a copy instead of a
+/// parse and a serialization. Surrounding whitespace is not kept.
+///
+/// The source text is only available where it is still kept: `LazyVariant::Node::raw`
+/// copies it, a `Variant` parsed by `Variant::fromJson` does not keep it, so
+/// `fromVariant` of such a node serializes it again.
+///
+/// Usable as a `Variant` node and, through `toVariant`/`fromVariant`, as a struct member.
+class RawJson {
+public:
+    /// Construct `null`
+    RawJson();
+
+    /// \throw std::runtime_error if `json` is not a single JSON value
+    explicit RawJson(std::string json);
+
+    std::string const& json() const noexcept {
+        return json_;
+    }
+
+    /// Parse the text into `Variant`
+    Variant parse() const;
+
+    static Variant toVariant(RawJson const& x);
+
+    /// Take a raw node as is, serialize any other node, the formatting of the text it was
+    /// parsed from is lost
+    static RawJson fromVariant(Variant const& x);
+
+    bool operator==(RawJson const& rhs) const noexcept {
+        return json_ == rhs.json_;
+    }
+
+    bool operator!=(RawJson const& rhs) const noexcept {
+        return json_ != rhs.json_;
+    }
+
+    static constexpr std::string_view typeName() noexcept {
+        return "raw json";
+    }
+
+private:
+    friend class FrozenVariant;
+    friend class LazyVariant;
+
+    struct Validated {};
+
+    RawJson(std::string json, Validated) noexcept;
+
+    std::string json_;
+};
+
+} // namespace yenxo
@@ -0,0 +1,94 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace yenxo {
+
+class Variant;
+
+namespace detail {
+template <typename Encoding>
+struct FromJson;
+} // namespace detail
+
+/// JSON number kept as its text
+/// \ingroup group-datatypes
+///
+/// Produced by `Variant::fromJson` with `NumberParsing::keep_text`. The text is converted
+/// only when an arithmetic accessor asks for a value, with the same range checks as for
+/// the other arithmetic types, and `Variant::toJson` writes it out unchanged. Therefore
+/// decimals and integers wider than 64 bits pass through without loss.
+///
+/// Usable as a `Variant` node and, through `toVariant`/`fromVariant`, as a struct member.
+class RawNumber {
+public:
+    /// Construct `0`
+    RawNumber();
+
+    /// \throw std::runtime_error if `text` is not a JSON number
+    explicit RawNumber(std::string text);
+
+    std::string const& text() const noexcept {
+        return text_;
+    }
+
+    /// Convert to the smallest fitting of int32, uint32, int64, uint64 or double, as
+    /// `Variant::fromJson` would
+    Variant parse() const noexcept;
+
+    static Variant toVariant(RawNumber const& x);
+
+    /// Take a number node, serializing a converted one
+    /// \throw VariantEmpty, VariantBadType
+    static RawNumber fromVariant(Variant const& x);
+
+    bool operator==(RawNumber const& rhs) const noexcept {
+        return text_ == rhs.text_;
+    }
+
+    bool operator!=(RawNumber const& rhs) const noexcept {
+        return text_ != rhs.text_;
+    }
+
+    static constexpr std::string_view typeName() noexcept {
+        return "number";
+    }
+
+private:
+    template <typename Encoding>
+    friend struct detail::FromJson;
+    friend class FrozenVariant;
+
+    struct Validated {};
+
+    RawNumber(std::string text, Validated) noexcept;
+
+    std::string text_;
+};
+
+} // namespace yenxo
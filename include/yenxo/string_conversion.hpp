@@ -29,11 +29,9 @@
 #include <yenxo/meta.hpp>
 #include <yenxo/type_name.hpp>
 
-#include <boost/hana/for_each.hpp>
-
-#include <cstring>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 namespace yenxo {
@@ -82,12 +80,31 @@ struct ToStringImpl<
 template <typename T>
 struct ToStringImpl<T,
                     When<detail::Valid<decltype(
-                            EnumTraits<T>::toString(std::declval<T>()))>::value>> {
+                                 EnumTraits<T>::toString(std::declval<T>()))>::value
+                         && !isFlagsEnum(boost::hana::type_c<T>)>> {
     static char const* apply(T x) {
         return EnumTraits<T>::toString(x);
     }
 };
 
+// Flags enums, the names of the set bits joined with `|`
+template <typename T>
+struct ToStringImpl<T, When<isFlagsEnum(boost::hana::type_c<T>)>> {
+    static std::string apply(T x) {
+        std::string ret;
+        auto const unknown = forEachFlag(x, [&](char const* name) {
+            if (!ret.empty()) {
+                ret += '|';
+            }
+            ret += name;
+        });
+        if (unknown != 0) {
+            throw BadEnumValue(x);
+        }
+        return ret;
+    }
+};
+
 struct ToStringT {
     template <typename T>
     std::string operator()(T&& x) const {
@@ -132,46 +149,39 @@ struct FromStringImpl<
 
 // Types with specialized EnumTraits
 template <class T>
-struct FromStringImpl<
-        T,
-        When<detail::Valid<decltype(EnumTraits<T>::toString(std::declval<T>()))>::value
-             && !hasStrings(boost::hana::type_c<EnumTraits<T>>)>> {
+struct FromStringImpl<T,
+                      When<detail::Valid<decltype(EnumTraits<T>::toString(
+                                   std::declval<T>()))>::value
+                           && !isFlagsEnum(boost::hana::type_c<T>)>> {
     static T apply(std::string const& x) {
-        for (auto e : EnumTraits<T>::values) {
-            if (x == EnumTraits<T>::toString(e)) {
-                return e;
-            }
+        if (auto const e = enumFromString<T>(x)) {
+            return *e;
         }
         throw StringConversionError(x, boost::hana::type_c<T>);
     }
 };
 
-// Types with specialized EnumTraits
+// Flags enums, the names of the set bits joined with `|`
 template <class T>
-struct FromStringImpl<T, When<detail::Valid<decltype(EnumTraits<T>::strings())>::value>> {
-    template <size_t I>
-    static typename EnumTraits<T>::Enum applyImpl(boost::hana::size_t<I>,
-                                                  std::string const& x) {
-        bool found{false};
-        boost::hana::for_each(boost::hana::at_c<I>(EnumTraits<T>::strings()),
-                              [&](auto s) { found |= strcmp(s, x.c_str()) == 0; });
-        if (found) {
-            return EnumTraits<T>::values[I];
-        } else {
-            return applyImpl(boost::hana::size_c<I + 1>, x);
-        }
-
-        return EnumTraits<T>::values[I];
-    }
-
-    static typename EnumTraits<T>::Enum applyImpl(
-            boost::hana::size_t<EnumTraits<T>::count>,
-            std::string const& x) {
-        throw StringConversionError(x, boost::hana::type_c<T>);
-    }
-
+struct FromStringImpl<T, When<isFlagsEnum(boost::hana::type_c<T>)>> {
     static T apply(std::string const& x) {
-        return applyImpl(boost::hana::size_c<0>, x);
+        detail::FlagsMask<T> ret{};
+        if (x.empty()) {
+            return T(ret);
+        }
+        std::string_view const s = x;
+        for (std::size_t begin = 0;;) {
+            auto const end = s.find('|', begin);
+            auto const e = enumFromString<T>(s.substr(begin, end - begin));
+            if (!e) {
+                throw StringConversionError(x, boost::hana::type_c<T>);
+            }
+            ret |= static_cast<detail::FlagsMask<T>>(*e);
+            if (end == std::string_view::npos) {
+                return T(ret);
+            }
+            begin = end + 1;
+        }
     }
 };
 
@@ -0,0 +1,98 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace yenxo {
+
+/// FNV-1a, usable at compile time
+/// \ingroup group-utility
+constexpr uint64_t fnv1a(std::string_view x) noexcept {
+    uint64_t h = 14695981039346656037ull;
+    for (auto const c : x) {
+        h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    return h;
+}
+
+/// String key with the hash computed ahead of the lookup
+/// \ingroup group-utility
+///
+/// \code
+/// constexpr HashedKey key("first");
+/// findKey(var.map(), key);
+/// \endcode
+struct HashedKey {
+    constexpr explicit HashedKey(std::string_view x) noexcept
+            : str(x)
+            , hash(fnv1a(x)) {
+    }
+
+    std::string_view str;
+    uint64_t hash;
+};
+
+/// Transparent hash of the `Variant::Map` keys
+/// \ingroup group-utility
+struct StringHash {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view x) const noexcept {
+        return static_cast<std::size_t>(fnv1a(x));
+    }
+    std::size_t operator()(std::string const& x) const noexcept {
+        return (*this)(std::string_view(x));
+    }
+    std::size_t operator()(char const* x) const noexcept {
+        return (*this)(std::string_view(x));
+    }
+    std::size_t operator()(HashedKey x) const noexcept {
+        return static_cast<std::size_t>(x.hash);
+    }
+};
+
+/// Transparent equality of the `Variant::Map` keys
+/// \ingroup group-utility
+struct StringEqual {
+    using is_transparent = void;
+
+    template <class A, class B>
+    bool operator()(A const& a, B const& b) const noexcept {
+        return view(a) == view(b);
+    }
+
+private:
+    static std::string_view view(std::string_view x) noexcept {
+        return x;
+    }
+    static std::string_view view(HashedKey x) noexcept {
+        return x.str;
+    }
+};
+
+} // namespace yenxo
@@ -0,0 +1,288 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <yenxo/config.hpp>
+#include <yenxo/enum_traits.hpp>
+#include <yenxo/exception.hpp>
+#include <yenxo/meta.hpp>
+#include <yenxo/variant.hpp>
+#include <yenxo/variant_conversion.hpp>
+#include <yenxo/variant_traits.hpp>
+#include <yenxo/when.hpp>
+
+#include <boost/hana.hpp>
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace yenxo {
+namespace detail {
+
+/// Append `x` percent-encoded, only the unreserved characters of RFC 3986 stay as is
+/// \ingroup group-details
+void appendQueryEncoded(std::string& out, std::string_view x);
+
+/// Appends the parameters of a query string to a buffer
+/// \ingroup group-details
+///
+/// Keeps the percent-encoded key of the current value; `member` and `index` extend it
+/// and return the size to `restore` it to.
+class QueryEncoder {
+public:
+    /// Start over, the buffers keep their storage
+    void reset() noexcept {
+        out_.clear();
+        key_.clear();
+    }
+
+    std::string const& str() const noexcept {
+        return out_;
+    }
+
+    /// A nested member starting with a digit gets it percent-encoded, unlike an index
+    /// \throw QueryStringError if `x` is empty or has a bracket
+    std::size_t member(std::string_view x);
+    std::size_t index(uint64_t i);
+
+    void restore(std::size_t size) noexcept {
+        key_.resize(size);
+    }
+
+    /// Emit `x` under the current key, followed by `[]` if `append`
+    void param(std::string_view x, bool append);
+
+    /// Emit `x` under the current key
+    void variant(Variant const& x);
+
+    /// Emit the members of the map `x`
+    /// \throw VariantBadType
+    /// \throw QueryStringError if a key is empty or has a bracket
+    void root(Variant const& x);
+
+private:
+    std::string out_;
+    std::string key_;
+};
+
+template <class T, class = void>
+struct IsQueryMap : IsQueryMap<T, When<true>> {};
+
+template <class T, bool condition>
+struct IsQueryMap<T, When<condition>> : std::false_type {};
+
+/// Containers of pairs with `char` string keys
+template <class T>
+struct IsQueryMap<
+        T,
+        When<isContainer(boost::hana::type_c<T>)
+             && isKeyValue(boost::hana::type_c<typename T::value_type>)
+             && std::is_convertible_v<typename T::value_type::first_type const&,
+                                      std::string_view>>> : std::true_type {};
+
+/// Types written as a single parameter
+template <class T>
+constexpr bool isQueryScalar() noexcept {
+    auto const type = boost::hana::type_c<T>;
+    return isString(type) || std::is_arithmetic_v<T>
+        || (isReflectiveEnum(type) && !isFlagsEnum(type));
+}
+
+/// Emit the scalar `x` under the current key
+template <class T>
+void writeQueryScalar(QueryEncoder& encoder, T const& x, bool append) {
+    if constexpr (isString(boost::hana::type_c<T>)) {
+        encoder.param(x, append);
+    } else if constexpr (std::is_same_v<T, bool>) {
+        encoder.param(x ? "true" : "false", append);
+    } else if constexpr (std::is_same_v<T, char>) {
+        encoder.param(std::string_view(&x, 1), append);
+    } else if constexpr (std::is_integral_v<T>) {
+        char buf[24];
+        auto const end = std::to_chars(buf, buf + sizeof(buf), x).ptr;
+        encoder.param(std::string_view(buf, static_cast<std::size_t>(end - buf)), append);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        encoder.variant(Variant(static_cast<double>(x)));
+    } else {
+        encoder.param(EnumTraits<T>::toString(x), append);
+    }
+}
+
+/// Emit `x` under the current key
+template <class T, class Policy>
+void writeQuery(QueryEncoder& encoder, T const& x) {
+    auto const type = boost::hana::type_c<T>;
+    if constexpr (isQueryScalar<T>()) {
+        writeQueryScalar(encoder, x, false);
+    } else if constexpr (isFlagsEnum(type)) {
+        bool any = false;
+        auto const unknown = forEachFlag(x, [&](char const* name) {
+            encoder.param(name, true);
+            any = true;
+        });
+        if (unknown != 0) {
+            YENXO_THROW(BadEnumValue(x));
+        }
+        if (!any) {
+            encoder.param({}, false);
+        }
+    } else if constexpr (isOptional(type)) {
+        if (x) {
+            writeQuery<typename T::value_type, Policy>(encoder, *x);
+        }
+    } else if constexpr (IsQueryMap<T>::value) {
+        for (auto const& [key, value] : x) {
+            auto const size = encoder.member(key);
+            writeQuery<std::decay_t<decltype(value)>, Policy>(encoder, value);
+            encoder.restore(size);
+        }
+    } else if constexpr (isContainer(type)) {
+        using Value = std::decay_t<decltype(*begin(x))>;
+        if constexpr (isQueryScalar<Value>()) {
+            for (auto const& value : x) {
+                writeQueryScalar(encoder, value, true);
+            }
+        } else {
+            uint64_t i = 0;
+            for (auto const& value : x) {
+                auto const size = encoder.index(i++);
+                writeQuery<Value, Policy>(encoder, value);
+                encoder.restore(size);
+            }
+        }
+    } else if constexpr (boost::hana::Struct<T>::value) {
+        auto const write_member = [&](auto name, auto accessor) {
+            constexpr auto type = boost::hana::type_c<T>;
+            auto const& value = accessor(x);
+            using Value = std::decay_t<decltype(value)>;
+            if constexpr (Policy::Defaults::has(type)
+                          && !Policy::serialize_default_value
+                          && !isOptional(boost::hana::type_c<Value>)) {
+                if constexpr (Policy::Defaults::hasValue(type, name)) {
+                    if (Policy::Defaults::value(type, name) == value) {
+                        return;
+                    }
+                }
+            }
+            auto const size = encoder.member(Policy::rename(type, name));
+            writeQuery<Value, Policy>(encoder, value);
+            encoder.restore(size);
+        };
+        boost::hana::for_each(boost::hana::accessors<T>(),
+                              boost::hana::fuse(write_member));
+        constexpr auto has_tag =
+                !std::is_same_v<std::remove_const_t<decltype(Policy::tag)>,
+                                typename Policy::NoTag>;
+        if constexpr (has_tag) {
+            auto const size = encoder.member("__tag");
+            encoder.variant(yenxo::toVariant(Policy::tag));
+            encoder.restore(size);
+        }
+    } else {
+        encoder.variant(yenxo::toVariant(x));
+    }
+}
+
+} // namespace detail
+
+/// Reusable query string writer
+/// \ingroup group-http
+///
+/// Produces the conventions `query_string` accepts: a map member is written as
+/// `key[member]`, an array of scalars as repeated `key[]`, other arrays as `key[i]`;
+/// brackets and the characters out of the unreserved set of RFC 3986 are
+/// percent-encoded. Parsing the result gives back what `query_string` produced, the
+/// values being strings. A writer keeps its buffers between the calls; keep one per
+/// thread.
+///
+/// Query strings have no representation for null, empty arrays and empty objects, they
+/// are skipped. A null element of an array is left as a gap in the indexes.
+///
+/// \code
+/// thread_local QueryStringWriter writer;
+/// std::string_view const q = writer.write(params);
+/// \endcode
+class QueryStringWriter {
+public:
+    /// Write the members of the map `x`, the view is valid until the next call
+    /// \throw VariantBadType if `x` is not a map
+    /// \throw QueryStringError if a key is empty or has a bracket
+    std::string_view write(Variant const& x) {
+        encoder_.reset();
+        encoder_.root(x);
+        return encoder_.str();
+    }
+
+    /// Write the members of `x`, the view is valid until the next call
+    ///
+    /// Strings, numbers, enums, flags enums, sequences, maps with string keys,
+    /// `std::optional` and Boost.Hana.Structs, whose members are renamed and defaulted
+    /// according to `Policy`, are written directly; other types through `toVariant`.
+    /// \throw QueryStringError if a key is empty or has a bracket
+    template <class T, class Policy = trait::VarPolicy>
+    std::string_view write(T const& x) {
+        encoder_.reset();
+        if constexpr (std::is_same_v<T, Variant>) {
+            encoder_.root(x);
+        } else if constexpr (boost::hana::Struct<T>::value
+                             || detail::IsQueryMap<T>::value) {
+            detail::writeQuery<T, Policy>(encoder_, x);
+        } else {
+            encoder_.root(yenxo::toVariant(x));
+        }
+        return encoder_.str();
+    }
+
+private:
+    detail::QueryEncoder encoder_;
+};
+
+namespace detail {
+
+/// The writer of the calling thread, used by `toQueryString`
+/// \ingroup group-details
+QueryStringWriter& threadQueryStringWriter();
+
+} // namespace detail
+
+/// Write a query string from the members of the map `x`, see `QueryStringWriter`
+/// \ingroup group-http
+/// \throw VariantBadType if `x` is not a map
+/// \throw QueryStringError if a key is empty or has a bracket
+std::string toQueryString(Variant const& x);
+
+/// Write a query string from the members of `x`, see `QueryStringWriter`
+/// \ingroup group-http
+/// \throw QueryStringError if a key is empty or has a bracket
+template <class T, class Policy = trait::VarPolicy>
+std::string toQueryString(T const& x) {
+    return std::string(detail::threadQueryStringWriter().write<T, Policy>(x));
+}
+
+} // namespace yenxo
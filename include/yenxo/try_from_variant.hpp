@@ -0,0 +1,777 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <yenxo/config.hpp>
+#include <yenxo/enum_traits.hpp>
+#include <yenxo/exception.hpp>
+#include <yenxo/meta.hpp>
+#include <yenxo/type_name.hpp>
+#include <yenxo/variant.hpp>
+#include <yenxo/variant_conversion.hpp>
+#include <yenxo/when.hpp>
+
+#include <boost/hana.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace yenxo {
+
+/// Reason of a failed non-throwing conversion
+/// \ingroup group-datatypes
+///
+/// The codes follow the exceptions of the throwing conversion.
+enum class VariantErrc : uint8_t {
+    empty = 1,         ///< null instead of a value, `VariantEmpty`
+    bad_type,          ///< a value of another type, `VariantBadType`
+    integral_overflow, ///< `VariantIntegralOverflow`
+    bad_value,         ///< a value not representable in the type, `VariantBadType`
+    bad_size,          ///< a list of a wrong size
+    missing_member,    ///< a required member is absent
+    unknown_member,    ///< a member not allowed by the policy
+    other              ///< an exception of a throwing converter
+};
+
+/// Error of the non-throwing conversion
+/// \ingroup group-datatypes
+///
+/// Holds the parts of the message and the path to the failed value; both strings are
+/// built only when asked for. The path is a JSON pointer.
+class FromVariantError {
+public:
+    template <class T>
+    static FromVariantError empty(boost::hana::basic_type<T>) {
+        FromVariantError ret(VariantErrc::empty);
+        ret.expected_ = &detail::typeNameOf<T>;
+        return ret;
+    }
+
+    template <class E, class A>
+    static FromVariantError badType(boost::hana::basic_type<E>,
+                                    boost::hana::basic_type<A>) {
+        FromVariantError ret(VariantErrc::bad_type);
+        ret.expected_ = &detail::typeNameOf<E>;
+        ret.actual_ = &detail::typeNameOf<A>;
+        return ret;
+    }
+
+    /// Bad type error with the type held under `actual`
+    template <class E>
+    static FromVariantError badType(boost::hana::basic_type<E>, Variant::TypeTag actual) {
+        FromVariantError ret(VariantErrc::bad_type);
+        ret.expected_ = &detail::typeNameOf<E>;
+        ret.actual_ = typeNameFor(actual);
+        return ret;
+    }
+
+    template <class T>
+    static FromVariantError overflow(boost::hana::basic_type<T>, std::string value) {
+        FromVariantError ret(VariantErrc::integral_overflow);
+        ret.expected_ = &detail::typeNameOf<T>;
+        ret.text_ = std::move(value);
+        return ret;
+    }
+
+    template <class T>
+    static FromVariantError badValue(boost::hana::basic_type<T>, std::string value) {
+        FromVariantError ret(VariantErrc::bad_value);
+        ret.expected_ = &detail::typeNameOf<T>;
+        ret.text_ = std::move(value);
+        return ret;
+    }
+
+    static FromVariantError badSize(char const* kind,
+                                    std::size_t expected,
+                                    std::size_t actual) {
+        FromVariantError ret(VariantErrc::bad_size);
+        ret.text_ = kind;
+        ret.expected_size_ = expected;
+        ret.actual_size_ = actual;
+        return ret;
+    }
+
+    static FromVariantError missingMember(std::string_view name) {
+        FromVariantError ret(VariantErrc::missing_member);
+        ret.text_ = name;
+        return ret;
+    }
+
+    static FromVariantError unknownMember(std::string_view name) {
+        FromVariantError ret(VariantErrc::unknown_member);
+        ret.text_ = name;
+        return ret;
+    }
+
+    /// Error caught from a throwing converter, `path` is the one of `VariantErr`
+    static FromVariantError other(std::string message, std::string path = {}) {
+        FromVariantError ret(VariantErrc::other);
+        ret.text_ = std::move(message);
+        ret.inner_path_ = std::move(path);
+        return ret;
+    }
+
+    VariantErrc code() const noexcept {
+        return code_;
+    }
+
+    /// The message of the corresponding exception
+    std::string message() const;
+
+    /// JSON pointer to the failed value, empty for the root
+    std::string path() const;
+
+    /// Record the enclosing list element
+    void prependIndex(std::size_t i) {
+        frames_.prependIndex(i);
+    }
+
+    /// Record the enclosing map member
+    void prependKey(std::string_view key) {
+        frames_.prependKey(std::string(key));
+    }
+
+private:
+    using TypeNameFn = std::string (*)();
+
+    explicit FromVariantError(VariantErrc code) noexcept
+            : code_(code) {
+    }
+
+    static TypeNameFn typeNameFor(Variant::TypeTag tag) noexcept;
+
+    VariantErrc code_;
+    TypeNameFn expected_{};
+    TypeNameFn actual_{};
+    std::string text_;
+    std::size_t expected_size_{};
+    std::size_t actual_size_{};
+    std::string inner_path_;
+    detail::ErrorPath frames_;
+};
+
+/// Either a value of `T` or `FromVariantError`
+/// \ingroup group-datatypes
+template <class T>
+class FromVariantResult {
+public:
+    using value_type = T;
+
+    FromVariantResult(T const& x)
+            : impl_(std::in_place_index<0>, x) {
+    }
+
+    FromVariantResult(T&& x)
+            : impl_(std::in_place_index<0>, std::move(x)) {
+    }
+
+    FromVariantResult(FromVariantError x)
+            : impl_(std::in_place_index<1>, std::move(x)) {
+    }
+
+    bool hasValue() const noexcept {
+        return impl_.index() == 0;
+    }
+
+    explicit operator bool() const noexcept {
+        return hasValue();
+    }
+
+    /// \pre `hasValue()`
+    /// @{
+    T& value() & noexcept {
+        return *std::get_if<0>(&impl_);
+    }
+    T const& value() const& noexcept {
+        return *std::get_if<0>(&impl_);
+    }
+    T&& value() && noexcept {
+        return std::move(*std::get_if<0>(&impl_));
+    }
+    T& operator*() & noexcept {
+        return value();
+    }
+    T const& operator*() const& noexcept {
+        return value();
+    }
+    T* operator->() noexcept {
+        return &value();
+    }
+    T const* operator->() const noexcept {
+        return &value();
+    }
+    /// @}
+
+    /// \pre `!hasValue()`
+    /// @{
+    FromVariantError const& error() const& noexcept {
+        return *std::get_if<1>(&impl_);
+    }
+    FromVariantError&& error() && noexcept {
+        return std::move(*std::get_if<1>(&impl_));
+    }
+    /// @}
+
+private:
+    std::variant<T, FromVariantError> impl_;
+};
+
+/// Non-throwing from `Variant` conversion function object
+/// \ingroup group-function
+///
+/// Returns `FromVariantResult<T>`; on the failure path no exception is thrown and the
+/// message and the path of the error are built only on request, which makes it the
+/// choice for untrusted input and for builds without exceptions.
+///
+/// Types without a non-throwing specialization are converted by `fromVariant` and its
+/// exceptions are reported as `VariantErrc::other`. Without exceptions such a type does
+/// not compile, it needs `static FromVariantResult<T> T::tryFromVariant(Variant const&)`.
+#ifdef YENXO_DOXYGEN_INVOKED
+template <class T>
+constexpr auto tryFromVariant = [](Variant const& var) { return FromVariantResult<T>(); };
+#else
+template <typename T>
+struct TryFromVariantT {
+    FromVariantResult<T> operator()(Variant const& x) const;
+};
+
+template <typename T>
+constexpr TryFromVariantT<T> tryFromVariant;
+
+template <typename T, typename = void>
+struct TryFromVariantImpl : TryFromVariantImpl<T, When<true>> {};
+
+// Fallback to the throwing conversion
+template <typename T, bool condition>
+struct TryFromVariantImpl<T, When<condition>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+#if YENXO_EXCEPTIONS
+        try {
+            return FromVariantImpl<T>::apply(x);
+        } catch (VariantErr const& e) {
+            return FromVariantError::other(e.what(), e.path());
+        } catch (std::exception const& e) {
+            return FromVariantError::other(e.what());
+        }
+#else
+        static_assert(!std::is_same_v<T, T>,
+                      "without exceptions T needs "
+                      "`static FromVariantResult<T> T::tryFromVariant(Variant const&)`");
+        return FromVariantImpl<T>::apply(x);
+#endif
+    }
+};
+
+namespace detail {
+
+/// Check that `x` holds `tag`, `T` is the expected type in the error
+/// \ingroup group-details
+template <typename T>
+std::optional<FromVariantError> checkType(Variant const& x, Variant::TypeTag tag) {
+    if (x.type() == tag) {
+        return std::nullopt;
+    }
+    if (x.null()) {
+        return FromVariantError::empty(boost::hana::type_c<T>);
+    }
+    return FromVariantError::badType(boost::hana::type_c<T>, x.type());
+}
+
+/// Convert `x` to the arithmetic `T` into `out`
+/// \ingroup group-details
+template <typename T>
+std::optional<FromVariantError> tryArithmetic(Variant const& x, T& out);
+
+/// Convert `x` to `T`, the error gets `frame` prepended to the path
+/// \ingroup group-details
+template <typename T, typename Frame>
+FromVariantResult<T> tryElement(Variant const& x, Frame const& frame) {
+    auto ret = tryFromVariant<T>(x);
+    if (!ret) {
+        auto err = std::move(ret).error();
+        if constexpr (std::is_integral_v<Frame>) {
+            err.prependIndex(frame);
+        } else {
+            err.prependKey(frame);
+        }
+        return err;
+    }
+    return ret;
+}
+
+} // namespace detail
+
+// Identity
+template <typename T>
+struct TryFromVariantImpl<T, When<std::is_same_v<yenxo::Variant, T>>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        return x;
+    }
+};
+
+// Specialization for types with `static FromVariantResult<T> T::tryFromVariant(Variant)`
+template <typename T>
+struct TryFromVariantImpl<T, When<hasTryFromVariant(boost::hana::type_c<T>)>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        return T::tryFromVariant(x);
+    }
+};
+
+// Specialization for `Variant` built-in supported types
+template <typename T>
+struct TryFromVariantImpl<T, When<isVariantBuildIn(boost::hana::type_c<T>)>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        using TypeTag = Variant::TypeTag;
+        if constexpr (std::is_arithmetic_v<T>) {
+            T ret{};
+            if (auto err = detail::tryArithmetic(x, ret)) {
+                return std::move(*err);
+            }
+            return ret;
+        } else if constexpr (std::is_same_v<T, Variant::NullType>) {
+            if (auto err = detail::checkType<T>(x, TypeTag::null)) {
+                return std::move(*err);
+            }
+            return T{};
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            if (auto err = detail::checkType<T>(x, TypeTag::string)) {
+                return std::move(*err);
+            }
+            return x.str();
+        } else if constexpr (std::is_same_v<T, Variant::Vec>) {
+            if (auto err = detail::checkType<T>(x, TypeTag::vec)) {
+                return std::move(*err);
+            }
+            return x.vec();
+        } else {
+            if (auto err = detail::checkType<T>(x, TypeTag::map)) {
+                return std::move(*err);
+            }
+            return x.map();
+        }
+    }
+};
+
+// Specialization for `std::array`
+template <typename T>
+struct TryFromVariantImpl<T, When<detail::IsStdArrayImpl<T>::value>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        if (auto err = detail::checkType<Variant::Vec>(x, Variant::TypeTag::vec)) {
+            return std::move(*err);
+        }
+        auto const& vec = x.vec();
+        constexpr auto N = detail::StdArraySizeImpl<T>::value;
+        if (vec.size() != N) {
+            return FromVariantError::badSize("list", N, vec.size());
+        }
+        T ret;
+        for (std::size_t i = 0; i < N; ++i) {
+            auto value = detail::tryElement<typename T::value_type>(vec[i], i);
+            if (!value) {
+                return std::move(value).error();
+            }
+            ret[i] = std::move(value).value();
+        }
+        return ret;
+    }
+};
+
+// Specialization for collection types
+template <typename T>
+struct TryFromVariantImpl<T,
+                          When<isCollectionTypeWithPushBack(boost::hana::type_c<T>)
+                               || isCollectionTypeWithEmplace(boost::hana::type_c<T>)>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        if (auto err = detail::checkType<Variant::Vec>(x, Variant::TypeTag::vec)) {
+            return std::move(*err);
+        }
+        auto const& vec = x.vec();
+        T ret;
+        if constexpr (hasReserve(boost::hana::type_c<T>)) {
+            ret.reserve(vec.size());
+        }
+        for (std::size_t i = 0; i < vec.size(); ++i) {
+            auto value = detail::tryElement<typename T::value_type>(vec[i], i);
+            if (!value) {
+                return std::move(value).error();
+            }
+            if constexpr (isCollectionTypeWithPushBack(boost::hana::type_c<T>)) {
+                ret.push_back(std::move(value).value());
+            } else {
+                ret.emplace(std::move(value).value());
+            }
+        }
+        return ret;
+    }
+};
+
+// Specialization for map types
+template <typename T>
+struct TryFromVariantImpl<T, When<isMapType(boost::hana::type_c<T>)>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        using Key = typename T::key_type;
+        if (auto err = detail::checkType<Variant::Map>(x, Variant::TypeTag::map)) {
+            return std::move(*err);
+        }
+        auto const& map = x.map();
+        T ret;
+        if constexpr (hasReserve(boost::hana::type_c<T>)) {
+            ret.reserve(map.size());
+        }
+        for (auto const& [key, element] : map) {
+            auto value = detail::tryElement<typename T::mapped_type>(element, key);
+            if (!value) {
+                return std::move(value).error();
+            }
+            if constexpr (std::is_same_v<Key, std::string>) {
+                ret.emplace(key, std::move(value).value());
+            } else {
+                auto k = detail::tryElement<Key>(Variant(key), key);
+                if (!k) {
+                    return std::move(k).error();
+                }
+                ret.emplace(std::move(k).value(), std::move(value).value());
+            }
+        }
+        return ret;
+    }
+};
+
+// Specialization for pair
+template <typename T>
+struct TryFromVariantImpl<T, When<isPair(boost::hana::type_c<T>)>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        constexpr detail::DecoderKey first_key("first");
+        constexpr detail::DecoderKey second_key("second");
+        if (auto err = detail::checkType<Variant::Map>(x, Variant::TypeTag::map)) {
+            return std::move(*err);
+        }
+        auto const& map = x.map();
+        auto const first_it = findKey(map, first_key);
+        if (first_it == map.end()) {
+            return FromVariantError::missingMember(detail::keyView(first_key));
+        }
+        auto const second_it = findKey(map, second_key);
+        if (second_it == map.end()) {
+            return FromVariantError::missingMember(detail::keyView(second_key));
+        }
+        auto first = detail::tryElement<typename T::first_type>(
+                first_it->second, detail::keyView(first_key));
+        if (!first) {
+            return std::move(first).error();
+        }
+        auto second = detail::tryElement<typename T::second_type>(
+                second_it->second, detail::keyView(second_key));
+        if (!second) {
+            return std::move(second).error();
+        }
+        return T(std::move(first).value(), std::move(second).value());
+    }
+};
+
+// Specialization for types with specialized EnumTraits
+template <class T>
+struct TryFromVariantImpl<T,
+                          When<isReflectiveEnum(boost::hana::type_c<T>)
+                               && !isFlagsEnum(boost::hana::type_c<T>)>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        if (auto err = detail::checkType<std::string>(x, Variant::TypeTag::string)) {
+            return std::move(*err);
+        }
+        if (auto const e = enumFromString<T>(x.str())) {
+            return *e;
+        }
+        return FromVariantError::badValue(boost::hana::type_c<T>, x.str());
+    }
+};
+
+// Specialization for flags enums, the names of the set bits
+template <class T>
+struct TryFromVariantImpl<T, When<isFlagsEnum(boost::hana::type_c<T>)>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        if (auto err = detail::checkType<T>(x, Variant::TypeTag::vec)) {
+            return std::move(*err);
+        }
+        detail::FlagsMask<T> ret{};
+        auto const& vec = x.vec();
+        for (size_t i = 0; i < vec.size(); ++i) {
+            auto err = detail::checkType<std::string>(vec[i], Variant::TypeTag::string);
+            if (!err) {
+                if (auto const e = enumFromString<T>(vec[i].str())) {
+                    ret |= static_cast<detail::FlagsMask<T>>(*e);
+                    continue;
+                }
+                err = FromVariantError::badValue(boost::hana::type_c<T>, vec[i].str());
+            }
+            err->prependIndex(i);
+            return std::move(*err);
+        }
+        return T(ret);
+    }
+};
+
+// `RawJson`, any value is serialized
+template <typename T>
+struct TryFromVariantImpl<T, When<std::is_same_v<T, RawJson>>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        return RawJson::fromVariant(x);
+    }
+};
+
+// `RawNumber`, from a number
+template <typename T>
+struct TryFromVariantImpl<T, When<std::is_same_v<T, RawNumber>>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        using TypeTag = Variant::TypeTag;
+        switch (x.type()) {
+        case TypeTag::null:
+            return FromVariantError::empty(boost::hana::type_c<T>);
+        case TypeTag::boolean:
+        case TypeTag::string:
+        case TypeTag::vec:
+        case TypeTag::map:
+        case TypeTag::raw_json:
+            return FromVariantError::badType(boost::hana::type_c<T>, x.type());
+        default:
+            return RawNumber::fromVariant(x);
+        }
+    }
+};
+
+#if YENXO_ENABLE_TYPE_SAFE
+// Specialization for `type_safe::strong_typedef`
+template <typename T>
+struct TryFromVariantImpl<T,
+                          When<!hasTryFromVariant(boost::hana::type_c<T>)
+                               && strongTypeDef(boost::hana::type_c<T>)>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        auto value = tryFromVariant<type_safe::underlying_type<T>>(x);
+        if (!value) {
+            return std::move(value).error();
+        }
+        return static_cast<T>(std::move(value).value());
+    }
+};
+
+// Specialization for `type_safe::constrained_type`, the constraint is checked by its
+// verifier as in `fromVariant`
+template <typename T>
+struct TryFromVariantImpl<T, When<constrainedType(boost::hana::type_c<T>)>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        auto value = tryFromVariant<typename T::value_type>(x);
+        if (!value) {
+            return std::move(value).error();
+        }
+        return T(std::move(value).value());
+    }
+};
+
+// Specialization for `type_safe::integer`
+template <typename T>
+struct TryFromVariantImpl<T, When<integerType(boost::hana::type_c<T>)>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        auto value = tryFromVariant<typename T::integer_type>(x);
+        if (!value) {
+            return std::move(value).error();
+        }
+        return T(value.value());
+    }
+};
+
+// Specialization for `type_safe::floating_point`
+template <typename T>
+struct TryFromVariantImpl<T, When<floatingPoint(boost::hana::type_c<T>)>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        auto value = tryFromVariant<typename T::floating_point_type>(x);
+        if (!value) {
+            return std::move(value).error();
+        }
+        return T(value.value());
+    }
+};
+
+// Specialization for `type_safe::boolean`
+template <typename T>
+struct TryFromVariantImpl<T, When<boolean(boost::hana::type_c<T>)>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        auto value = tryFromVariant<bool>(x);
+        if (!value) {
+            return std::move(value).error();
+        }
+        return T(value.value());
+    }
+};
+#endif
+
+// `hana::map`
+template <typename T>
+struct TryFromVariantImpl<T, When<boost::hana::is_a<boost::hana::map_tag, T>>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        if (auto err = detail::checkType<Variant::Map>(x, Variant::TypeTag::map)) {
+            return std::move(*err);
+        }
+        auto const& map = x.map();
+        T ret;
+        std::optional<FromVariantError> err;
+        boost::hana::for_each(
+                ret, boost::hana::fuse([&](auto key, auto& value) {
+                    if (err) {
+                        return;
+                    }
+                    constexpr detail::DecoderKey lookup(
+                            boost::hana::to<char const*>(decltype(key)()));
+                    auto const it = findKey(map, lookup);
+                    if (it == map.end()) {
+                        err = FromVariantError::missingMember(detail::keyView(lookup));
+                        return;
+                    }
+                    auto tmp = detail::tryElement<std::decay_t<decltype(value)>>(
+                            it->second, detail::keyView(lookup));
+                    if (!tmp) {
+                        err = std::move(tmp).error();
+                        return;
+                    }
+                    value = std::move(tmp).value();
+                }));
+        if (err) {
+            return std::move(*err);
+        }
+        return ret;
+    }
+};
+
+// `hana::string`
+template <typename T>
+struct TryFromVariantImpl<T, When<boost::hana::is_a<boost::hana::string_tag, T>>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        if (auto err = detail::checkType<T>(x, Variant::TypeTag::string)) {
+            return std::move(*err);
+        }
+        if (x.str() != boost::hana::to<char const*>(T())) {
+            return FromVariantError::badValue(boost::hana::type_c<T>, x.str());
+        }
+        return T();
+    }
+};
+
+// `hana::tuple`
+template <typename T>
+struct TryFromVariantImpl<T, When<boost::hana::is_a<boost::hana::tuple_tag, T>>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        if (auto err = detail::checkType<Variant::Vec>(x, Variant::TypeTag::vec)) {
+            return std::move(*err);
+        }
+        T ret;
+        constexpr auto N = decltype(boost::hana::size(ret))::value;
+        auto const& vec = x.vec();
+        if (vec.size() != N) {
+            return FromVariantError::badSize("tuple", N, vec.size());
+        }
+        std::optional<FromVariantError> err;
+        boost::hana::for_each(
+                boost::hana::make_range(boost::hana::size_c<0>, boost::hana::size_c<N>),
+                [&](auto i) {
+                    constexpr auto I = decltype(i)::value;
+                    if (err) {
+                        return;
+                    }
+                    using Value = std::decay_t<decltype(ret[i])>;
+                    auto tmp = detail::tryElement<Value>(vec[I], I);
+                    if (!tmp) {
+                        err = std::move(tmp).error();
+                        return;
+                    }
+                    ret[i] = std::move(tmp).value();
+                });
+        if (err) {
+            return std::move(*err);
+        }
+        return ret;
+    }
+};
+
+// `hana::Constant`
+template <typename T>
+struct TryFromVariantImpl<T, When<boost::hana::Constant<T>().value>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        auto tmp = tryFromVariant<typename T::value_type>(x);
+        if (!tmp) {
+            return std::move(tmp).error();
+        }
+        if (tmp.value() != T::value) {
+            std::ostringstream os;
+            os << x;
+            return FromVariantError::badValue(
+                    boost::hana::type_c<typename T::value_type>, os.str());
+        }
+        return T();
+    }
+};
+
+// `std::variant`, only the alternatives that may accept the value are tried in order
+template <typename T>
+struct TryFromVariantImpl<
+        T,
+        When<yenxo::detail::Valid<std::variant_alternative_t<0, T>>::value>> {
+    static FromVariantResult<T> apply(Variant const& x) {
+        constexpr auto N = std::variant_size_v<T>;
+        auto const candidates = detail::variantCandidates<T>(x);
+        std::optional<T> ret;
+        boost::hana::for_each(
+                boost::hana::make_range(boost::hana::size_c<0>, boost::hana::size_c<N>),
+                [&](auto i) {
+                    constexpr auto I = decltype(i)::value;
+                    if (ret || !candidates[I]) {
+                        return;
+                    }
+                    auto value = tryFromVariant<std::variant_alternative_t<I, T>>(x);
+                    if (value) {
+                        ret.emplace(std::in_place_index<I>, std::move(value).value());
+                    }
+                });
+        if (!ret) {
+            std::ostringstream os;
+            os << x;
+            return FromVariantError::badValue(boost::hana::type_c<T>, os.str());
+        }
+        return std::move(*ret);
+    }
+};
+
+template <typename T>
+FromVariantResult<T> TryFromVariantT<T>::operator()(Variant const& x) const {
+    return TryFromVariantImpl<std::remove_cv_t<std::remove_reference_t<T>>>::apply(x);
+}
+#endif
+
+} // namespace yenxo
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <yenxo/config.hpp>
 #include <yenxo/enum_traits.hpp>
 #include <yenxo/meta.hpp>
 #include <yenxo/when.hpp>
@@ -83,7 +84,7 @@ template <class T, bool condition>
 struct TypeNameImpl<T, When<condition>> {
     [[noreturn]] static std::string_view apply() {
         static_assert(T::has_no_type_name);
-        throw 0;
+        YENXO_THROW(0);
     }
 };
 
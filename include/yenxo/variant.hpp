@@ -24,18 +24,27 @@
 
 #pragma once
 
+#include <yenxo/config.hpp>
 #include <yenxo/enum_traits.hpp>
 #include <yenxo/meta.hpp>
+#include <yenxo/raw_json.hpp>
+#include <yenxo/raw_number.hpp>
+#include <yenxo/string_hash.hpp>
 
 #include <rapidjson/fwd.h>
 
+#include <functional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
 
 namespace yenxo {
 
+class FrozenVariant;
+
 /// Serialized object representation. Think of it as a DOM object.
 /// \ingroup group-datatypes
 class Variant {
@@ -53,7 +62,7 @@ public:
         }
     };
 
-    using Map = std::unordered_map<std::string, Variant>;
+    using Map = std::unordered_map<std::string, Variant, StringHash, StringEqual>;
     using Vec = std::vector<Variant>;
 
     enum class TypeTag : uint8_t {
@@ -71,7 +80,17 @@ public:
         double_,
         string,
         vec,
-        map
+        map,
+        raw_json,
+        raw_number
+    };
+
+    /// How `fromJson` represents numbers
+    enum class NumberParsing : uint8_t {
+        /// The smallest fitting of int32, uint32, int64, uint64 or double
+        convert,
+        /// `RawNumber`, converted on access
+        keep_text
     };
 
     ~Variant() noexcept;
@@ -101,6 +120,12 @@ public:
     Variant(Map const&);
     Variant(Map&&);
 
+    Variant(RawJson const&);
+    Variant(RawJson&&);
+
+    Variant(RawNumber const&);
+    Variant(RawNumber&&);
+
     template <typename T, typename = decltype(T::toVariant(std::declval<T>()))>
     explicit Variant(T const& x)
             : Variant(T::toVariant(x)) {
@@ -254,6 +279,7 @@ public:
     explicit operator std::string const &() const {
         return str();
     }
+    std::string& modifyStr();
 
     /// Get string or `x` if the object is null
     /// \throw VariantBadType
@@ -283,6 +309,14 @@ public:
     /// \throw VariantBadType, VariantIntegralOverflow
     Map mapOr(Map const& x) const;
 
+    /// Get RawJson
+    /// \throw VariantEmpty, VariantBadType
+    RawJson const& raw() const;
+
+    /// Get RawNumber
+    /// \throw VariantEmpty, VariantBadType
+    RawNumber const& number() const;
+
     /// Check if Variant contains null
     bool null() const noexcept;
 
@@ -291,9 +325,15 @@ public:
 
     /// Check if two `Variant`s are equal
     ///
-    /// Unlike `operator==` this function performs conversion of arithmetic types.
+    /// Unlike `operator==` this function performs conversion of arithmetic types. A
+    /// `RawNumber` not fitting 64-bit integers is compared by its exact decimal value.
     friend bool equal(Variant const& lhs, Variant const& rhs) noexcept;
 
+    /// Structural hash, consistent with `operator==`
+    ///
+    /// The hash of a map does not depend on the iteration order of its members.
+    friend std::size_t hashValue(Variant const& x) noexcept;
+
     /// \ingroup group-json
     /// @{
     static Variant from(rapidjson::Value const& json);
@@ -301,12 +341,29 @@ public:
     /// \throw std::runtime_error on `json` parse
     static Variant fromJson(std::string const& json);
 
+    /// \throw std::runtime_error on `json` parse
+    static Variant fromJson(std::string const& json, NumberParsing numbers);
+
     rapidjson::Document& to(rapidjson::Document& json) const;
 
     std::string toJson() const;
     std::string toPrettyJson() const;
+
+    /// Serialize to the canonical JSON, so that `equal` values serialize identically
+    ///
+    /// Map keys are sorted by their bytes. Numbers are normalized: integral values in
+    /// the range of the 64-bit integers are written as integers, `-0.0` as `0`, the
+    /// other doubles in the shortest round-trip form. Raw JSON and raw numbers are
+    /// parsed and normalized as well. Booleans stay `true` and `false`, so a boolean
+    /// and the number it is `equal` to are the exception.
+    /// \throw std::runtime_error on a raw JSON parse
+    std::string toCanonicalJson() const;
     /// @}
 
+    /// Compact the tree into an immutable `FrozenVariant`
+    /// \throw std::length_error
+    FrozenVariant freeze() const;
+
     friend std::ostream& operator<<(std::ostream& os, Variant const& var);
 
     std::type_info const& typeInfo() const noexcept;
@@ -401,9 +458,88 @@ private:
     } value_;
 };
 
-using VariantMap = std::unordered_map<std::string, Variant>;
+using VariantMap = Variant::Map;
 using VariantVec = std::vector<Variant>;
 
+namespace detail {
+
+/// Key of the member lookups in the decoders
+/// \ingroup group-details
+///
+/// The hash is computed ahead only when the lookup can use it; the C++17 fallback of
+/// `lookupKey` hashes the copied string anyway.
+#if defined(__cpp_lib_generic_unordered_lookup)
+using DecoderKey = HashedKey;
+#else
+using DecoderKey = std::string_view;
+#endif
+
+/// Text of a lookup key
+/// \ingroup group-details
+/// @{
+constexpr std::string_view keyView(std::string_view x) noexcept {
+    return x;
+}
+constexpr std::string_view keyView(HashedKey x) noexcept {
+    return x.str;
+}
+/// @}
+
+/// Key argument for `Variant::Map::find`
+/// \ingroup group-details
+template <class Key>
+decltype(auto) lookupKey(Key const& key) {
+#if defined(__cpp_lib_generic_unordered_lookup)
+    return key;
+#else
+    thread_local std::string buffer;
+    auto const x = keyView(key);
+    buffer.assign(x.data(), x.size());
+    return static_cast<std::string const&>(buffer);
+#endif
+}
+
+} // namespace detail
+
+/// Find `key` in `map` without materializing a `std::string`
+/// \ingroup group-utility
+///
+/// The lookup is heterogeneous when the standard library supports it (C++20), otherwise
+/// the key is copied into a per-thread buffer, which stops allocating once it has grown
+/// to the longest key looked up, and the precomputed hash of a `HashedKey` is not used.
+/// @{
+template <class Key>
+Variant::Map::const_iterator findKey(Variant::Map const& map, Key const& key) {
+    return map.find(detail::lookupKey(key));
+}
+template <class Key>
+Variant::Map::iterator findKey(Variant::Map& map, Key const& key) {
+    return map.find(detail::lookupKey(key));
+}
+/// @}
+
+/// Get the value of `key` in `map` without materializing a `std::string`
+/// \ingroup group-utility
+/// \throw std::out_of_range
+/// @{
+template <class Key>
+Variant const& atKey(Variant::Map const& map, Key const& key) {
+    auto const it = findKey(map, key);
+    if (it == map.end()) {
+        YENXO_THROW(std::out_of_range("Variant::Map::at"));
+    }
+    return it->second;
+}
+template <class Key>
+Variant& atKey(Variant::Map& map, Key const& key) {
+    auto const it = findKey(map, key);
+    if (it == map.end()) {
+        YENXO_THROW(std::out_of_range("Variant::Map::at"));
+    }
+    return it->second;
+}
+/// @}
+
 template <>
 inline bool Variant::asOr<bool>(bool x) const {
     return booleanOr(x);
@@ -448,7 +584,7 @@ inline uint64_t Variant::asOr<uint64_t>(uint64_t x) const {
 template <>
 struct EnumTraits<Variant::TypeTag> {
     using Enum = Variant::TypeTag;
-    static constexpr size_t const count = 15;
+    static constexpr size_t const count = 17;
     static constexpr std::array<Enum, count> const values = {Enum::null,
                                                              Enum::boolean,
                                                              Enum::char_,
@@ -463,7 +599,9 @@ struct EnumTraits<Variant::TypeTag> {
                                                              Enum::double_,
                                                              Enum::string,
                                                              Enum::vec,
-                                                             Enum::map};
+                                                             Enum::map,
+                                                             Enum::raw_json,
+                                                             Enum::raw_number};
     static char const* toString(Enum e) {
         switch (e) {
         case Enum::null:
@@ -496,12 +634,23 @@ struct EnumTraits<Variant::TypeTag> {
             return "vec";
         case Enum::map:
             return "map";
+        case Enum::raw_json:
+            return "raw_json";
+        case Enum::raw_number:
+            return "raw_number";
         }
-        throw std::logic_error(
+        YENXO_THROW(std::logic_error(
                 "'" + std::to_string(static_cast<std::underlying_type_t<Enum>>(e)) +
                 "' is not handled in "
-                "EnumTraits<Variant::TypeTag>::toString(Variant::TypeTag)");
+                "EnumTraits<Variant::TypeTag>::toString(Variant::TypeTag)"));
     }
 };
 
 } // namespace yenxo
+
+template <>
+struct std::hash<yenxo::Variant> {
+    std::size_t operator()(yenxo::Variant const& x) const noexcept {
+        return hashValue(x);
+    }
+};
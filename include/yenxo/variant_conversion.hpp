@@ -29,6 +29,7 @@
 #include <yenxo/exception.hpp>
 #include <yenxo/meta.hpp>
 #include <yenxo/variant.hpp>
+#include <yenxo/variant_view.hpp>
 #include <yenxo/when.hpp>
 
 #if YENXO_ENABLE_TYPE_SAFE
@@ -37,6 +38,7 @@
 
 #include <boost/hana.hpp>
 
+#include <bitset>
 #include <sstream>
 #include <type_traits>
 #include <variant>
@@ -94,8 +96,26 @@ struct HasFromVariantT {
 };
 
 constexpr HasFromVariantT hasFromVariant;
+
+/// \ingroup group-details
+/// Tests if type `T` has `static T T::fromVariant(VariantView)`.
+template <typename T>
+struct HasFromVariantViewImpl {
+    static void var(T const&);
+    template <typename U,
+              typename = decltype(var(U::fromVariant(std::declval<VariantView>())))>
+    static std::true_type test(boost::hana::basic_type<U> const&);
+    static std::false_type test(...);
+    static constexpr auto const value = decltype(test(boost::hana::type_c<T>))();
+};
 #endif
 
+/// \ingroup group-details
+/// Tests if type `T` has `static FromVariantResult<T> T::tryFromVariant(Variant)`.
+inline constexpr auto hasTryFromVariant = boost::hana::is_valid(
+        [](auto t) -> decltype((void)decltype(t)::type::tryFromVariant(
+                           std::declval<Variant const&>())) {});
+
 /// \ingroup group-details
 /// Is `type` a `Variant`.
 inline constexpr auto isVariant = [](auto type) {
@@ -220,7 +240,7 @@ template <typename T, bool condition>
 struct ToVariantImpl<T, When<condition>> {
     [[noreturn]] static Variant apply(T const&) {
         static_assert(T::is_not_convertible_to_variant);
-        throw 0;
+        YENXO_THROW(0);
     }
 };
 
@@ -242,7 +262,7 @@ struct ToVariantImpl<T, When<hasToVariant(boost::hana::type_c<T>)>> {
 // Specialization for `Variant` built-in supported types
 template <typename T>
 struct ToVariantImpl<T, When<isConvertibleToVariantBuildIn(boost::hana::type_c<T>)>> {
-    static Variant apply(T x) {
+    static Variant apply(T const& x) {
         return Variant(x);
     }
 };
@@ -252,11 +272,17 @@ template <typename T>
 struct ToVariantImpl<T, When<isMapType(boost::hana::type_c<T>)>> {
     static Variant apply(T const& map) {
         VariantMap ret;
+        ret.reserve(std::size(map));
         for (auto const& x : map) {
-            ret.emplace(ToVariantImpl<typename T::key_type>::apply(x.first),
-                        ToVariantImpl<typename T::mapped_type>::apply(x.second));
+            if constexpr (std::is_same_v<typename T::key_type, std::string>) {
+                ret.emplace(x.first,
+                            ToVariantImpl<typename T::mapped_type>::apply(x.second));
+            } else {
+                ret.emplace(ToVariantImpl<typename T::key_type>::apply(x.first),
+                            ToVariantImpl<typename T::mapped_type>::apply(x.second));
+            }
         }
-        return Variant(ret);
+        return Variant(std::move(ret));
     }
 };
 
@@ -265,9 +291,10 @@ template <typename T>
 struct ToVariantImpl<T, When<isPair(boost::hana::type_c<T>)>> {
     static Variant apply(T const& pair) {
         VariantMap tmp;
-        tmp["first"] = toVariant(pair.first);
-        tmp["second"] = toVariant(pair.second);
-        return Variant(tmp);
+        tmp.reserve(2);
+        tmp.emplace("first", toVariant(pair.first));
+        tmp.emplace("second", toVariant(pair.second));
+        return Variant(std::move(tmp));
     }
 };
 
@@ -280,18 +307,34 @@ struct ToVariantImpl<T, When<isCollectionType(boost::hana::type_c<T>)>> {
         for (auto const& x : vec) {
             ret.push_back(toVariant(x));
         }
-        return Variant(ret);
+        return Variant(std::move(ret));
     }
 };
 
 // Specialization for types with specialized EnumTraits
 template <class T>
-struct ToVariantImpl<T, When<isReflectiveEnum(boost::hana::type_c<T>)>> {
+struct ToVariantImpl<T,
+                     When<isReflectiveEnum(boost::hana::type_c<T>)
+                          && !isFlagsEnum(boost::hana::type_c<T>)>> {
     static Variant apply(T e) {
         return Variant(EnumTraits<T>::toString(e));
     }
 };
 
+// Specialization for flags enums, the names of the set bits
+template <class T>
+struct ToVariantImpl<T, When<isFlagsEnum(boost::hana::type_c<T>)>> {
+    static Variant apply(T e) {
+        VariantVec ret;
+        auto const unknown =
+                forEachFlag(e, [&](char const* name) { ret.emplace_back(name); });
+        if (unknown != 0) {
+            YENXO_THROW(BadEnumValue(e));
+        }
+        return Variant(std::move(ret));
+    }
+};
+
 #if YENXO_ENABLE_TYPE_SAFE
 // Specialization for `type_safe::strong_typedef`
 template <typename T>
@@ -345,11 +388,12 @@ template <typename T>
 struct ToVariantImpl<T, When<boost::hana::is_a<boost::hana::map_tag, T>>> {
     static Variant apply(T const& map) {
         Variant::Map ret;
-        boost::hana::for_each(map, boost::hana::fuse([&ret](auto key, auto value) {
-                                  ret[boost::hana::to<char const*>(key)] =
-                                          toVariant(value);
+        ret.reserve(boost::hana::length(map));
+        boost::hana::for_each(map, boost::hana::fuse([&ret](auto key, auto const& value) {
+                                  ret.emplace(boost::hana::to<char const*>(key),
+                                              toVariant(value));
                               }));
-        return Variant(ret);
+        return Variant(std::move(ret));
     }
 };
 
@@ -369,7 +413,7 @@ struct ToVariantImpl<T, When<boost::hana::is_a<boost::hana::tuple_tag, T>>> {
         ret.reserve(boost::hana::size(val));
         boost::hana::for_each(val,
                               [&ret](auto const& x) { ret.push_back(toVariant(x)); });
-        return Variant(ret);
+        return Variant(std::move(ret));
     }
 };
 
@@ -392,6 +436,12 @@ auto ToVariantT::operator()(T&& val) const {
 ///
 /// The function object is enabled for any type `T` for which
 /// `toVariantConvertible(boost::hana::type_c<T>)` returns `true`.
+///
+/// `VariantView` is accepted as well. Specializations that take `Variant` only get a copy
+/// of the viewed value.
+///
+/// From an rvalue `Variant` the strings and containers are moved out where the
+/// specialization supports it.
 #ifdef YENXO_DOXYGEN_INVOKED
 template <class T>
 constexpr auto fromVariant = [](Variant const& var) { return T(deserialize(var)); };
@@ -399,6 +449,8 @@ constexpr auto fromVariant = [](Variant const& var) { return T(deserialize(var))
 template <typename T>
 struct FromVariantT {
     auto operator()(Variant const& x) const;
+    auto operator()(Variant&& x) const;
+    auto operator()(VariantView const& x) const;
 };
 
 // Convenient shortcut function
@@ -414,7 +466,7 @@ template <typename T, bool condition>
 struct FromVariantImpl<T, When<condition>> {
     [[noreturn]] static T apply(Variant const&) {
         static_assert(T::is_not_convertible_from_variant);
-        throw 0;
+        YENXO_THROW(0);
     }
 };
 
@@ -424,42 +476,116 @@ struct FromVariantImpl<T, When<std::is_same_v<yenxo::Variant, T>>> {
     static Variant apply(T const& x) {
         return x;
     }
+    static Variant apply(T&& x) {
+        return std::move(x);
+    }
+    static Variant apply(VariantView const& x) {
+        return x.variant();
+    }
 };
 
-// Specialization for types with `static T T::fromVariant(Variant)`
+// Specialization for types with `static T T::fromVariant(Variant)`, a view is passed as
+// is if `T` also has `static T T::fromVariant(VariantView)`
 template <typename T>
 struct FromVariantImpl<T, When<hasFromVariant(boost::hana::type_c<T>)>> {
     static T apply(Variant const& x) {
         return T::fromVariant(x);
     }
+    static T apply(Variant&& x) {
+        return T::fromVariant(std::move(x));
+    }
+    static T apply(VariantView const& x) {
+        if constexpr (HasFromVariantViewImpl<T>::value) {
+            return T::fromVariant(x);
+        } else {
+            return T::fromVariant(x.variant());
+        }
+    }
 };
 
 // Specialization for `Variant` built-in supported types
 template <typename T>
 struct FromVariantImpl<T, When<isVariantBuildIn(boost::hana::type_c<T>)>> {
-    static T apply(Variant const& x) {
+    template <typename V>
+    static T apply(V const& x) {
         return static_cast<T>(x);
     }
+    static T apply(Variant&& x) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            return std::move(x.modifyStr());
+        } else if constexpr (std::is_same_v<T, Variant::Vec>) {
+            return std::move(x.modifyVec());
+        } else if constexpr (std::is_same_v<T, Variant::Map>) {
+            return std::move(x.modifyMap());
+        } else {
+            return static_cast<T>(x);
+        }
+    }
 };
 
 namespace detail {
 
+/// Whether the source `V`, as deduced by a forwarding reference, is an expiring
+/// `Variant` whose elements can be moved from
+/// \ingroup group-details
+template <typename V>
+constexpr bool is_expiring_variant = std::is_same_v<V, Variant>;
+
+/// `x.vec()`, mutable if `x` is expiring
+/// \ingroup group-details
+template <typename V>
+decltype(auto) vecOf(V&& x) {
+    if constexpr (is_expiring_variant<V>) {
+        return x.modifyVec();
+    } else {
+        return x.vec();
+    }
+}
+
+/// `x.map()`, mutable if `x` is expiring
+/// \ingroup group-details
+template <typename V>
+decltype(auto) mapOf(V&& x) {
+    if constexpr (is_expiring_variant<V>) {
+        return x.modifyMap();
+    } else {
+        return x.map();
+    }
+}
+
+/// Element `x` of the source `V`, as an rvalue if `V` is expiring
+/// \ingroup group-details
+template <typename V, typename E>
+decltype(auto) forwardElement(E&& x) {
+    if constexpr (is_expiring_variant<V>) {
+        return std::move(x);
+    } else {
+        return std::forward<E>(x);
+    }
+}
+
 template <class F>
 inline void tryCatch(F&& f, size_t i) {
+#if YENXO_EXCEPTIONS
     try {
         f();
     } catch (yenxo::VariantErr& e) {
-        e.prependPath(std::to_string(i));
+        e.prependPath(i);
         throw;
     } catch (std::exception const& e) {
         VariantErr err(e.what());
-        err.prependPath(std::to_string(i));
+        err.prependPath(i);
         throw std::move(err);
     }
+#else
+    (void)i;
+    f();
+#endif
 }
 
 template <class F, class S>
 inline void tryCatch(F&& f, S s) {
+#if YENXO_EXCEPTIONS
     try {
         f();
     } catch (yenxo::VariantErr& e) {
@@ -470,23 +596,33 @@ inline void tryCatch(F&& f, S s) {
         err.prependPath(boost::hana::to<char const*>(s));
         throw std::move(err);
     }
+#else
+    (void)s;
+    f();
+#endif
 }
 
 } // namespace detail
 
 template <typename T>
 struct FromVariantImpl<T, When<detail::IsStdArrayImpl<T>::value>> {
-    static T apply(Variant const& var) {
-        auto const& vec = var.vec();
+    template <typename V>
+    static T apply(V&& var) {
+        auto&& vec = detail::vecOf(std::forward<V>(var));
         constexpr auto N = detail::StdArraySizeImpl<T>::value;
         if (vec.size() != N) {
-            throw std::logic_error("expected size of the list is " + std::to_string(N)
-                                   + ", actual " + std::to_string(vec.size()));
+            YENXO_THROW(std::logic_error("expected size of the list is "
+                                         + std::to_string(N) + ", actual "
+                                         + std::to_string(vec.size())));
         }
         T ret;
         for (size_t i = 0; i < N; ++i) {
             detail::tryCatch(
-                    [&] { ret[i] = fromVariant<typename T::value_type>(vec[i]); }, i);
+                    [&] {
+                        ret[i] = fromVariant<typename T::value_type>(
+                                detail::forwardElement<V>(vec[i]));
+                    },
+                    i);
         }
         return ret;
     }
@@ -495,12 +631,21 @@ struct FromVariantImpl<T, When<detail::IsStdArrayImpl<T>::value>> {
 // Specialization for collection types (with push_back)
 template <typename T>
 struct FromVariantImpl<T, When<isCollectionTypeWithPushBack(boost::hana::type_c<T>)>> {
-    static T apply(Variant const& var) {
+    template <typename V>
+    static T apply(V&& var) {
+        auto&& vec = detail::vecOf(std::forward<V>(var));
         T ret;
+        if constexpr (hasReserve(boost::hana::type_c<T>)) {
+            ret.reserve(vec.size());
+        }
         size_t i = 0;
-        for (auto const& x : var.vec()) {
+        for (auto&& x : vec) {
             detail::tryCatch(
-                    [&] { ret.push_back(fromVariant<typename T::value_type>(x)); }, i++);
+                    [&] {
+                        ret.push_back(fromVariant<typename T::value_type>(
+                                detail::forwardElement<V>(x)));
+                    },
+                    i++);
         }
         return ret;
     }
@@ -509,12 +654,21 @@ struct FromVariantImpl<T, When<isCollectionTypeWithPushBack(boost::hana::type_c<
 // Specialization for collection types (with emplace)
 template <typename T>
 struct FromVariantImpl<T, When<isCollectionTypeWithEmplace(boost::hana::type_c<T>)>> {
-    static T apply(Variant const& var) {
+    template <typename V>
+    static T apply(V&& var) {
+        auto&& vec = detail::vecOf(std::forward<V>(var));
         T ret;
+        if constexpr (hasReserve(boost::hana::type_c<T>)) {
+            ret.reserve(vec.size());
+        }
         size_t i = 0;
-        for (auto const& x : var.vec()) {
-            detail::tryCatch([&] { ret.emplace(fromVariant<typename T::value_type>(x)); },
-                             i++);
+        for (auto&& x : vec) {
+            detail::tryCatch(
+                    [&] {
+                        ret.emplace(fromVariant<typename T::value_type>(
+                                detail::forwardElement<V>(x)));
+                    },
+                    i++);
         }
         return ret;
     }
@@ -523,11 +677,23 @@ struct FromVariantImpl<T, When<isCollectionTypeWithEmplace(boost::hana::type_c<T
 // Specialization for map types
 template <typename T>
 struct FromVariantImpl<T, When<isMapType(boost::hana::type_c<T>)>> {
-    static T apply(Variant const& var) {
+    template <typename V>
+    static T apply(V&& var) {
+        using Key = typename T::key_type;
+        auto&& map = detail::mapOf(std::forward<V>(var));
         T ret;
-        for (auto const& x : var.map()) {
-            ret.emplace(FromVariantImpl<typename T::key_type>::apply(Variant(x.first)),
-                        FromVariantImpl<typename T::mapped_type>::apply(x.second));
+        if constexpr (hasReserve(boost::hana::type_c<T>)) {
+            ret.reserve(map.size());
+        }
+        for (auto&& x : map) {
+            auto value = fromVariant<typename T::mapped_type>(
+                    detail::forwardElement<V>(x.second));
+            if constexpr (std::is_same_v<Key, std::string>) {
+                ret.emplace(std::string(x.first), std::move(value));
+            } else {
+                ret.emplace(FromVariantImpl<Key>::apply(Variant(std::string(x.first))),
+                            std::move(value));
+            }
         }
         return ret;
     }
@@ -536,61 +702,54 @@ struct FromVariantImpl<T, When<isMapType(boost::hana::type_c<T>)>> {
 // Specialization for pair
 template <typename T>
 struct FromVariantImpl<T, When<isPair(boost::hana::type_c<T>)>> {
-    static T apply(Variant const& var) {
-        return T(yenxo::fromVariant<typename T::first_type>(var.map().at("first")),
-                 yenxo::fromVariant<typename T::second_type>(var.map().at("second")));
+    template <typename V>
+    static T apply(V&& var) {
+        constexpr detail::DecoderKey first("first");
+        constexpr detail::DecoderKey second("second");
+        auto&& map = detail::mapOf(std::forward<V>(var));
+        return T(yenxo::fromVariant<typename T::first_type>(
+                         detail::forwardElement<V>(atKey(map, first))),
+                 yenxo::fromVariant<typename T::second_type>(
+                         detail::forwardElement<V>(atKey(map, second))));
     }
 };
 
 // Specialization for types with specialized EnumTraits
 template <class T>
-struct FromVariantImpl<
-        T,
-        When<isReflectiveEnumWithSingleStringRepresentation(boost::hana::type_c<T>)>> {
-    static T apply(Variant const& var) {
+struct FromVariantImpl<T,
+                       When<isReflectiveEnum(boost::hana::type_c<T>)
+                            && !isFlagsEnum(boost::hana::type_c<T>)>> {
+    template <typename V>
+    static T apply(V const& var) {
         auto const& s = var.str();
-        for (auto e : EnumTraits<T>::values) {
-            if (EnumTraits<T>::toString(e) == s) {
-                return e;
-            }
+        if (auto const e = enumFromString<T>(s)) {
+            return *e;
         }
-        throw VariantBadType(s, boost::hana::type_c<T>);
+        YENXO_THROW(VariantBadType(std::string(s), boost::hana::type_c<T>));
     }
 };
 
-// Specialization for types with specialized EnumTraits
+// Specialization for flags enums, the names of the set bits
 template <class T>
-struct FromVariantImpl<
-        T,
-        When<isReflectiveEnumWithMultiStringRepresentation(boost::hana::type_c<T>)>> {
-    template <size_t I>
-    static typename EnumTraits<T>::Enum applyImpl(boost::hana::size_t<I>,
-                                                  std::string const& x) {
-        bool found{false};
-        boost::hana::for_each(boost::hana::at_c<I>(EnumTraits<T>::strings()),
-                              [&](auto s) { found |= strcmp(s, x.c_str()) == 0; });
-        if (found) {
-            return EnumTraits<T>::values[I];
-        } else {
-            return applyImpl(boost::hana::size_c<I + 1>, x);
+struct FromVariantImpl<T, When<isFlagsEnum(boost::hana::type_c<T>)>> {
+    template <typename V>
+    static T apply(V const& var) {
+        detail::FlagsMask<T> ret{};
+        size_t i = 0;
+        for (auto const& x : var.vec()) {
+            detail::tryCatch(
+                    [&] {
+                        auto const& s = x.str();
+                        auto const e = enumFromString<T>(s);
+                        if (!e) {
+                            YENXO_THROW(VariantBadType(std::string(s),
+                                                       boost::hana::type_c<T>));
+                        }
+                        ret |= static_cast<detail::FlagsMask<T>>(*e);
+                    },
+                    i++);
         }
-
-        return EnumTraits<T>::values[I];
-    }
-
-    static typename EnumTraits<T>::Enum applyImpl(
-            boost::hana::size_t<EnumTraits<T>::count>,
-            std::string const& x) {
-        throw VariantBadType(x, boost::hana::type_c<T>);
-    }
-
-    static T apply(std::string const& x) {
-        return applyImpl(boost::hana::size_c<0>, x);
-    }
-
-    static T apply(Variant const& var) {
-        auto const& s = var.str();
-        return applyImpl(boost::hana::size_c<0>, s);
+        return T(ret);
     }
 };
 
@@ -600,41 +759,46 @@ template <typename T>
 struct FromVariantImpl<T,
                        When<!hasFromVariant(boost::hana::type_c<T>)
                             && strongTypeDef(boost::hana::type_c<T>)>> {
-    static T apply(Variant const& var) {
+    template <typename V>
+    static T apply(V const& var) {
         using U = type_safe::underlying_type<T>;
-        return static_cast<T>(FromVariantImpl<U>::apply(var));
+        return static_cast<T>(fromVariant<U>(var));
     }
 };
 
 // Specialization for `type_safe::constrained_type`
 template <typename T>
 struct FromVariantImpl<T, When<constrainedType(boost::hana::type_c<T>)>> {
-    static T apply(Variant const& var) {
-        return T(FromVariantImpl<typename T::value_type>::apply(var));
+    template <typename V>
+    static T apply(V const& var) {
+        return T(fromVariant<typename T::value_type>(var));
     }
 };
 
 // Specialization for `type_safe::integer`
 template <typename T>
 struct FromVariantImpl<T, When<integerType(boost::hana::type_c<T>)>> {
-    static T apply(Variant const& var) {
-        return T(FromVariantImpl<typename T::integer_type>::apply(var));
+    template <typename V>
+    static T apply(V const& var) {
+        return T(fromVariant<typename T::integer_type>(var));
     }
 };
 
 // Specialization for `type_safe::floating_point`
 template <typename T>
 struct FromVariantImpl<T, When<floatingPoint(boost::hana::type_c<T>)>> {
-    static T apply(Variant const& var) {
-        return T(FromVariantImpl<typename T::floating_point_type>::apply(var));
+    template <typename V>
+    static T apply(V const& var) {
+        return T(fromVariant<typename T::floating_point_type>(var));
     }
 };
 
 // Specialization for `type_safe::boolean`
 template <typename T>
 struct FromVariantImpl<T, When<boolean(boost::hana::type_c<T>)>> {
-    static T apply(Variant const& var) {
-        return T(FromVariantImpl<bool>::apply(var));
+    template <typename V>
+    static T apply(V const& var) {
+        return T(fromVariant<bool>(var));
     }
 };
 #endif
@@ -642,16 +806,19 @@ struct FromVariantImpl<T, When<boolean(boost::hana::type_c<T>)>> {
 // `hana::map`
 template <typename T>
 struct FromVariantImpl<T, When<boost::hana::is_a<boost::hana::map_tag, T>>> {
-    static T apply(Variant const& var) {
-        auto const map = var.map();
+    template <typename V>
+    static T apply(V const& var) {
+        auto const& map = var.map();
         T ret;
         boost::hana::for_each(
                 ret, boost::hana::fuse([&](auto key, auto& value) {
                     using namespace std::string_literals;
-                    auto const it = map.find(boost::hana::to<char const*>(key));
+                    constexpr detail::DecoderKey lookup(
+                            boost::hana::to<char const*>(decltype(key)()));
+                    auto const it = findKey(map, lookup);
                     if (map.end() == it) {
-                        throw std::logic_error(boost::hana::to<char const*>(key)
-                                               + " is required"s);
+                        YENXO_THROW(std::logic_error(boost::hana::to<char const*>(key)
+                                               + " is required"s));
                     }
                     detail::tryCatch(
                             [&] { value = fromVariant<decltype(value)>(it->second); },
@@ -664,11 +831,12 @@ struct FromVariantImpl<T, When<boost::hana::is_a<boost::hana::map_tag, T>>> {
 // `hana::string`
 template <typename T>
 struct FromVariantImpl<T, When<boost::hana::is_a<boost::hana::string_tag, T>>> {
-    static T apply(Variant const& var) {
+    template <typename V>
+    static T apply(V const& var) {
         if (var.str() != boost::hana::to<char const*>(T())) {
             std::ostringstream oss;
             oss << var;
-            throw VariantBadType(oss.str(), boost::hana::type_c<T>);
+            YENXO_THROW(VariantBadType(oss.str(), boost::hana::type_c<T>));
         }
         return T();
     }
@@ -677,13 +845,15 @@ struct FromVariantImpl<T, When<boost::hana::is_a<boost::hana::string_tag, T>>> {
 // `hana::tuple`
 template <typename T>
 struct FromVariantImpl<T, When<boost::hana::is_a<boost::hana::tuple_tag, T>>> {
-    static T apply(Variant const& var) {
+    template <typename V>
+    static T apply(V const& var) {
         T ret;
         constexpr const auto N = boost::hana::size(ret);
         auto const& vec = var.vec();
         if (vec.size() != boost::hana::size(ret)) {
-            throw std::logic_error("expected size of the tuple is " + std::to_string(N)
-                                   + ", actual " + std::to_string(vec.size()));
+            YENXO_THROW(std::logic_error("expected size of the tuple is "
+                                         + std::to_string(N) + ", actual "
+                                         + std::to_string(vec.size())));
         }
         boost::hana::for_each(
                 boost::hana::make_range(boost::hana::size_c<0>, boost::hana::size_c<N>),
@@ -699,40 +869,182 @@ struct FromVariantImpl<T, When<boost::hana::is_a<boost::hana::tuple_tag, T>>> {
 // `hana::Constant`
 template <typename T>
 struct FromVariantImpl<T, When<boost::hana::Constant<T>().value>> {
-    static T apply(Variant const& var) {
+    template <typename V>
+    static T apply(V const& var) {
         auto const tmp = fromVariant<typename T::value_type>(var);
         if (tmp != T::value) {
             std::ostringstream oss;
             oss << var;
-            throw VariantBadType(oss.str(), boost::hana::type_c<T>);
+            YENXO_THROW(VariantBadType(oss.str(), boost::hana::type_c<T>));
         }
         return T();
     }
 };
 
-// `std::variant`
+namespace detail {
+
+/// \ingroup group-details
+/// Tests if type `T` has `static auto T::variantTag()`, the value of its `__tag`.
+inline constexpr auto hasVariantTag = boost::hana::is_valid(
+        [](auto t) -> decltype((void)decltype(t)::type::variantTag()) {});
+
+/// Set of `Variant::TypeTag` as a bit mask
+/// \ingroup group-details
+constexpr uint32_t kindBit(Variant::TypeTag tag) noexcept {
+    return uint32_t(1) << static_cast<unsigned>(tag);
+}
+
+constexpr uint32_t any_kind = ~uint32_t(0);
+
+constexpr uint32_t number_kinds =
+        kindBit(Variant::TypeTag::boolean) | kindBit(Variant::TypeTag::char_)
+        | kindBit(Variant::TypeTag::int8) | kindBit(Variant::TypeTag::uint8)
+        | kindBit(Variant::TypeTag::int16) | kindBit(Variant::TypeTag::uint16)
+        | kindBit(Variant::TypeTag::int32) | kindBit(Variant::TypeTag::uint32)
+        | kindBit(Variant::TypeTag::int64) | kindBit(Variant::TypeTag::uint64)
+        | kindBit(Variant::TypeTag::double_) | kindBit(Variant::TypeTag::raw_number);
+
+/// The kinds of `Variant` that the conversion to `T` may accept
+/// \ingroup group-details
+///
+/// A superset; types with a custom `fromVariant` accept anything, except the
+/// Boost.Hana.Structs with `tryFromVariant` of the struct traits, which accept maps.
+template <typename T>
+constexpr uint32_t acceptedKinds() noexcept {
+    using TypeTag = Variant::TypeTag;
+    constexpr auto type = boost::hana::type_c<T>;
+    if constexpr (std::is_same_v<T, Variant>) {
+        return any_kind;
+    } else if constexpr (hasFromVariant(type)) {
+        return boost::hana::Struct<T>::value && hasTryFromVariant(type)
+                     ? kindBit(TypeTag::map)
+                     : any_kind;
+    } else if constexpr (std::is_same_v<T, Variant::NullType>) {
+        return kindBit(TypeTag::null);
+    } else if constexpr (std::is_arithmetic_v<T> && isVariantBuildIn(type)) {
+        return number_kinds;
+    } else if constexpr (isFlagsEnum(type)) {
+        return kindBit(TypeTag::vec);
+    } else if constexpr (std::is_same_v<T, std::string> || isReflectiveEnum(type)
+                         || boost::hana::is_a<boost::hana::string_tag, T>) {
+        return kindBit(TypeTag::string);
+    } else if constexpr (std::is_same_v<T, Variant::Vec> || IsStdArrayImpl<T>::value
+                         || isCollectionType(type)
+                         || boost::hana::is_a<boost::hana::tuple_tag, T>) {
+        return kindBit(TypeTag::vec);
+    } else if constexpr (std::is_same_v<T, Variant::Map> || isMapType(type)
+                         || isPair(type) || boost::hana::is_a<boost::hana::map_tag, T>) {
+        return kindBit(TypeTag::map);
+    } else {
+        return any_kind;
+    }
+}
+
+/// Whether the tag of `T` is `x`
+template <typename T, typename V>
+bool variantTagIs(V const& x) {
+    static Variant const tag = toVariant(T::variantTag());
+    if constexpr (std::is_same_v<V, Variant>) {
+        return equal(tag, x);
+    } else {
+        return equal(tag, x.variant());
+    }
+}
+
+/// The alternatives of the `std::variant` `T` having the tag `tag`
+/// \ingroup group-details
+template <typename T, typename V>
+std::bitset<std::variant_size_v<T>> variantTagMatches(V const& tag) {
+    constexpr auto N = std::variant_size_v<T>;
+    std::bitset<N> ret;
+    boost::hana::for_each(
+            boost::hana::make_range(boost::hana::size_c<0>, boost::hana::size_c<N>),
+            [&](auto i) {
+                using A = std::variant_alternative_t<decltype(i)::value, T>;
+                if constexpr (hasVariantTag(boost::hana::type_c<A>)) {
+                    ret[i] = variantTagIs<A>(tag);
+                }
+            });
+    return ret;
+}
+
+/// The alternatives of the `std::variant` `T` that may accept `var`
+/// \ingroup group-details
+///
+/// If `__tag` of `var` matches the tags of some alternatives, these are the candidates.
+/// Otherwise the alternatives without a tag that accept the kind of `var` are.
+template <typename T, typename V>
+std::bitset<std::variant_size_v<T>> variantCandidates(V const& var) {
+    constexpr auto N = std::variant_size_v<T>;
+    constexpr auto alternatives =
+            boost::hana::make_range(boost::hana::size_c<0>, boost::hana::size_c<N>);
+    constexpr auto tagged = boost::hana::any_of(alternatives, [](auto i) {
+        return hasVariantTag(
+                boost::hana::type_c<std::variant_alternative_t<decltype(i)::value, T>>);
+    });
+
+    if constexpr (tagged) {
+        if (var.type() == Variant::TypeTag::map) {
+            constexpr detail::DecoderKey tag_key("__tag");
+            auto const& map = var.map();
+            auto const it = findKey(map, tag_key);
+            if (it != map.end()) {
+                auto const ret = variantTagMatches<T>(it->second);
+                if (ret.any()) {
+                    return ret;
+                }
+            }
+        }
+    }
+
+    std::bitset<N> ret;
+    auto const kind = kindBit(var.type());
+    boost::hana::for_each(alternatives, [&](auto i) {
+        using A = std::variant_alternative_t<decltype(i)::value, T>;
+        if constexpr (!hasVariantTag(boost::hana::type_c<A>)) {
+            ret[i] = (acceptedKinds<A>() & kind) != 0;
+        }
+    });
+    return ret;
+}
+
+} // namespace detail
+
+// `std::variant`, only the alternatives that may accept the value are tried in order
 template <typename T>
 struct FromVariantImpl<
         T,
         When<yenxo::detail::Valid<std::variant_alternative_t<0, T>>::value>> {
-    template <size_t I>
-    static T applyImpl(boost::hana::size_t<I>, Variant const& var) {
+    using Candidates = std::bitset<std::variant_size_v<T>>;
+
+    template <size_t I, typename V>
+    static T applyImpl(boost::hana::size_t<I>, V const& var, Candidates const& c) {
+        if (!c[I]) {
+            return applyImpl(boost::hana::size_c<I + 1>, var, c);
+        }
+#if YENXO_EXCEPTIONS
         try {
             return fromVariant<std::variant_alternative_t<I, T>>(var);
         } catch (...) {
-            return applyImpl(boost::hana::size_c<I + 1>, var);
+            return applyImpl(boost::hana::size_c<I + 1>, var, c);
         }
+#else
+        return fromVariant<std::variant_alternative_t<I, T>>(var);
+#endif
     }
 
+    template <typename V>
     [[noreturn]] static T applyImpl(boost::hana::size_t<std::variant_size_v<T>>,
-                                    Variant const& var) {
+                                    V const& var,
+                                    Candidates const&) {
         std::ostringstream os;
         os << var;
-        throw VariantBadType(os.str(), boost::hana::type_c<T>);
+        YENXO_THROW(VariantBadType(os.str(), boost::hana::type_c<T>));
     }
 
-    static T apply(Variant const& var) {
-        return applyImpl(boost::hana::size_c<0>, var);
+    template <typename V>
+    static T apply(V const& var) {
+        return applyImpl(boost::hana::size_c<0>, var, detail::variantCandidates<T>(var));
     }
 };
 
@@ -740,6 +1052,35 @@ template <typename T>
 auto FromVariantT<T>::operator()(Variant const& x) const {
     return FromVariantImpl<std::remove_cv_t<std::remove_reference_t<T>>>::apply(x);
 }
+
+template <typename T>
+auto FromVariantT<T>::operator()(Variant&& x) const {
+    return FromVariantImpl<std::remove_cv_t<std::remove_reference_t<T>>>::apply(
+            std::move(x));
+}
+
+namespace detail {
+
+template <typename T, typename = void>
+struct AcceptsVariantView : std::false_type {};
+
+template <typename T>
+struct AcceptsVariantView<
+        T,
+        std::void_t<decltype(FromVariantImpl<T>::apply(std::declval<VariantView>()))>>
+        : std::true_type {};
+
+} // namespace detail
+
+template <typename T>
+auto FromVariantT<T>::operator()(VariantView const& x) const {
+    using U = std::remove_cv_t<std::remove_reference_t<T>>;
+    if constexpr (detail::AcceptsVariantView<U>::value) {
+        return FromVariantImpl<U>::apply(x);
+    } else {
+        return FromVariantImpl<U>::apply(x.variant());
+    }
+}
 #endif
 
 /// To `Variant` conversion function object
@@ -771,6 +1112,16 @@ struct FromVariantT2 {
     void operator()(T& val, Variant const& var) const {
         val = fromVariant<T>(var);
     }
+
+    template <class T>
+    void operator()(T& val, Variant&& var) const {
+        val = fromVariant<T>(std::move(var));
+    }
+
+    template <class T>
+    void operator()(T& val, VariantView const& var) const {
+        val = fromVariant<T>(var);
+    }
 };
 
 constexpr FromVariantT2 fromVariant2;
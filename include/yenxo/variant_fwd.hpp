@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <yenxo/string_hash.hpp>
+
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -31,7 +33,7 @@
 namespace yenxo {
 
 class Variant;
-using VariantMap = std::unordered_map<std::string, Variant>;
+using VariantMap = std::unordered_map<std::string, Variant, StringHash, StringEqual>;
 using VariantVec = std::vector<Variant>;
 
 } // namespace yenxo
@@ -25,12 +25,19 @@
 #pragma once
 
 #include <yenxo/meta.hpp>
+#include <yenxo/try_from_variant.hpp>
 #include <yenxo/variant.hpp>
 #include <yenxo/variant_conversion.hpp>
 
 #include <boost/hana.hpp>
 
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <type_traits>
+#include <utility>
 
 namespace yenxo {
 
@@ -167,18 +174,32 @@ struct Rename {
     }
 };
 
+/// Number of members of the Boost.Hana.Struct `T`
+/// \ingroup group-details
+template <class T>
+constexpr std::size_t field_count =
+        decltype(boost::hana::length(boost::hana::accessors<T>()))::value;
+
 template <typename T, typename F = decltype(toVariant2)>
 void toVariantWrap(Variant& var, T&& val, F const& to_variant = toVariant2) {
     to_variant(var, std::forward<T>(val));
 }
 
-template <typename T, typename S, typename F = decltype(fromVariant2)>
+template <typename T, typename V, typename S, typename F = decltype(fromVariant2)>
 void fromVariantWrap(T& val,
-                     Variant const& var,
+                     V&& var,
                      S const& name,
                      F const& from_variant = fromVariant2) {
+    auto const convert = [&] {
+        if constexpr (std::is_invocable_v<F const&, T&, V&&>) {
+            from_variant(val, std::forward<V>(var));
+        } else {
+            from_variant(val, var.variant());
+        }
+    };
+#if YENXO_EXCEPTIONS
     try {
-        return from_variant(val, var);
+        convert();
     } catch (yenxo::VariantErr& e) {
         e.prependPath(name);
         throw;
@@ -187,6 +208,46 @@ void fromVariantWrap(T& val,
         err.prependPath(name);
         throw std::move(err);
     }
+#else
+    (void)name;
+    convert();
+#endif
+}
+
+/// Non-throwing `fromVariantWrap`, the error gets `name` prepended to the path
+template <class Policy, typename T>
+std::optional<FromVariantError> tryFromVariantWrap(T& val,
+                                                   Variant const& var,
+                                                   std::string_view name) {
+    using F = std::remove_const_t<decltype(Policy::from_variant)>;
+    if constexpr (std::is_same_v<F, FromVariantT2>) {
+        auto ret = tryFromVariant<T>(var);
+        if (!ret) {
+            auto err = std::move(ret).error();
+            err.prependKey(name);
+            return err;
+        }
+        val = std::move(ret).value();
+    } else {
+#if YENXO_EXCEPTIONS
+        // a custom converter reports errors only by throwing
+        std::optional<FromVariantError> err;
+        try {
+            Policy::from_variant(val, var);
+        } catch (VariantErr const& e) {
+            err = FromVariantError::other(e.what(), e.path());
+        } catch (std::exception const& e) {
+            err = FromVariantError::other(e.what());
+        }
+        if (err) {
+            err->prependKey(name);
+        }
+        return err;
+#else
+        Policy::from_variant(val, var);
+#endif
+    }
+    return std::nullopt;
 }
 
 } // namespace detail
@@ -234,12 +295,18 @@ using VarDefPolicy [[deprecated("Use yenxo::trait::VarPolicy.")]] = VarPolicy;
 /// \pre `T` should be a Boost.Hana.Struct.
 template <class T, class Policy = VarPolicy>
 Variant toVariantImpl(T const& x) {
+    constexpr auto has_tag = !std::is_same_v<std::remove_const_t<decltype(Policy::tag)>,
+                                             typename Policy::NoTag>;
     Variant::Map ret;
+    ret.reserve(detail::field_count<T> + (has_tag ? 1 : 0));
 
+    // through the accessors, folding `x` itself would copy every member
     boost::hana::for_each(
-            x, boost::hana::fuse([&](auto name, auto value) {
+            boost::hana::accessors<T>(), boost::hana::fuse([&](auto name, auto accessor) {
+                auto const& value = accessor(x);
+                using Value = std::decay_t<decltype(value)>;
                 auto const renamed = Policy::rename(boost::hana::type_c<T>, name);
-                if constexpr (isOptional(boost::hana::type_c<decltype(value)>)) {
+                if constexpr (isOptional(boost::hana::type_c<Value>)) {
                     if (value.has_value()) {
                         detail::toVariantWrap(ret[renamed], *value, Policy::to_variant);
                     }
@@ -252,7 +319,7 @@ Variant toVariantImpl(T const& x) {
                                     std::is_convertible_v<
                                             decltype(Policy::Defaults::value(
                                                     boost::hana::type_c<T>, name)),
-                                            std::remove_reference_t<decltype(value)>>,
+                                            Value>,
                                     "Default value should be convertible to field "
                                     "type");
                             if (Policy::Defaults::value(boost::hana::type_c<T>, name)
@@ -262,7 +329,7 @@ Variant toVariantImpl(T const& x) {
                         }
                     }
 
-                    if constexpr (isContainer(boost::hana::type_c<decltype(value)>)) {
+                    if constexpr (isContainer(boost::hana::type_c<Value>)) {
                         if constexpr (!Policy::empty_container_not_required) {
                             detail::toVariantWrap(
                                     ret[renamed], value, Policy::to_variant);
@@ -276,109 +343,418 @@ Variant toVariantImpl(T const& x) {
                 }
             }));
 
-    if constexpr (!std::is_same_v<std::remove_const_t<decltype(Policy::tag)>,
-                                  typename Policy::NoTag>) {
+    if constexpr (has_tag) {
         detail::toVariantWrap(ret["__tag"], Policy::tag, Policy::to_variant);
     }
 
-    return Variant(ret);
+    return Variant(std::move(ret));
 }
 
-/// Convert `x` to `T`
-/// \ingroup group-traits-auto-variant
-///
-/// Conversion can be customized via `Policy`.
-///
-/// `T` can provide
-/// * `names()`;
-/// * `defaults()`.
+namespace detail {
+
+/// Hash table from member names to member indexes
+/// \ingroup group-details
 ///
-/// \pre `T` should be a Boost.Hana.Struct.
-template <class T, class Policy = VarPolicy>
-T fromVariantImpl(yenxo::Variant const& x) {
-    using namespace std::literals;
-    T ret;
+/// Open addressing with a load factor of at most one half, so a lookup hashes the key
+/// once and compares it with about one name.
+template <std::size_t N>
+class FieldIndex {
+public:
+    static constexpr std::size_t npos = N;
+
+    explicit FieldIndex(std::array<std::string, N> names) noexcept
+            : names_(std::move(names)) {
+        slots_.fill(npos);
+        for (std::size_t i = 0; i < N; ++i) {
+            auto s = fnv1a(names_[i]) & (capacity - 1);
+            while (slots_[s] != npos) {
+                s = (s + 1) & (capacity - 1);
+            }
+            slots_[s] = i;
+        }
+    }
 
-    using MapT = std::conditional_t<Policy::allow_additional_properties,
-                                    decltype(x.map()),
-                                    std::decay_t<decltype(x.map())>>;
-    MapT map = x.map();
+    /// \return the index of the member named `key` or `npos`
+    std::size_t find(std::string_view key) const noexcept {
+        for (auto s = fnv1a(key) & (capacity - 1);; s = (s + 1) & (capacity - 1)) {
+            auto const i = slots_[s];
+            if (i == npos || names_[i] == key) {
+                return i;
+            }
+        }
+    }
 
-    if constexpr (!std::is_same_v<std::remove_const_t<decltype(Policy::tag)>,
-                                  typename Policy::NoTag>) {
-        std::remove_const_t<decltype(Policy::tag)> tmp;
-        auto const it = map.find("__tag");
-        if (it == map.end()) {
-            throw std::logic_error("'__tag' is required"s);
+private:
+    static constexpr std::size_t capacity = [] {
+        std::size_t x = 1;
+        while (x < 2 * N) {
+            x *= 2;
         }
-        detail::fromVariantWrap(tmp, it->second, "__tag", Policy::from_variant);
-        if constexpr (!Policy::allow_additional_properties) {
-            map.erase(it);
+        return x;
+    }();
+
+    std::array<std::string, N> names_;
+    std::array<std::size_t, capacity> slots_;
+};
+
+/// Index of the renamed members of `T`, built on the first use
+/// \ingroup group-details
+template <class T, class Policy>
+FieldIndex<field_count<T>> const& fieldIndex() {
+    static FieldIndex<field_count<T>> const index = [] {
+        std::array<std::string, field_count<T>> names;
+        std::size_t i = 0;
+        boost::hana::for_each(boost::hana::accessors<T>(),
+                              boost::hana::fuse([&](auto name, auto) {
+                                  names[i++] =
+                                          Policy::rename(boost::hana::type_c<T>, name);
+                              }));
+        return FieldIndex<field_count<T>>(std::move(names));
+    }();
+    return index;
+}
+
+/// Convert `x` into the member `I` of `ret`, `Arg` is a reference to the source value
+template <class T, class Policy, class Arg, std::size_t I>
+void readField(T& ret, Arg x) {
+    auto const accessor = boost::hana::at_c<I>(boost::hana::accessors<T>());
+    auto const renamed =
+            Policy::rename(boost::hana::type_c<T>, boost::hana::first(accessor));
+    auto& tmp = boost::hana::second(accessor)(ret);
+    if constexpr (isOptional(boost::hana::type_c<decltype(tmp)>)) {
+        std::remove_reference_t<decltype(*tmp)> under;
+        fromVariantWrap(under, std::forward<Arg>(x), renamed, Policy::from_variant);
+        tmp = std::move(under);
+    } else {
+        fromVariantWrap(tmp, std::forward<Arg>(x), renamed, Policy::from_variant);
+    }
+}
+
+template <class T, class Policy, class Arg, std::size_t... I>
+constexpr std::array<void (*)(T&, Arg), sizeof...(I)> makeFieldReaders(
+        std::index_sequence<I...>) {
+    return {{&readField<T, Policy, Arg, I>...}};
+}
+
+/// Member readers of `T` by member index
+/// \ingroup group-details
+template <class T, class Policy, class Arg>
+constexpr auto field_readers =
+        makeFieldReaders<T, Policy, Arg>(std::make_index_sequence<field_count<T>>());
+
+/// Non-throwing `readField`
+template <class T, class Policy, std::size_t I>
+std::optional<FromVariantError> tryReadField(T& ret, Variant const& x) {
+    auto const accessor = boost::hana::at_c<I>(boost::hana::accessors<T>());
+    auto const renamed =
+            Policy::rename(boost::hana::type_c<T>, boost::hana::first(accessor));
+    auto& tmp = boost::hana::second(accessor)(ret);
+    if constexpr (isOptional(boost::hana::type_c<decltype(tmp)>)) {
+        std::remove_reference_t<decltype(*tmp)> under;
+        auto err = tryFromVariantWrap<Policy>(under, x, renamed);
+        if (!err) {
+            tmp = std::move(under);
         }
+        return err;
+    } else {
+        return tryFromVariantWrap<Policy>(tmp, x, renamed);
+    }
+}
+
+template <class T, class Policy, std::size_t... I>
+constexpr std::array<std::optional<FromVariantError> (*)(T&, Variant const&),
+                     sizeof...(I)>
+makeTryFieldReaders(std::index_sequence<I...>) {
+    return {{&tryReadField<T, Policy, I>...}};
+}
+
+/// Non-throwing member readers of `T` by member index
+/// \ingroup group-details
+template <class T, class Policy>
+constexpr auto try_field_readers =
+        makeTryFieldReaders<T, Policy>(std::make_index_sequence<field_count<T>>());
+
+/// Mark the members located in the input
+template <class Iterator, std::size_t N>
+std::array<bool, N> present(std::array<Iterator, N> const& found, Iterator const& end) {
+    std::array<bool, N> ret{};
+    for (std::size_t i = 0; i < N; ++i) {
+        ret[i] = found[i] != end;
     }
+    return ret;
+}
 
+/// Set the members of `ret` not marked in `seen` to their defaults
+/// \return the name of the first required member without a default
+template <class T, class Policy>
+std::optional<std::string> fillMissing(T& ret,
+                                       std::array<bool, field_count<T>> const& seen) {
+    std::optional<std::string> missing;
+    std::size_t i = 0;
     boost::hana::for_each(
             boost::hana::accessors<T>(), boost::hana::fuse([&](auto name, auto value) {
+                if (seen[i++] || missing) {
+                    return;
+                }
                 auto const renamed = Policy::rename(boost::hana::type_c<T>, name);
                 auto& tmp = value(ret);
-                auto const it = map.find(renamed);
 
-                if (map.end() == it) {
-                    if constexpr (Policy::Defaults::has(boost::hana::type_c<T>)) {
-                        if constexpr (Policy::Defaults::hasValue(boost::hana::type_c<T>,
-                                                                 name)) {
-                            static_assert(std::is_convertible_v<
-                                                  decltype(Policy::Defaults::value(
-                                                          boost::hana::type_c<T>, name)),
-                                                  std::remove_reference_t<decltype(
-                                                          value(std::declval<T>()))>>,
-                                          "Default value should be convertible to field "
-                                          "type");
-                            tmp = Policy::Defaults::value(boost::hana::type_c<T>, name);
-                            return;
-                        }
-                    }
-
-                    if constexpr (!isOptional(boost::hana::type_c<decltype(tmp)>)
-                                  && ((isContainer(boost::hana::type_c<decltype(tmp)>)
-                                       && !Policy::empty_container_not_required)
-                                      || !isContainer(
-                                              boost::hana::type_c<decltype(tmp)>))) {
-                        throw std::logic_error("'"s + renamed + "' is required"s);
-                    }
-
-                } else {
-                    if constexpr (isOptional(boost::hana::type_c<decltype(tmp)>)) {
-                        std::remove_reference_t<decltype(*tmp)> under;
-                        detail::fromVariantWrap(
-                                under, it->second, renamed, Policy::from_variant);
-                        tmp = std::move(under);
-                    } else {
-                        detail::fromVariantWrap(
-                                tmp, it->second, renamed, Policy::from_variant);
+                if constexpr (Policy::Defaults::has(boost::hana::type_c<T>)) {
+                    if constexpr (Policy::Defaults::hasValue(boost::hana::type_c<T>,
+                                                             name)) {
+                        static_assert(std::is_convertible_v<
+                                              decltype(Policy::Defaults::value(
+                                                      boost::hana::type_c<T>, name)),
+                                              std::remove_reference_t<decltype(
+                                                      value(std::declval<T>()))>>,
+                                      "Default value should be convertible to field "
+                                      "type");
+                        tmp = Policy::Defaults::value(boost::hana::type_c<T>, name);
+                        return;
                     }
+                }
 
-                    if constexpr (!Policy::allow_additional_properties) {
-                        map.erase(it);
-                    }
+                if constexpr (!isOptional(boost::hana::type_c<decltype(tmp)>)
+                              && ((isContainer(boost::hana::type_c<decltype(tmp)>)
+                                   && !Policy::empty_container_not_required)
+                                  || !isContainer(boost::hana::type_c<decltype(tmp)>))) {
+                    missing = renamed;
                 }
             }));
+    return missing;
+}
+
+/// Update the member `I` of `self` from `x`
+template <class T, class Policy, std::size_t I>
+void updateField(T& self, Variant const& x) {
+    auto const accessor = boost::hana::at_c<I>(boost::hana::accessors<T>());
+    auto const renamed =
+            Policy::rename(boost::hana::type_c<T>, boost::hana::first(accessor));
+    auto& tmp = boost::hana::second(accessor)(self);
+    using U = std::remove_reference_t<decltype(tmp)>;
+    if constexpr (hasUpdateVar(boost::hana::type_c<U>)) {
+        tmp.updateVar(x);
+    } else if constexpr (isOptional(boost::hana::type_c<U>)) {
+        // merge patch semantics: null resets the member, a present value is updated
+        using Under = typename U::value_type;
+        if (x.null()) {
+            tmp.reset();
+            return;
+        }
+        if constexpr (hasUpdateVar(boost::hana::type_c<Under>)) {
+            if (tmp) {
+                tmp->updateVar(x);
+                return;
+            }
+        }
+        Under under;
+        fromVariantWrap(under, x, renamed);
+        tmp = std::move(under);
+    } else {
+        fromVariantWrap<decltype(tmp)>(tmp, x, renamed);
+    }
+}
+
+template <class T, class Policy, std::size_t... I>
+constexpr std::array<void (*)(T&, Variant const&), sizeof...(I)> makeFieldUpdaters(
+        std::index_sequence<I...>) {
+    return {{&updateField<T, Policy, I>...}};
+}
+
+/// Member updaters of `T` by member index
+/// \ingroup group-details
+template <class T, class Policy>
+constexpr auto field_updaters =
+        makeFieldUpdaters<T, Policy>(std::make_index_sequence<field_count<T>>());
+
+template <class T, class Policy, class Source>
+T fromVariantImpl(Source&& x) {
+    using namespace std::literals;
+    // the member values are moved out of an expiring `Variant`
+    constexpr auto expiring = std::is_same_v<Source, Variant>;
+    using Value = std::decay_t<decltype(x.map().begin()->second)>;
+    using Arg = std::conditional_t<expiring, Value&&, Value const&>;
+    constexpr auto has_tag = !std::is_same_v<std::remove_const_t<decltype(Policy::tag)>,
+                                             typename Policy::NoTag>;
+    T ret = T();
+
+    auto&& map = [&]() -> decltype(auto) {
+        if constexpr (expiring) {
+            return x.modifyMap();
+        } else {
+            return x.map();
+        }
+    }();
+
+    if constexpr (has_tag) {
+        std::remove_const_t<decltype(Policy::tag)> tmp;
+        constexpr yenxo::detail::DecoderKey tag_key("__tag");
+        auto const it = findKey(map, tag_key);
+        if (it == map.end()) {
+            YENXO_THROW(std::logic_error("'__tag' is required"s));
+        }
+        detail::fromVariantWrap(tmp, it->second, "__tag", Policy::from_variant);
+    }
+
+    // one pass over the input locates the members, the last of repeated keys is taken
+    auto const& index = fieldIndex<T, Policy>();
+    std::array<decltype(map.begin()), field_count<T>> found;
+    found.fill(map.end());
+    std::optional<std::string_view> unknown;
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        auto const i = index.find(it->first);
+        if (i != index.npos) {
+            found[i] = it;
+        } else if constexpr (!Policy::allow_additional_properties) {
+            if (!unknown && !(has_tag && it->first == "__tag")) {
+                unknown = it->first;
+            }
+        }
+    }
+
+    // the members are converted in declaration order, up to the first missing one
+    auto const missing = fillMissing<T, Policy>(ret, present(found, map.end()));
+    auto const last = missing ? index.find(*missing) : field_count<T>;
+    for (std::size_t i = 0; i < last; ++i) {
+        if (found[i] != map.end()) {
+            field_readers<T, Policy, Arg>[i](ret, static_cast<Arg>(found[i]->second));
+        }
+    }
+
+    if (missing) {
+        YENXO_THROW(std::logic_error("'" + *missing + "' is required"));
+    }
 
     if constexpr (!Policy::allow_additional_properties) {
-        if (!map.empty()) {
-            throw std::logic_error("'" + map.begin()->first + "' is unknown");
+        if (unknown) {
+            YENXO_THROW(std::logic_error("'" + std::string(*unknown) + "' is unknown"));
         }
     }
 
     return ret;
 }
 
+template <class T, class Policy>
+FromVariantResult<T> tryFromVariantImpl(Variant const& x) {
+    constexpr auto has_tag = !std::is_same_v<std::remove_const_t<decltype(Policy::tag)>,
+                                             typename Policy::NoTag>;
+    if (auto err = yenxo::detail::checkType<Variant::Map>(x, Variant::TypeTag::map)) {
+        return std::move(*err);
+    }
+    auto const& map = x.map();
+    T ret = T();
+
+    if constexpr (has_tag) {
+        std::remove_const_t<decltype(Policy::tag)> tmp;
+        constexpr yenxo::detail::DecoderKey tag_key("__tag");
+        auto const it = findKey(map, tag_key);
+        if (it == map.end()) {
+            return FromVariantError::missingMember(yenxo::detail::keyView(tag_key));
+        }
+        if (auto err = tryFromVariantWrap<Policy>(tmp, it->second, "__tag")) {
+            return std::move(*err);
+        }
+    }
+
+    auto const& index = fieldIndex<T, Policy>();
+    std::array<Variant::Map::const_iterator, field_count<T>> found;
+    found.fill(map.end());
+    std::optional<std::string_view> unknown;
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        auto const i = index.find(it->first);
+        if (i != index.npos) {
+            found[i] = it;
+        } else if constexpr (!Policy::allow_additional_properties) {
+            if (!unknown && !(has_tag && it->first == "__tag")) {
+                unknown = it->first;
+            }
+        }
+    }
+
+    auto const missing = fillMissing<T, Policy>(ret, present(found, map.end()));
+    auto const last = missing ? index.find(*missing) : field_count<T>;
+    for (std::size_t i = 0; i < last; ++i) {
+        if (found[i] != map.end()) {
+            if (auto err = try_field_readers<T, Policy>[i](ret, found[i]->second)) {
+                return std::move(*err);
+            }
+        }
+    }
+
+    if (missing) {
+        return FromVariantError::missingMember(*missing);
+    }
+
+    if constexpr (!Policy::allow_additional_properties) {
+        if (unknown) {
+            return FromVariantError::unknownMember(*unknown);
+        }
+    }
+
+    return ret;
+}
+
+} // namespace detail
+
+/// Convert `x` to `T`
+/// \ingroup group-traits-auto-variant
+///
+/// Conversion can be customized via `Policy`.
+///
+/// `T` can provide
+/// * `names()`;
+/// * `defaults()`.
+///
+/// \pre `T` should be a Boost.Hana.Struct.
+template <class T, class Policy = VarPolicy>
+T fromVariantImpl(yenxo::Variant const& x) {
+    return detail::fromVariantImpl<T, Policy>(x);
+}
+
+/// Convert `x` to `T`, moving the member values out of `x`
+/// \ingroup group-traits-auto-variant
+///
+/// \pre `T` should be a Boost.Hana.Struct.
+template <class T, class Policy = VarPolicy>
+T fromVariantImpl(yenxo::Variant&& x) {
+    return detail::fromVariantImpl<T, Policy>(std::move(x));
+}
+
+/// Convert `x` to `T`
+/// \ingroup group-traits-auto-variant
+///
+/// The members are read straight from the viewed value; of repeated keys the last one
+/// is taken, as by `Variant::from`.
+///
+/// \pre `T` should be a Boost.Hana.Struct.
+template <class T, class Policy = VarPolicy>
+T fromVariantImpl(VariantView const& x) {
+    return detail::fromVariantImpl<T, Policy>(x);
+}
+
+/// Convert `x` to `T` without throwing
+/// \ingroup group-traits-auto-variant
+///
+/// The counterpart of `fromVariantImpl` built on `tryFromVariant`. Members are
+/// converted with `tryFromVariant` unless `Policy::from_variant` is customized, then
+/// the exceptions of the custom converter are caught.
+///
+/// \pre `T` should be a Boost.Hana.Struct.
+template <class T, class Policy = VarPolicy>
+FromVariantResult<T> tryFromVariantImpl(yenxo::Variant const& x) {
+    return detail::tryFromVariantImpl<T, Policy>(x);
+}
+
 /// Adds conversion support to and from `Variant`
 /// \ingroup group-traits-auto-variant
 ///
 /// Specifically adds members:
 /// * `static Variant toVariant(Derived const&)`
 /// * `static Derived fromVariant(Variant const&)`
+/// * `static Derived fromVariant(Variant&&)`
+/// * `static Derived fromVariant(VariantView const&)`
+/// * `static FromVariantResult<Derived> tryFromVariant(Variant const&)`
+/// * `static auto variantTag()`, if `Policy` has a tag
 ///
 /// Supports
 /// * `names()`;
@@ -395,6 +771,27 @@ struct Var {
         return fromVariantImpl<Derived, Policy>(x);
     }
 
+    static Derived fromVariant(Variant&& x) {
+        return fromVariantImpl<Derived, Policy>(std::move(x));
+    }
+
+    static Derived fromVariant(VariantView const& x) {
+        return fromVariantImpl<Derived, Policy>(x);
+    }
+
+    static FromVariantResult<Derived> tryFromVariant(Variant const& x) {
+        return tryFromVariantImpl<Derived, Policy>(x);
+    }
+
+    /// The value of `__tag`, a `std::variant` with `Derived` is decoded by it
+    template <class P = Policy,
+              class = std::enable_if_t<!std::is_same_v<
+                      std::remove_const_t<decltype(P::tag)>,
+                      typename P::NoTag>>>
+    static constexpr auto variantTag() noexcept {
+        return P::tag;
+    }
+
 protected:
     ~Var() = default;
 };
@@ -407,37 +804,22 @@ using VarDef [[deprecated("Use yenxo::trait::Var.")]] = Var<Derived, Policy>;
 ///
 /// Conversion can be customized via `Policy`.
 ///
+/// As in a JSON Merge Patch, members having `updateVar` are updated rather than replaced,
+/// so are engaged optional ones, and null resets an optional member.
+///
 /// `T` can provide
 /// * names().
 ///
 /// \pre `T` should be a Boost.Hana.Struct.
 template <class T, class Policy = VarPolicy>
 void updateVarImpl(T& self, Variant const& x) {
-    auto const& map = x.map();
-    for (auto const& v : map) {
-        bool found{false};
-        boost::hana::for_each(
-                boost::hana::accessors<T>(),
-                boost::hana::fuse([&](auto name, auto value) {
-                    auto const renamed = Policy::rename(boost::hana::type_c<T>, name);
-                    if (renamed != v.first) {
-                        return;
-                    }
-                    auto& tmp = value(self);
-                    if constexpr (detail::hasUpdateVar(
-                                          boost::hana::type_c<std::remove_reference_t<
-                                                  decltype(tmp)>>)) {
-                        tmp.updateVar(v.second);
-                    } else {
-                        detail::fromVariantWrap<decltype(tmp)>(tmp, v.second, renamed);
-                    }
-                    found = true;
-                }));
-
-        if constexpr (!Policy::allow_additional_properties) {
-            if (!found) {
-                throw std::logic_error("'" + v.first + "'" + " is unknown");
-            }
+    auto const& index = detail::fieldIndex<T, Policy>();
+    for (auto const& v : x.map()) {
+        auto const i = index.find(v.first);
+        if (i != index.npos) {
+            detail::field_updaters<T, Policy>[i](self, v.second);
+        } else if constexpr (!Policy::allow_additional_properties) {
+            YENXO_THROW(std::logic_error("'" + v.first + "'" + " is unknown"));
         }
     }
 }
@@ -537,6 +919,15 @@ protected:
 #define YENXO_FROM_VARIANT(T)                                                            \
     static T fromVariant(yenxo::Variant const& x) {                                      \
         return yenxo::trait::fromVariantImpl<T>(x);                                      \
+    }                                                                                    \
+    static T fromVariant(yenxo::Variant&& x) {                                           \
+        return yenxo::trait::fromVariantImpl<T>(std::move(x));                           \
+    }                                                                                    \
+    static T fromVariant(yenxo::VariantView const& x) {                                  \
+        return yenxo::trait::fromVariantImpl<T>(x);                                      \
+    }                                                                                    \
+    static yenxo::FromVariantResult<T> tryFromVariant(yenxo::Variant const& x) {         \
+        return yenxo::trait::tryFromVariantImpl<T>(x);                                   \
     }
 
 /// Enables from `yenxo::Variant` conversion for `T`
@@ -552,6 +943,22 @@ protected:
 #define YENXO_FROM_VARIANT_P(T, Policy)                                                  \
     static T fromVariant(yenxo::Variant const& x) {                                      \
         return yenxo::trait::fromVariantImpl<T, Policy>(x);                              \
+    }                                                                                    \
+    static T fromVariant(yenxo::Variant&& x) {                                           \
+        return yenxo::trait::fromVariantImpl<T, Policy>(std::move(x));                   \
+    }                                                                                    \
+    static T fromVariant(yenxo::VariantView const& x) {                                  \
+        return yenxo::trait::fromVariantImpl<T, Policy>(x);                              \
+    }                                                                                    \
+    static yenxo::FromVariantResult<T> tryFromVariant(yenxo::Variant const& x) {         \
+        return yenxo::trait::tryFromVariantImpl<T, Policy>(x);                           \
+    }                                                                                    \
+    template <class P = Policy,                                                          \
+              class = std::enable_if_t<!std::is_same_v<                                  \
+                      std::remove_const_t<decltype(P::tag)>,                             \
+                      typename P::NoTag>>>                                               \
+    static constexpr auto variantTag() noexcept {                                        \
+        return P::tag;                                                                   \
     }
 
 /// Enables from `yenxo::Variant` update for `T`
@@ -0,0 +1,357 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <yenxo/variant.hpp>
+
+#include <rapidjson/fwd.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace yenxo {
+
+/// Read-only `Variant`-like view of `rapidjson::Value`
+/// \ingroup group-datatypes
+///
+/// The accessors follow the ones of `Variant` and throw the same exceptions; a value has
+/// the type `Variant::from` would give it. `fromVariant` accepts the view, so a DOM is
+/// converted into a struct without building an intermediate `Variant` tree.
+///
+/// The viewed value must outlive the view and the ranges obtained from it.
+class VariantView {
+public:
+    class Vec;
+    class Map;
+
+    using TypeTag = Variant::TypeTag;
+
+    explicit VariantView(rapidjson::Value const& json) noexcept
+            : json_(&json) {
+    }
+
+    TypeTag type() const noexcept;
+
+    /// Check if the view contains null
+    bool null() const noexcept {
+        return type() == TypeTag::null;
+    }
+
+    /// Test if the value is a scalar
+    bool isScalar() const noexcept {
+        return type() != TypeTag::map && type() != TypeTag::vec;
+    }
+
+    /// \throw VariantEmpty, VariantBadType, VariantIntegralOverflow
+    /// @{
+    bool boolean() const;
+    char character() const;
+    int8_t int8() const;
+    uint8_t uint8() const;
+    int16_t int16() const;
+    uint16_t uint16() const;
+    int32_t int32() const;
+    uint32_t uint32() const;
+    int64_t int64() const;
+    uint64_t uint64() const;
+    double floating() const;
+    /// @}
+
+    /// Get string
+    /// \throw VariantEmpty, VariantBadType
+    std::string_view str() const;
+
+    /// Get array
+    /// \throw VariantEmpty, VariantBadType
+    Vec vec() const;
+
+    /// Get object
+    /// \throw VariantEmpty, VariantBadType
+    Map map() const;
+
+    /// Copy the value into `Variant`
+    Variant variant() const;
+
+    rapidjson::Value const& json() const noexcept {
+        return *json_;
+    }
+
+    /// Get as one of `Variant::Types`
+    /// \throw VariantEmpty, VariantBadType, VariantIntegralOverflow
+    template <typename T, typename = std::enable_if_t<Variant::Types::anyOf<T>()>>
+    explicit operator T() const;
+
+    friend std::ostream& operator<<(std::ostream& os, VariantView const& x);
+
+private:
+    Variant scalar() const;
+
+    rapidjson::Value const* json_;
+};
+
+/// Array view of `VariantView`
+/// \ingroup group-datatypes
+class VariantView::Vec {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = VariantView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = VariantView;
+
+        const_iterator() noexcept = default;
+
+        VariantView operator*() const noexcept {
+            return Vec(json_)[i_];
+        }
+
+        const_iterator& operator++() noexcept {
+            ++i_;
+            return *this;
+        }
+        const_iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++i_;
+            return tmp;
+        }
+
+        bool operator==(const_iterator const& rhs) const noexcept {
+            return i_ == rhs.i_;
+        }
+        bool operator!=(const_iterator const& rhs) const noexcept {
+            return i_ != rhs.i_;
+        }
+
+    private:
+        friend class Vec;
+
+        const_iterator(rapidjson::Value const* json, uint32_t i) noexcept
+                : json_(json)
+                , i_(i) {
+        }
+
+        rapidjson::Value const* json_{};
+        uint32_t i_{};
+    };
+
+    using iterator = const_iterator;
+
+    std::size_t size() const noexcept;
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /// Get element `i`, no bounds check
+    VariantView operator[](std::size_t i) const noexcept;
+
+    /// Get element `i`
+    /// \throw std::out_of_range
+    VariantView at(std::size_t i) const;
+
+    const_iterator begin() const noexcept {
+        return {json_, 0};
+    }
+
+    const_iterator end() const noexcept {
+        return {json_, static_cast<uint32_t>(size())};
+    }
+
+    /// Copy the array into `Variant`
+    Variant variant() const;
+
+private:
+    friend class VariantView;
+
+    explicit Vec(rapidjson::Value const* json) noexcept
+            : json_(json) {
+    }
+
+    rapidjson::Value const* json_;
+};
+
+/// Object view of `VariantView`
+/// \ingroup group-datatypes
+///
+/// Iteration yields the members in document order. Of repeated keys only the last member
+/// is seen, as by `Variant::from`; the shadowed ones are found when the view is made.
+/// Lookup is linear, as in `rapidjson::Value::FindMember`.
+class VariantView::Map {
+    using Visible = std::vector<uint32_t>;
+
+public:
+    using value_type = std::pair<std::string_view, VariantView>;
+
+    class const_iterator {
+    public:
+        struct Arrow;
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Arrow;
+        using reference = value_type;
+
+        struct Arrow {
+            value_type value;
+
+            value_type const* operator->() const noexcept {
+                return &value;
+            }
+        };
+
+        const_iterator() noexcept = default;
+
+        value_type operator*() const noexcept {
+            return member(json_, visible_ ? (*visible_)[i_] : i_);
+        }
+
+        Arrow operator->() const noexcept {
+            return {**this};
+        }
+
+        const_iterator& operator++() noexcept {
+            ++i_;
+            return *this;
+        }
+        const_iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++i_;
+            return tmp;
+        }
+
+        bool operator==(const_iterator const& rhs) const noexcept {
+            return i_ == rhs.i_;
+        }
+        bool operator!=(const_iterator const& rhs) const noexcept {
+            return i_ != rhs.i_;
+        }
+
+    private:
+        friend class Map;
+
+        const_iterator(Map const& map, uint32_t i) noexcept
+                : json_(map.json_)
+                , visible_(map.visible_)
+                , i_(i) {
+        }
+
+        rapidjson::Value const* json_{};
+        std::shared_ptr<Visible const> visible_;
+        uint32_t i_{};
+    };
+
+    using iterator = const_iterator;
+
+    std::size_t size() const noexcept;
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /// Find the member `key`, the last one of repeated keys
+    const_iterator find(std::string_view key) const noexcept;
+
+    std::size_t count(std::string_view key) const noexcept {
+        return find(key) == end() ? 0 : 1;
+    }
+
+    /// Get the member `key`, the last one of repeated keys
+    /// \throw std::out_of_range
+    VariantView at(std::string_view key) const;
+
+    const_iterator begin() const noexcept {
+        return {*this, 0};
+    }
+
+    const_iterator end() const noexcept {
+        return {*this, static_cast<uint32_t>(size())};
+    }
+
+    /// Copy the object into `Variant`
+    Variant variant() const;
+
+private:
+    friend class VariantView;
+
+    explicit Map(rapidjson::Value const* json);
+
+    static value_type member(rapidjson::Value const* json, uint32_t i) noexcept;
+
+    rapidjson::Value const* json_;
+
+    /// Indexes of the members not shadowed by a later one, null without repeated keys
+    std::shared_ptr<Visible const> visible_;
+};
+
+/// Find the last member `key` in `map`
+/// \see findKey(Variant::Map const&, Key const&)
+/// \ingroup group-utility
+template <class Key>
+VariantView::Map::const_iterator findKey(VariantView::Map const& map, Key const& key) {
+    if constexpr (std::is_same_v<Key, HashedKey>) {
+        return map.find(key.str);
+    } else {
+        return map.find(key);
+    }
+}
+
+/// Get the last member `key` in `map`
+/// \ingroup group-utility
+/// \throw std::out_of_range
+template <class Key>
+VariantView atKey(VariantView::Map const& map, Key const& key) {
+    if constexpr (std::is_same_v<Key, HashedKey>) {
+        return map.at(key.str);
+    } else {
+        return map.at(key);
+    }
+}
+
+template <typename T, typename>
+VariantView::operator T() const {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return std::string(str());
+    } else if constexpr (std::is_same_v<T, Variant::Vec>) {
+        auto tmp = vec().variant();
+        return std::move(tmp.modifyVec());
+    } else if constexpr (std::is_same_v<T, Variant::Map>) {
+        auto tmp = map().variant();
+        return std::move(tmp.modifyMap());
+    } else {
+        return static_cast<T>(scalar());
+    }
+}
+
+} // namespace yenxo
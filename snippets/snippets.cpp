@@ -22,6 +22,11 @@
   SOFTWARE.
 */
 
+#include <yenxo/from_query_string.hpp>
+#include <yenxo/json_parse_cache.hpp>
+#include <yenxo/json_patch.hpp>
+#include <yenxo/query_string.hpp>
+#include <yenxo/to_query_string.hpp>
 #include <yenxo/variant.hpp>
 
 #include <rapidjson/document.h>
@@ -278,4 +283,161 @@ static void bm_var_rj_json(benchmark::State& state) {
 }
 BENCHMARK(bm_var_rj_json);
 
+static void bm_var_json_parse_cache(benchmark::State& state) {
+    std::string const raw = R"({
+        "x": 6,
+        "y": [1, 2],
+        "z": {
+            "a": "a",
+            "b": "b"
+        },
+        "a": null
+    })";
+    JsonParseCache cache;
+
+    for (auto _ : state) {
+        auto var = cache.parse(raw);
+        benchmark::DoNotOptimize(var);
+    }
+}
+BENCHMARK(bm_var_json_parse_cache);
+
+static void bm_var_hash(benchmark::State& state) {
+    auto const var = yenxo::Variant::fromJson(R"({
+        "x": 6,
+        "y": [1, 2],
+        "z": {
+            "a": "a",
+            "b": "b"
+        },
+        "a": null
+    })");
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hashValue(var));
+    }
+}
+BENCHMARK(bm_var_hash);
+
+static void bm_var_equal(benchmark::State& state) {
+    Variant::Map map;
+    for (int i = 0; i < 100; ++i) {
+        map.emplace("key" + std::to_string(i),
+                    Variant(Variant::Vec{Variant(i), Variant(i + 0.5), Variant("x")}));
+    }
+    Variant const lhs(map);
+    Variant const rhs(map);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(equal(lhs, rhs));
+    }
+}
+BENCHMARK(bm_var_equal);
+
+static void bm_var_diff(benchmark::State& state) {
+    Variant::Map map;
+    for (int i = 0; i < 100; ++i) {
+        map.emplace("key" + std::to_string(i),
+                    Variant(Variant::Vec{Variant(i), Variant(i + 0.5), Variant("x")}));
+    }
+    Variant const from(map);
+    map.at("key50").modifyVec().at(2) = Variant("y");
+    Variant const to(map);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(diff(from, to));
+    }
+}
+BENCHMARK(bm_var_diff);
+
+static auto const query =
+        "page=2&per_page=50&sort=created_at&filter%5Bstatus%5D=open"
+        "&filter%5Blabels%5D%5B%5D=bug&filter%5Blabels%5D%5B%5D=help%20wanted"
+        "&q=parse%20query%20strings%20fast";
+
+static void bm_query_string_spirit(benchmark::State& state) {
+    detail::SpiritQueryStringParser parser(QueryStringParser::Limits{});
+    Variant out;
+    for (auto _ : state) {
+        parser.parse(query, out);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(bm_query_string_spirit);
+
+static void bm_query_string_parser(benchmark::State& state) {
+    QueryStringParser parser;
+    Variant out;
+    for (auto _ : state) {
+        parser.parse(query, out);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(bm_query_string_parser);
+
+static void bm_query_string_scan(benchmark::State& state) {
+    QueryStringParser parser;
+    for (auto _ : state) {
+        auto const& params = parser.scan(query);
+        benchmark::DoNotOptimize(params.data());
+    }
+}
+BENCHMARK(bm_query_string_scan);
+
+struct IssueFilter : trait::Var<IssueFilter> {
+    BOOST_HANA_DEFINE_STRUCT(IssueFilter,
+                             (std::string, status),
+                             (std::vector<std::string>, labels));
+};
+
+// strings only, as `query_string` produces
+struct IssueQuery {
+    BOOST_HANA_DEFINE_STRUCT(IssueQuery,
+                             (std::string, page),
+                             (std::string, per_page),
+                             (std::string, sort),
+                             (IssueFilter, filter),
+                             (std::string, q));
+};
+
+static void bm_query_string_struct_variant(benchmark::State& state) {
+    QueryStringParser parser;
+    Variant out;
+    for (auto _ : state) {
+        parser.parse(query, out);
+        auto const x = trait::fromVariantImpl<IssueQuery>(out);
+        benchmark::DoNotOptimize(x);
+    }
+}
+BENCHMARK(bm_query_string_struct_variant);
+
+static void bm_query_string_struct(benchmark::State& state) {
+    QueryStringParser parser;
+    for (auto _ : state) {
+        auto const x = fromQueryString<IssueQuery>(parser, query);
+        benchmark::DoNotOptimize(x);
+    }
+}
+BENCHMARK(bm_query_string_struct);
+
+static void bm_to_query_string(benchmark::State& state) {
+    auto const params = query_string(query);
+    QueryStringWriter writer;
+    for (auto _ : state) {
+        auto const x = writer.write(params);
+        benchmark::DoNotOptimize(x.data());
+    }
+}
+BENCHMARK(bm_to_query_string);
+
+static void bm_to_query_string_struct(benchmark::State& state) {
+    auto const params = fromQueryString<IssueQuery>(query);
+    QueryStringWriter writer;
+    for (auto _ : state) {
+        auto const x = writer.write(params);
+        benchmark::DoNotOptimize(x.data());
+    }
+}
+BENCHMARK(bm_to_query_string_struct);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,283 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <yenxo/exception.hpp>
+#include <yenxo/raw_number.hpp>
+#include <yenxo/type_name.hpp>
+#include <yenxo/variant.hpp>
+#include <yenxo/when.hpp>
+
+#include <boost/hana/type.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+namespace yenxo::detail {
+
+template <typename A, typename B>
+constexpr auto same_sign_v = std::is_signed_v<A> == std::is_signed_v<B>;
+
+struct ThrowVariantIntegralOverflow {
+    template <class Type, class Value>
+    [[noreturn]] static typename Type::type apply(Type t, Value const& v) {
+        throw VariantIntegralOverflow(t, std::to_string(v));
+    }
+    template <class Type>
+    [[noreturn]] static typename Type::type apply(Type t, std::string const& v) {
+        throw VariantIntegralOverflow(t, v);
+    }
+};
+
+// Raises a per-thread flag instead of throwing, the cast result is then unspecified
+struct FlagVariantIntegralOverflow {
+    static inline thread_local bool overflow = false;
+
+    template <class Type, class Value>
+    static typename Type::type apply(Type, Value const&) noexcept {
+        overflow = true;
+        return {};
+    }
+};
+
+// Casts `U` to `T` if a specific value of `U` is representable in `T` else throws
+// `VariantIntegralOverflow`.
+template <typename T,
+          typename U,
+          typename ThrowPolicy = ThrowVariantIntegralOverflow,
+          typename = void>
+struct ArithmeticCheckedCast final
+        : ArithmeticCheckedCast<T, U, ThrowPolicy, When<true>> {
+    static_assert(std::is_arithmetic_v<T> && std::is_arithmetic_v<U>);
+};
+
+template <typename T, typename U, typename P>
+struct ArithmeticCheckedCast<T, U, P, When<same_sign_v<T, U> && sizeof(T) >= sizeof(U)>> {
+    static T apply(U x) noexcept {
+        return x;
+    }
+};
+
+template <typename T, typename U, typename P>
+struct ArithmeticCheckedCast<T, U, P, When<same_sign_v<T, U> && sizeof(T) < sizeof(U)>> {
+    static T apply(U x) {
+        if (x < std::numeric_limits<T>::min() || x > std::numeric_limits<T>::max()) {
+            return P::apply(boost::hana::type_c<T>, x);
+        } else {
+            return static_cast<T>(x);
+        }
+    }
+};
+
+template <typename T, typename U, typename P>
+struct ArithmeticCheckedCast<
+        T,
+        U,
+        P,
+        When<std::is_signed_v<T> && std::is_unsigned_v<U> && (sizeof(T) > sizeof(U))>> {
+    static T apply(U x) noexcept {
+        return x;
+    }
+};
+
+template <typename T, typename U, typename P>
+struct ArithmeticCheckedCast<
+        T,
+        U,
+        P,
+        When<std::is_signed_v<T> && std::is_unsigned_v<U> && (sizeof(T) <= sizeof(U))>> {
+    static T apply(U x) {
+#if defined(__GNUG__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-compare"
+        if (x > std::numeric_limits<T>::max()) {
+#pragma GCC diagnostic pop
+#else
+#error The compiler not supported
+#endif
+            return P::apply(boost::hana::type_c<T>, x);
+        }
+        return static_cast<T>(x);
+    }
+};
+
+template <typename T, typename U, typename P>
+struct ArithmeticCheckedCast<
+        T,
+        U,
+        P,
+        When<std::is_unsigned_v<T> && std::is_signed_v<U> && sizeof(T) >= sizeof(U)>> {
+    static T apply(U x) {
+        if (x < 0) {
+            return P::apply(boost::hana::type_c<T>, x);
+        } else {
+            return static_cast<T>(x);
+        }
+    }
+};
+
+template <typename T, typename U, typename P>
+struct ArithmeticCheckedCast<
+        T,
+        U,
+        P,
+        When<std::is_unsigned_v<T> && std::is_signed_v<U> && sizeof(T) < sizeof(U)>> {
+    static T apply(U x) {
+#if defined(__GNUG__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-compare"
+        if (x < 0 || x > std::numeric_limits<T>::max()) {
+#pragma GCC diagnostic pop
+#else
+#error The compiler not supported
+#endif
+            return P::apply(boost::hana::type_c<T>, x);
+        }
+        return static_cast<T>(x);
+    }
+};
+
+template <typename U, typename P>
+struct ArithmeticCheckedCast<double, U, P> {
+    static double apply(U x) noexcept {
+        return x;
+    }
+};
+
+template <typename T, typename P>
+struct ArithmeticCheckedCast<T, double, P> {
+    static T apply(double x) {
+        double iptr;
+        if (std::modf(x, &iptr) == 0.0) {
+            return ArithmeticCheckedCast<T, int64_t, P>::apply(static_cast<int64_t>(x));
+        } else {
+            return P::apply(boost::hana::type_c<T>, x);
+        }
+    }
+};
+
+template <typename P>
+struct ArithmeticCheckedCast<double, double, P> {
+    static double apply(double x) noexcept {
+        return x;
+    }
+};
+
+template <typename U, typename P>
+struct ArithmeticCheckedCast<bool, U, P> {
+    static bool apply(U x) {
+        if (x != 0 && x != 1) {
+            return P::apply(boost::hana::type_c<bool>, x);
+        } else {
+            return static_cast<bool>(x);
+        }
+    }
+};
+
+template <typename T, typename P>
+struct ArithmeticCheckedCast<T, bool, P> {
+    static T apply(bool x) noexcept {
+        return x;
+    }
+};
+
+template <typename P>
+struct ArithmeticCheckedCast<bool, bool, P> {
+    static bool apply(bool x) noexcept {
+        return x;
+    }
+};
+
+template <typename P>
+struct ArithmeticCheckedCast<double, bool, P> {
+    static double apply(bool x) noexcept {
+        return x;
+    }
+};
+
+template <typename P>
+struct ArithmeticCheckedCast<bool, double, P> {
+    static bool apply(double x) {
+        if (x != 0.0 && x != 1.0) {
+            return P::apply(boost::hana::type_c<bool>, x);
+        } else {
+            return static_cast<bool>(x);
+        }
+    }
+};
+
+template <typename Dst, typename P = ThrowVariantIntegralOverflow>
+struct ArithmeticCheckedCastT {
+    template <typename Src>
+    Dst operator()(Src x) const
+            noexcept(noexcept(ArithmeticCheckedCast<Dst, Src, P>::apply(x))) {
+        return ArithmeticCheckedCast<Dst, Src, P>::apply(x);
+    }
+};
+
+template <typename T, typename P = ThrowVariantIntegralOverflow>
+constexpr ArithmeticCheckedCastT<T, P> arithmeticCheckedCast;
+
+// Converts the text of `x` to `T` if the value is representable in `T` else throws
+// `VariantIntegralOverflow`.
+template <typename T, typename P = ThrowVariantIntegralOverflow>
+T rawNumberCheckedCast(RawNumber const& x) {
+    auto const overflow = [&] { return P::apply(boost::hana::type_c<T>, x.text()); };
+    auto const var = x.parse();
+    switch (var.type()) {
+    case Variant::TypeTag::int32:
+        return arithmeticCheckedCast<T, P>(var.int32());
+    case Variant::TypeTag::uint32:
+        return arithmeticCheckedCast<T, P>(var.uint32());
+    case Variant::TypeTag::int64:
+        return arithmeticCheckedCast<T, P>(var.int64());
+    case Variant::TypeTag::uint64:
+        return arithmeticCheckedCast<T, P>(var.uint64());
+    default:
+        break;
+    }
+    auto const d = var.floating();
+    if (std::isinf(d)) {
+        return overflow();
+    }
+    if constexpr (std::is_floating_point_v<T>) {
+        return d;
+    } else {
+        // out of 64-bit range the cast to an integer is undefined
+        double iptr;
+        if (std::modf(d, &iptr) != 0.0 || d < -0x1p63 || d >= 0x1p64) {
+            return overflow();
+        }
+        if (d < 0) {
+            return arithmeticCheckedCast<T, P>(static_cast<int64_t>(d));
+        }
+        return arithmeticCheckedCast<T, P>(static_cast<uint64_t>(d));
+    }
+}
+
+} // namespace yenxo::detail
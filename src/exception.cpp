@@ -0,0 +1,105 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/exception.hpp>
+
+namespace yenxo {
+
+namespace detail {
+
+std::string ErrorPath::render() const {
+    std::string ret;
+    for (auto it = frames_.rbegin(); it != frames_.rend(); ++it) {
+        ret += '/';
+        if (auto const i = std::get_if<std::size_t>(&*it)) {
+            ret += std::to_string(*i);
+            continue;
+        }
+        for (auto c : *std::get_if<std::string>(&*it)) {
+            if (c == '~') {
+                ret += "~0";
+            } else if (c == '/') {
+                ret += "~1";
+            } else {
+                ret += c;
+            }
+        }
+    }
+    return ret;
+}
+
+} // namespace detail
+
+std::string VariantErr::render() const {
+    switch (kind_) {
+    case Kind::text:
+        break;
+    case Kind::empty:
+        return "expected '" + expected_() + "', actual: 'Empty'";
+    case Kind::bad_type:
+        return "expected '" + expected_() + "', actual '" + actual_() + "'";
+    case Kind::bad_value:
+        return "'" + value_ + "' is not of type '" + expected_() + "'";
+    case Kind::overflow:
+        return "The type '" + expected_() + "' can not hold the value '" + value_ + "'";
+    }
+    return runtime_error::what();
+}
+
+std::string const& VariantErr::path() const noexcept {
+    if (!path_ready_) {
+#if YENXO_EXCEPTIONS
+        try {
+            path_ = frames_.render();
+        } catch (...) {
+            path_.clear();
+        }
+#else
+        path_ = frames_.render();
+#endif
+        path_ready_ = true;
+    }
+    return path_;
+}
+
+char const* VariantErr::what() const noexcept {
+    if (kind_ == Kind::text) {
+        return runtime_error::what();
+    }
+    if (!message_ready_) {
+#if YENXO_EXCEPTIONS
+        try {
+            message_ = render();
+        } catch (...) {
+            return "yenxo::VariantErr";
+        }
+#else
+        message_ = render();
+#endif
+        message_ready_ = true;
+    }
+    return message_.c_str();
+}
+
+} // namespace yenxo
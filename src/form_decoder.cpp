@@ -0,0 +1,223 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "query_string_builder.hpp"
+#include "query_string_scanner.hpp"
+
+#include <yenxo/form_decoder.hpp>
+#include <yenxo/variant.hpp>
+
+#include <cstring>
+#include <string>
+
+namespace yenxo {
+namespace {
+
+// Feeds the builder through the handler interface
+class BuilderHandler final : public QueryStringParser::Handler {
+public:
+    explicit BuilderHandler(detail::QueryStringBuilder& builder) noexcept
+            : builder_(builder) {
+    }
+
+    void paramName(std::string_view x) override {
+        builder_.paramName(x);
+    }
+
+    void indexOp(uint64_t i) override {
+        builder_.indexOp(i);
+    }
+
+    void propertyOp(std::string_view x) override {
+        builder_.propertyOp(x);
+    }
+
+    void emptyIndexOp() override {
+        builder_.emptyIndexOp();
+    }
+
+    void value(std::string_view, std::string_view x) override {
+        builder_.val(x);
+    }
+
+private:
+    detail::QueryStringBuilder& builder_;
+};
+
+} // namespace
+
+struct FormDecoder::Impl {
+    explicit Impl(Options const& options)
+            : options(options)
+            , builder(QueryStringParser::Limits{options.array_length,
+                                                options.object_depth,
+                                                options.object_property_count})
+            , builder_handler(builder) {
+    }
+
+    void start(QueryStringParser::Handler& x) {
+        handler = &x;
+        pending.clear();
+        consumed = 0;
+        stopped = false;
+    }
+
+    /// Decode the complete parameters `str`, which start at `consumed` in the body
+    void scan(std::string_view str) {
+        if (stopped || str.empty()) {
+            return;
+        }
+        checkLength(str);
+        if (decoded.size() < str.size()) {
+            decoded.resize(str.size());
+        }
+        detail::QueryStringScanner<QueryStringParser::Handler> scanner(
+                str, decoded.data(), *handler, options.plus_as_space);
+        if (!scanner.scan()) {
+            fail(str);
+        }
+        // as `query_string`, the parameters after one not followed by `&` are ignored
+        stopped = scanner.position() != str.data() + str.size();
+    }
+
+    void checkLength(std::string_view str) const {
+        for (auto p = str.data(), end = p + str.size();;) {
+            auto const amp = static_cast<char const*>(
+                    std::memchr(p, '&', static_cast<std::size_t>(end - p)));
+            auto const param_end = amp ? amp : end;
+            if (static_cast<std::size_t>(param_end - p) > options.param_length) {
+                throwLengthError();
+            }
+            if (!amp) {
+                return;
+            }
+            p = amp + 1;
+        }
+    }
+
+    [[noreturn]] void throwLengthError() const {
+        throw QueryStringError("parameter length exceed "
+                               + std::to_string(options.param_length));
+    }
+
+    /// Describe the syntax error of `str`
+    [[noreturn]] void fail(std::string_view str) const {
+        detail::SpiritQueryStringParser spirit(builder.limits());
+        Variant out;
+        spirit.parse(str, out, consumed);
+        throw QueryStringError("malformed query string", std::string(str));
+    }
+
+    Options options;
+    detail::QueryStringBuilder builder;
+    BuilderHandler builder_handler;
+    std::unique_ptr<detail::QueryDecoder> decoder;
+    QueryStringParser::Handler* handler{nullptr};
+    // the unfinished parameter of the previous chunks
+    std::string pending;
+    // the bytes of the body before `pending`
+    std::size_t consumed{0};
+    std::string decoded;
+    bool stopped{false};
+};
+
+FormDecoder::FormDecoder()
+        : FormDecoder(Options{}) {
+}
+
+FormDecoder::FormDecoder(Options const& options)
+        : impl_(std::make_unique<Impl>(options)) {
+}
+
+FormDecoder::~FormDecoder() noexcept = default;
+
+FormDecoder::FormDecoder(FormDecoder&& rhs) noexcept = default;
+
+FormDecoder& FormDecoder::operator=(FormDecoder&& rhs) noexcept = default;
+
+FormDecoder::Options const& FormDecoder::options() const noexcept {
+    return impl_->options;
+}
+
+void FormDecoder::start(Variant& out) {
+    out = Variant(VariantMap());
+    impl_->decoder.reset();
+    impl_->builder.reset(out.modifyMap());
+    impl_->start(impl_->builder_handler);
+}
+
+void FormDecoder::feed(std::string_view chunk) {
+    auto& impl = *impl_;
+    auto const amp = chunk.rfind('&');
+    if (amp == std::string_view::npos) {
+        if (impl.pending.size() + chunk.size() > impl.options.param_length) {
+            impl.throwLengthError();
+        }
+        impl.pending += chunk;
+        return;
+    }
+    if (impl.pending.empty()) {
+        impl.scan(chunk.substr(0, amp));
+        impl.consumed += amp + 1;
+    } else {
+        impl.pending.append(chunk.data(), amp);
+        impl.scan(impl.pending);
+        impl.consumed += impl.pending.size() + 1;
+    }
+    auto const rest = chunk.substr(amp + 1);
+    if (rest.size() > impl.options.param_length) {
+        impl.throwLengthError();
+    }
+    impl.pending.assign(rest.data(), rest.size());
+}
+
+void FormDecoder::finish() {
+    auto& impl = *impl_;
+    impl.scan(impl.pending);
+    impl.pending.clear();
+    if (impl.decoder) {
+        impl.decoder->finish();
+    }
+}
+
+QueryStringParser::Limits FormDecoder::queryLimits() const noexcept {
+    auto const& options = impl_->options;
+    return {options.array_length, options.object_depth, options.object_property_count};
+}
+
+void FormDecoder::startDecoder(std::unique_ptr<detail::QueryDecoder> decoder) {
+    impl_->decoder = std::move(decoder);
+    impl_->start(*impl_->decoder);
+}
+
+Variant decodeForm(std::string_view str, FormDecoder::Options const& options) {
+    FormDecoder decoder(options);
+    Variant ret{VariantMap()};
+    decoder.start(ret);
+    decoder.feed(str);
+    decoder.finish();
+    return ret;
+}
+
+} // namespace yenxo
@@ -0,0 +1,137 @@
+/*
+  MIT License
+
+  Copyright (c) 2018 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <yenxo/variant.hpp>
+
+#include <rapidjson/reader.h>
+
+#include <cassert>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace yenxo::detail {
+
+/// RapidJSON visitor
+template <typename Encoding>
+struct FromJson : rapidjson::BaseReaderHandler<Encoding, FromJson<Encoding>> {
+    template <class T>
+    void val(T&& x) {
+        switch (ptrs.back()->type()) {
+        case Variant::TypeTag::map:
+            ptrs.back()->modifyMap()[std::move(key)] = Variant(std::forward<T>(x));
+            break;
+        case Variant::TypeTag::vec:
+            ptrs.back()->modifyVec().push_back(Variant(std::forward<T>(x)));
+            break;
+        default:
+            *ptrs.back() = Variant(std::forward<T>(x));
+        }
+    }
+
+    template <class T>
+    Variant* val2(T&& x) {
+        switch (ptrs.back()->type()) {
+        case Variant::TypeTag::map:
+            return &(ptrs.back()->modifyMap()[std::move(key)] = Variant(std::forward<T>(x)));
+        case Variant::TypeTag::vec:
+            ptrs.back()->modifyVec().push_back(Variant(std::forward<T>(x)));
+            return &ptrs.back()->modifyVec().back();
+        default:
+            return &(*ptrs.back() = Variant(std::forward<T>(x)));
+        }
+    }
+
+    bool Null() {
+        val(Variant::NullType());
+        return true;
+    }
+    bool Bool(bool b) {
+        val(b);
+        return true;
+    }
+    bool Int(int32_t i) {
+        val(i);
+        return true;
+    }
+    bool Uint(uint32_t u) {
+        val(u);
+        return true;
+    }
+    bool Int64(int64_t i64) {
+        val(i64);
+        return true;
+    }
+    bool Uint64(uint64_t u64) {
+        val(u64);
+        return true;
+    }
+    bool Double(double d) {
+        val(d);
+        return true;
+    }
+    bool String(typename Encoding::Ch const* str, rapidjson::SizeType length, bool) {
+        val(std::string(str, length));
+        return true;
+    }
+    bool RawNumber(typename Encoding::Ch const* str, rapidjson::SizeType length, bool) {
+        val(yenxo::RawNumber(std::string(str, length), yenxo::RawNumber::Validated{}));
+        return true;
+    }
+    bool StartObject() {
+        ptrs.push_back(val2(Variant::Map()));
+        return true;
+    }
+    bool Key(typename Encoding::Ch const* str, rapidjson::SizeType length, bool) {
+        assert(ptrs.back()->type() == Variant::TypeTag::map);
+        key = std::string(str, length);
+        return true;
+    }
+    bool EndObject(rapidjson::SizeType n) {
+        assert(ptrs.back()->type() == Variant::TypeTag::map);
+        assert(ptrs.back()->map().size() == n);
+        (void)n;
+        ptrs.pop_back();
+        return true;
+    }
+    bool StartArray() {
+        ptrs.push_back(val2(Variant::Vec()));
+        return true;
+    }
+    bool EndArray(rapidjson::SizeType n) {
+        assert(ptrs.back()->type() == Variant::TypeTag::vec);
+        assert(ptrs.back()->vec().size() == n);
+        (void)n;
+        ptrs.pop_back();
+        return true;
+    }
+
+    Variant var;
+    std::vector<Variant*> ptrs{&var};
+    std::string key;
+};
+
+} // namespace yenxo::detail
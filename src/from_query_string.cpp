@@ -0,0 +1,169 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "query_string_builder.hpp"
+
+#include <yenxo/from_query_string.hpp>
+
+#include <cassert>
+#include <functional>
+#include <utility>
+
+namespace yenxo::detail {
+
+QueryDecoder::QueryDecoder(QueryStringParser::Limits const& limits, QueryTarget root)
+        : limits_(limits)
+        , root_(root)
+        , current_(root) {
+    if (root.ops->created) {
+        root.ops->created(root.obj, *this, std::string());
+    }
+}
+
+void QueryDecoder::paramName(std::string_view name) {
+    key_.clear();
+    current_ = root_.ops->property(root_.obj, name, *this);
+    key_ = name;
+    param_name_ = name;
+    depth_ = 0;
+}
+
+void QueryDecoder::indexOp(uint64_t i) {
+    current_ = current_.ops->index(current_.obj, i, *this);
+    key_ += '[';
+    key_ += std::to_string(i);
+    key_ += ']';
+    if (++depth_ > limits_.object_depth) {
+        throw makeObjectDepthError(param_name_, limits_.object_depth);
+    }
+}
+
+void QueryDecoder::propertyOp(std::string_view key) {
+    current_ = current_.ops->property(current_.obj, key, *this);
+    key_ += '[';
+    key_ += key;
+    key_ += ']';
+    if (++depth_ > limits_.object_depth) {
+        throw makeObjectDepthError(param_name_, limits_.object_depth);
+    }
+}
+
+void QueryDecoder::emptyIndexOp() {
+    current_.ops->emptyIndex(current_.obj, *this);
+}
+
+void QueryDecoder::value(std::string_view, std::string_view x) {
+    current_.ops->value(current_.obj, x, *this);
+}
+
+void QueryDecoder::finish() {
+    for (auto const& x : tracked_) {
+        if (auto const missing =
+                    x.finish(const_cast<void*>(x.obj), seen_.data() + x.first)) {
+            throw QueryStringError("'" + *missing + "' is required"
+                                   + (x.key.empty() ? "" : " for " + x.key));
+        }
+    }
+}
+
+std::string QueryDecoder::childKey(std::string_view x) const {
+    if (key_.empty()) {
+        return std::string(x);
+    }
+    std::string ret;
+    ret.reserve(key_.size() + x.size() + 2);
+    ret += key_;
+    ret += '[';
+    ret += x;
+    ret += ']';
+    return ret;
+}
+
+std::string QueryDecoder::childKey(uint64_t i) const {
+    return key_ + '[' + std::to_string(i) + ']';
+}
+
+void QueryDecoder::track(void* obj,
+                         std::size_t field_count,
+                         Finish finish,
+                         std::string key) {
+    tracked_.push_back({obj, finish, seen_.size(), std::move(key)});
+    seen_.resize(seen_.size() + field_count);
+}
+
+bool QueryDecoder::mark(void const* obj, Finish finish, std::size_t i) noexcept {
+    // the recently tracked structs are the likely ones
+    for (auto it = tracked_.rbegin(); it != tracked_.rend(); ++it) {
+        if (it->obj == obj && it->finish == finish) {
+            auto& seen = seen_[it->first + i];
+            return !std::exchange(seen, true);
+        }
+    }
+    assert(false && "the struct is not tracked");
+    return false;
+}
+
+void QueryDecoder::relocated(void const* old,
+                             std::size_t size,
+                             void const* now) noexcept {
+    auto const first = static_cast<char const*>(old);
+    auto const last = first + size;
+    for (auto& x : tracked_) {
+        auto const p = static_cast<char const*>(x.obj);
+        if (std::less_equal<>()(first, p) && std::less<>()(p, last)) {
+            x.obj = static_cast<char const*>(now) + (p - first);
+        }
+    }
+}
+
+void QueryDecoder::mixedTypes(char const* expected, char const* actual) const {
+    throw makeMixedTypesError(key_, expected, actual);
+}
+
+void QueryDecoder::badValue(std::string_view x, std::string_view type) const {
+    throw QueryStringError("'" + std::string(x) + "' is not of type '" + std::string(type)
+                           + "' for " + key_);
+}
+
+void QueryDecoder::unknownMember(std::string_view x) const {
+    throw QueryStringError("'" + std::string(x) + "' is unknown"
+                           + (key_.empty() ? "" : " for " + key_));
+}
+
+void QueryDecoder::propertyCountExceeded() const {
+    if (key_.empty()) {
+        throw makeObjectPropertyCountError(limits_.object_property_count);
+    }
+    throw makeObjectPropertyCountError(key_, limits_.object_property_count);
+}
+
+void QueryDecoder::arrayIndexExceeded() const {
+    throw makeArrayIndexError(key_, limits_.array_length);
+}
+
+void QueryDecoder::arrayLengthExceeded() const {
+    throw makeArrayLengthError(key_, limits_.array_length);
+}
+
+} // namespace yenxo::detail
@@ -0,0 +1,536 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/exception.hpp>
+#include <yenxo/frozen_variant.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace yenxo {
+
+/// Tape entry
+///
+/// A container entry stores the number of its elements in `link` and is followed by that
+/// many slot entries, `link` of a slot is the index of the element's entry. Slots of a map
+/// are string entries holding the keys in ascending order.
+struct FrozenVariant::Entry {
+    Variant::TypeTag tag;
+    uint32_t link;
+    union {
+        bool bool_;
+        char char_;
+        int8_t int8;
+        uint8_t uint8;
+        int16_t int16;
+        uint16_t uint16;
+        int32_t int32;
+        uint32_t uint32;
+        int64_t int64;
+        uint64_t uint64;
+        double double_;
+        struct {
+            uint32_t offset;
+            uint32_t size;
+        } str;
+    } value;
+};
+
+namespace {
+
+using TypeTag = Variant::TypeTag;
+
+uint32_t checkedOffset(std::size_t x) {
+    if (x > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("FrozenVariant: the value is too big");
+    }
+    return static_cast<uint32_t>(x);
+}
+
+template <typename T>
+[[noreturn]] void throwBadAccess(TypeTag tag) {
+    auto const t = boost::hana::type_c<T>;
+    switch (tag) {
+    case TypeTag::string:
+        throw VariantBadType(t, boost::hana::type_c<std::string>);
+    case TypeTag::vec:
+        throw VariantBadType(t, boost::hana::type_c<Variant::Vec>);
+    case TypeTag::map:
+        throw VariantBadType(t, boost::hana::type_c<Variant::Map>);
+    case TypeTag::raw_json:
+        throw VariantBadType(t, boost::hana::type_c<RawJson>);
+    default:
+        break;
+    }
+    throw std::logic_error("FrozenVariant: unexpected scalar type");
+}
+
+} // namespace
+
+struct FrozenVariant::Impl {
+    static_assert(sizeof(Entry) == 16);
+
+    /// Tape of null, owned by no object
+    static Entry* nullTape() noexcept {
+        static Entry tape[1] = {Entry{TypeTag::null, 0, {}}};
+        return tape;
+    }
+
+    /// Make `x` a frozen null
+    static void reset(FrozenVariant& x) noexcept {
+        x.tape_.reset(nullTape());
+        x.entry_count_ = 1;
+        x.pool_size_ = 0;
+    }
+
+    struct Builder {
+        std::vector<Entry> tape;
+        std::string pool;
+
+        uint32_t string(std::string const& x, Entry& e, TypeTag tag = TypeTag::string) {
+            e.tag = tag;
+            e.value.str.offset = checkedOffset(pool.size());
+            e.value.str.size = checkedOffset(x.size());
+            pool += x;
+            return e.value.str.offset;
+        }
+
+        void build(Variant const& var) {
+            auto const index = tape.size();
+            checkedOffset(index);
+            tape.push_back(Entry{var.type(), 0, {}});
+
+            switch (var.type()) {
+            case TypeTag::null:
+                break;
+            case TypeTag::boolean:
+                tape.back().value.bool_ = var.boolean();
+                break;
+            case TypeTag::char_:
+                tape.back().value.char_ = var.character();
+                break;
+            case TypeTag::int8:
+                tape.back().value.int8 = var.int8();
+                break;
+            case TypeTag::uint8:
+                tape.back().value.uint8 = var.uint8();
+                break;
+            case TypeTag::int16:
+                tape.back().value.int16 = var.int16();
+                break;
+            case TypeTag::uint16:
+                tape.back().value.uint16 = var.uint16();
+                break;
+            case TypeTag::int32:
+                tape.back().value.int32 = var.int32();
+                break;
+            case TypeTag::uint32:
+                tape.back().value.uint32 = var.uint32();
+                break;
+            case TypeTag::int64:
+                tape.back().value.int64 = var.int64();
+                break;
+            case TypeTag::uint64:
+                tape.back().value.uint64 = var.uint64();
+                break;
+            case TypeTag::double_:
+                tape.back().value.double_ = var.floating();
+                break;
+            case TypeTag::string:
+                string(var.str(), tape.back());
+                break;
+            case TypeTag::raw_json:
+                string(var.raw().json(), tape.back(), TypeTag::raw_json);
+                break;
+            case TypeTag::raw_number:
+                string(var.number().text(), tape.back(), TypeTag::raw_number);
+                break;
+            case TypeTag::vec: {
+                auto const& vec = var.vec();
+                tape[index].link = checkedOffset(vec.size());
+                tape.resize(index + 1 + vec.size(), Entry{TypeTag::null, 0, {}});
+                for (std::size_t i = 0; i < vec.size(); ++i) {
+                    tape[index + 1 + i].link = checkedOffset(tape.size());
+                    build(vec[i]);
+                }
+                break;
+            }
+            case TypeTag::map: {
+                auto const& map = var.map();
+                std::vector<Variant::Map::const_pointer> members;
+                members.reserve(map.size());
+                for (auto const& x : map) {
+                    members.push_back(std::addressof(x));
+                }
+                std::sort(members.begin(), members.end(), [](auto lhs, auto rhs) {
+                    return lhs->first < rhs->first;
+                });
+                tape[index].link = checkedOffset(members.size());
+                tape.resize(index + 1 + members.size(), Entry{TypeTag::null, 0, {}});
+                for (std::size_t i = 0; i < members.size(); ++i) {
+                    string(members[i]->first, tape[index + 1 + i]);
+                    tape[index + 1 + i].link = checkedOffset(tape.size());
+                    build(members[i]->second);
+                }
+                break;
+            }
+            }
+        }
+    };
+
+    static std::size_t poolEntries(std::size_t pool_size) noexcept {
+        return (pool_size + sizeof(Entry) - 1) / sizeof(Entry);
+    }
+
+    static char const* pool(FrozenVariant const& x) noexcept {
+        return reinterpret_cast<char const*>(x.tape_.get() + x.entry_count_);
+    }
+
+    static std::string_view str(FrozenVariant const& x, Entry const& e) noexcept {
+        return {pool(x) + e.value.str.offset, e.value.str.size};
+    }
+
+    static Variant thaw(Node const& node) {
+        auto const& e = node.entry();
+        switch (e.tag) {
+        case TypeTag::string: {
+            auto const s = node.str();
+            return Variant(std::string(s.data(), s.size()));
+        }
+        case TypeTag::raw_json:
+            return Variant(node.raw());
+        case TypeTag::vec: {
+            auto const vec = node.vec();
+            Variant::Vec ret;
+            ret.reserve(vec.size());
+            for (auto const& x : vec) {
+                ret.push_back(thaw(x));
+            }
+            return Variant(std::move(ret));
+        }
+        case TypeTag::map: {
+            auto const map = node.map();
+            Variant::Map ret;
+            ret.reserve(map.size());
+            for (auto const& [key, x] : map) {
+                ret.emplace(std::string(key.data(), key.size()), thaw(x));
+            }
+            return Variant(std::move(ret));
+        }
+        default:
+            return node.scalar();
+        }
+    }
+
+    static bool equal(Node const& lhs, Node const& rhs) {
+        if (lhs.type() != rhs.type()) {
+            return false;
+        }
+        switch (lhs.type()) {
+        case TypeTag::string:
+            return lhs.str() == rhs.str();
+        case TypeTag::raw_json:
+            return Impl::str(*lhs.owner_, lhs.entry()) == Impl::str(*rhs.owner_, rhs.entry());
+        case TypeTag::vec: {
+            auto const l = lhs.vec();
+            auto const r = rhs.vec();
+            return l.size() == r.size()
+                && std::equal(l.begin(), l.end(), r.begin(), &Impl::equal);
+        }
+        case TypeTag::map: {
+            auto const l = lhs.map();
+            auto const r = rhs.map();
+            return l.size() == r.size()
+                && std::equal(l.begin(), l.end(), r.begin(), [](auto lhs, auto rhs) {
+                       return lhs.first == rhs.first && equal(lhs.second, rhs.second);
+                   });
+        }
+        default:
+            return lhs.scalar() == rhs.scalar();
+        }
+    }
+};
+
+void FrozenVariant::Deleter::operator()(Entry* tape) const noexcept {
+    if (tape != Impl::nullTape()) {
+        delete[] tape;
+    }
+}
+
+FrozenVariant::FrozenVariant() noexcept
+        : tape_(Impl::nullTape())
+        , entry_count_(1)
+        , pool_size_(0) {
+}
+
+FrozenVariant::FrozenVariant(Variant const& var) {
+    Impl::Builder builder;
+    builder.build(var);
+    entry_count_ = checkedOffset(builder.tape.size());
+    pool_size_ = checkedOffset(builder.pool.size());
+    tape_.reset(new Entry[entry_count_ + Impl::poolEntries(pool_size_)]);
+    std::copy(builder.tape.begin(), builder.tape.end(), tape_.get());
+    std::memcpy(tape_.get() + entry_count_, builder.pool.data(), pool_size_);
+}
+
+FrozenVariant::~FrozenVariant() noexcept = default;
+
+FrozenVariant::FrozenVariant(FrozenVariant const& rhs)
+        : tape_(new Entry[rhs.entry_count_ + Impl::poolEntries(rhs.pool_size_)])
+        , entry_count_(rhs.entry_count_)
+        , pool_size_(rhs.pool_size_) {
+    std::memcpy(tape_.get(), rhs.tape_.get(), byteSize());
+}
+
+FrozenVariant& FrozenVariant::operator=(FrozenVariant const& rhs) {
+    FrozenVariant tmp(rhs);
+    return *this = std::move(tmp);
+}
+
+FrozenVariant::FrozenVariant(FrozenVariant&& rhs) noexcept
+        : tape_(std::move(rhs.tape_))
+        , entry_count_(rhs.entry_count_)
+        , pool_size_(rhs.pool_size_) {
+    Impl::reset(rhs);
+}
+
+FrozenVariant& FrozenVariant::operator=(FrozenVariant&& rhs) noexcept {
+    if (this != &rhs) {
+        tape_ = std::move(rhs.tape_);
+        entry_count_ = rhs.entry_count_;
+        pool_size_ = rhs.pool_size_;
+        Impl::reset(rhs);
+    }
+    return *this;
+}
+
+FrozenVariant::Node FrozenVariant::root() const noexcept {
+    return {this, 0};
+}
+
+Variant FrozenVariant::thaw() const {
+    return root().thaw();
+}
+
+std::size_t FrozenVariant::byteSize() const noexcept {
+    return entry_count_ * sizeof(Entry) + pool_size_;
+}
+
+bool FrozenVariant::operator==(FrozenVariant const& rhs) const {
+    return Impl::equal(root(), rhs.root());
+}
+
+bool FrozenVariant::operator!=(FrozenVariant const& rhs) const {
+    return !(*this == rhs);
+}
+
+FrozenVariant Variant::freeze() const {
+    return FrozenVariant(*this);
+}
+
+FrozenVariant::Entry const& FrozenVariant::Node::entry() const noexcept {
+    return owner_->tape_[index_];
+}
+
+Variant::TypeTag FrozenVariant::Node::type() const noexcept {
+    return entry().tag;
+}
+
+Variant FrozenVariant::Node::scalar() const {
+    auto const& e = entry();
+    switch (e.tag) {
+    case TypeTag::null:
+        return Variant();
+    case TypeTag::boolean:
+        return Variant(e.value.bool_);
+    case TypeTag::char_:
+        return Variant(e.value.char_);
+    case TypeTag::int8:
+        return Variant(e.value.int8);
+    case TypeTag::uint8:
+        return Variant(e.value.uint8);
+    case TypeTag::int16:
+        return Variant(e.value.int16);
+    case TypeTag::uint16:
+        return Variant(e.value.uint16);
+    case TypeTag::int32:
+        return Variant(e.value.int32);
+    case TypeTag::uint32:
+        return Variant(e.value.uint32);
+    case TypeTag::int64:
+        return Variant(e.value.int64);
+    case TypeTag::uint64:
+        return Variant(e.value.uint64);
+    case TypeTag::double_:
+        return Variant(e.value.double_);
+    case TypeTag::raw_number: {
+        auto const s = Impl::str(*owner_, e);
+        return Variant(RawNumber(std::string(s.data(), s.size()), RawNumber::Validated{}));
+    }
+    default:
+        break;
+    }
+    throw std::logic_error("FrozenVariant: not a scalar");
+}
+
+#define FROZEN_GET(T, method)                                                            \
+    T FrozenVariant::Node::method() const {                                              \
+        auto const tag = type();                                                         \
+        if (!isScalar() || tag == TypeTag::string || tag == TypeTag::raw_json) {         \
+            throwBadAccess<T>(tag);                                                      \
+        }                                                                                \
+        return scalar().method();                                                        \
+    }
+
+FROZEN_GET(bool, boolean)
+FROZEN_GET(char, character)
+FROZEN_GET(int8_t, int8)
+FROZEN_GET(uint8_t, uint8)
+FROZEN_GET(int16_t, int16)
+FROZEN_GET(uint16_t, uint16)
+FROZEN_GET(int32_t, int32)
+FROZEN_GET(uint32_t, uint32)
+FROZEN_GET(int64_t, int64)
+FROZEN_GET(uint64_t, uint64)
+FROZEN_GET(double, floating)
+
+#undef FROZEN_GET
+
+std::string_view FrozenVariant::Node::str() const {
+    auto const& e = entry();
+    switch (e.tag) {
+    case TypeTag::string:
+        return Impl::str(*owner_, e);
+    case TypeTag::vec:
+    case TypeTag::map:
+    case TypeTag::raw_json:
+        throwBadAccess<std::string>(e.tag);
+    default:
+        scalar().str();
+    }
+    throw std::logic_error("FrozenVariant: unreachable");
+}
+
+FrozenVariant::Vec FrozenVariant::Node::vec() const {
+    auto const tag = type();
+    switch (tag) {
+    case TypeTag::vec:
+        return Vec(*this);
+    case TypeTag::string:
+    case TypeTag::map:
+    case TypeTag::raw_json:
+        throwBadAccess<Variant::Vec>(tag);
+    default:
+        scalar().vec();
+    }
+    throw std::logic_error("FrozenVariant: unreachable");
+}
+
+FrozenVariant::Map FrozenVariant::Node::map() const {
+    auto const tag = type();
+    switch (tag) {
+    case TypeTag::map:
+        return Map(*this);
+    case TypeTag::string:
+    case TypeTag::vec:
+    case TypeTag::raw_json:
+        throwBadAccess<Variant::Map>(tag);
+    default:
+        scalar().map();
+    }
+    throw std::logic_error("FrozenVariant: unreachable");
+}
+
+RawJson FrozenVariant::Node::raw() const {
+    auto const& e = entry();
+    switch (e.tag) {
+    case TypeTag::raw_json: {
+        auto const s = Impl::str(*owner_, e);
+        return RawJson(std::string(s.data(), s.size()), RawJson::Validated{});
+    }
+    case TypeTag::string:
+    case TypeTag::vec:
+    case TypeTag::map:
+        throwBadAccess<RawJson>(e.tag);
+    default:
+        scalar().raw();
+    }
+    throw std::logic_error("FrozenVariant: unreachable");
+}
+
+Variant FrozenVariant::Node::thaw() const {
+    return Impl::thaw(*this);
+}
+
+std::size_t FrozenVariant::Vec::size() const noexcept {
+    return node_.entry().link;
+}
+
+FrozenVariant::Node FrozenVariant::Vec::operator[](std::size_t i) const noexcept {
+    auto const& slot = node_.owner_->tape_[node_.index_ + 1 + i];
+    return {node_.owner_, slot.link};
+}
+
+FrozenVariant::Node FrozenVariant::Vec::at(std::size_t i) const {
+    if (i >= size()) {
+        throw std::out_of_range("FrozenVariant::Vec::at");
+    }
+    return (*this)[i];
+}
+
+std::size_t FrozenVariant::Map::size() const noexcept {
+    return node_.entry().link;
+}
+
+FrozenVariant::Map::value_type FrozenVariant::Map::member(uint32_t i) const noexcept {
+    auto const& slot = node_.owner_->tape_[node_.index_ + 1 + i];
+    return {Impl::str(*node_.owner_, slot), Node(node_.owner_, slot.link)};
+}
+
+std::optional<FrozenVariant::Node> FrozenVariant::Map::find(std::string_view key) const
+        noexcept {
+    auto const owner = node_.owner_;
+    auto const first = owner->tape_.get() + node_.index_ + 1;
+    auto const last = first + size();
+    auto const it = std::lower_bound(first, last, key, [owner](Entry const& e, auto key) {
+        return Impl::str(*owner, e) < key;
+    });
+    if (it == last || Impl::str(*owner, *it) != key) {
+        return std::nullopt;
+    }
+    return Node(owner, it->link);
+}
+
+FrozenVariant::Node FrozenVariant::Map::at(std::string_view key) const {
+    if (auto const x = find(key)) {
+        return *x;
+    }
+    throw std::out_of_range("FrozenVariant::Map::at");
+}
+
+} // namespace yenxo
@@ -0,0 +1,134 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/hash.hpp>
+#include <yenxo/json_parse_cache.hpp>
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace yenxo {
+
+struct JsonParseCache::Impl {
+    struct Entry {
+        std::string json;
+        std::shared_ptr<Variant const> var;
+    };
+
+    struct BytesHash {
+        std::size_t operator()(std::string_view x) const noexcept {
+            return hashBytes(x.data(), x.size());
+        }
+    };
+
+    Impl(Capacity const& capacity, Variant::NumberParsing numbers)
+            : capacity(capacity)
+            , numbers(numbers) {
+    }
+
+    /// Find `json`, marking it as the most recently used
+    std::shared_ptr<Variant const> find(std::string_view json) {
+        auto const it = index.find(json);
+        if (it == index.end()) {
+            return nullptr;
+        }
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second->var;
+    }
+
+    void insert(std::string json, std::shared_ptr<Variant const> var) {
+        if (index.count(json)) {
+            // parsed by another thread meanwhile
+            return;
+        }
+        while (!entries.empty()
+               && (entries.size() >= capacity.entries
+                   || bytes + json.size() > capacity.bytes)) {
+            auto const& last = entries.back();
+            bytes -= last.json.size();
+            index.erase(last.json);
+            entries.pop_back();
+        }
+        bytes += json.size();
+        entries.push_front(Entry{std::move(json), std::move(var)});
+        index.emplace(entries.front().json, entries.begin());
+    }
+
+    Capacity const capacity;
+    Variant::NumberParsing const numbers;
+    mutable std::mutex mutex;
+    // most recently used first
+    std::list<Entry> entries;
+    // the keys view the inputs stored in `entries`
+    std::unordered_map<std::string_view, std::list<Entry>::iterator, BytesHash> index;
+    std::size_t bytes{0};
+};
+
+JsonParseCache::JsonParseCache()
+        : JsonParseCache(Capacity{}) {
+}
+
+JsonParseCache::JsonParseCache(Capacity const& capacity, Variant::NumberParsing numbers)
+        : impl_(std::make_unique<Impl>(capacity, numbers)) {
+}
+
+JsonParseCache::~JsonParseCache() noexcept = default;
+
+std::shared_ptr<Variant const> JsonParseCache::parse(std::string_view json) {
+    {
+        std::lock_guard const lock(impl_->mutex);
+        if (auto ret = impl_->find(json)) {
+            return ret;
+        }
+    }
+
+    std::string text(json);
+    auto ret = std::make_shared<Variant const>(Variant::fromJson(text, impl_->numbers));
+    if (text.size() <= impl_->capacity.bytes && impl_->capacity.entries != 0) {
+        std::lock_guard const lock(impl_->mutex);
+        impl_->insert(std::move(text), ret);
+    }
+    return ret;
+}
+
+std::size_t JsonParseCache::size() const {
+    std::lock_guard const lock(impl_->mutex);
+    return impl_->entries.size();
+}
+
+std::size_t JsonParseCache::byteSize() const {
+    std::lock_guard const lock(impl_->mutex);
+    return impl_->bytes;
+}
+
+void JsonParseCache::clear() {
+    std::lock_guard const lock(impl_->mutex);
+    impl_->index.clear();
+    impl_->entries.clear();
+    impl_->bytes = 0;
+}
+
+} // namespace yenxo
@@ -0,0 +1,455 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/hash.hpp>
+#include <yenxo/json_patch.hpp>
+
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace yenxo {
+namespace {
+
+using TypeTag = Variant::TypeTag;
+
+constexpr detail::DecoderKey op_key("op");
+constexpr detail::DecoderKey path_key("path");
+constexpr detail::DecoderKey from_key("from");
+constexpr detail::DecoderKey value_key("value");
+
+/// Append the JSON pointer token of `key` to `path`
+void appendToken(std::string& path, std::string_view key) {
+    path += '/';
+    for (auto const c : key) {
+        switch (c) {
+        case '~':
+            path += "~0";
+            break;
+        case '/':
+            path += "~1";
+            break;
+        default:
+            path += c;
+        }
+    }
+}
+
+void appendToken(std::string& path, std::size_t i) {
+    path += '/';
+    path += std::to_string(i);
+}
+
+class Differ {
+public:
+    explicit Differ(Variant const& from, Variant const& to) {
+        hashTree(from);
+        hashTree(to);
+    }
+
+    void diff(Variant const& from, Variant const& to) {
+        if (same(from, to)) {
+            return;
+        }
+        if (from.type() == TypeTag::map && to.type() == TypeTag::map) {
+            diffMaps(from.map(), to.map());
+        } else if (from.type() == TypeTag::vec && to.type() == TypeTag::vec) {
+            diffVecs(from.vec(), to.vec());
+        } else {
+            push("replace", &to);
+        }
+    }
+
+    Variant::Vec patch;
+
+private:
+    /// Hash of `x` consistent with `operator==`, memoized for the containers
+    std::size_t hashTree(Variant const& x) {
+        std::size_t ret = 0;
+        switch (x.type()) {
+        case TypeTag::vec:
+            ret = hashCombine(static_cast<std::size_t>(TypeTag::vec), x.vec().size());
+            for (auto const& e : x.vec()) {
+                ret = hashCombine(ret, hashTree(e));
+            }
+            break;
+        case TypeTag::map:
+            for (auto const& [key, value] : x.map()) {
+                ret += hashMix(hashCombine(hashOf(key), hashTree(value)));
+            }
+            ret = hashCombine(static_cast<std::size_t>(TypeTag::map), ret);
+            break;
+        default:
+            return hashValue(x);
+        }
+        hashes_.emplace(&x, ret);
+        return ret;
+    }
+
+    /// Equal subtrees, a hash mismatch decides without traversing
+    ///
+    /// Matching hashes are confirmed by `operator==`: a collision taken as equality would
+    /// silently drop operations from the patch. Only equal subtrees, short of a
+    /// collision, get traversed, and the diff stops at them, so each node is compared
+    /// at most once.
+    bool same(Variant const& from, Variant const& to) const {
+        if (from.type() != to.type()) {
+            return false;
+        }
+        if (from.isScalar()) {
+            return from == to;
+        }
+        return hashes_.at(&from) == hashes_.at(&to) && from == to;
+    }
+
+    void diffMaps(Variant::Map const& from, Variant::Map const& to) {
+        // sorted keys make the patch deterministic
+        std::vector<std::string const*> keys;
+        keys.reserve(from.size() + to.size());
+        for (auto const& [key, value] : from) {
+            keys.push_back(&key);
+        }
+        for (auto const& [key, value] : to) {
+            if (from.find(key) == from.end()) {
+                keys.push_back(&key);
+            }
+        }
+        std::sort(keys.begin(), keys.end(), [](auto lhs, auto rhs) {
+            return *lhs < *rhs;
+        });
+
+        auto const size = path_.size();
+        for (auto const key : keys) {
+            appendToken(path_, *key);
+            auto const f = from.find(*key);
+            auto const t = to.find(*key);
+            if (t == to.end()) {
+                push("remove", nullptr);
+            } else if (f == from.end()) {
+                push("add", &t->second);
+            } else {
+                diff(f->second, t->second);
+            }
+            path_.resize(size);
+        }
+    }
+
+    void diffVecs(Variant::Vec const& from, Variant::Vec const& to) {
+        std::size_t prefix = 0;
+        while (prefix < from.size() && prefix < to.size()
+               && same(from[prefix], to[prefix])) {
+            ++prefix;
+        }
+        std::size_t suffix = 0;
+        while (suffix < from.size() - prefix && suffix < to.size() - prefix
+               && same(from[from.size() - 1 - suffix], to[to.size() - 1 - suffix])) {
+            ++suffix;
+        }
+        auto const from_end = from.size() - suffix;
+        auto const to_end = to.size() - suffix;
+        auto const common = std::min(from_end, to_end);
+
+        auto const size = path_.size();
+        for (auto i = prefix; i < common; ++i) {
+            appendToken(path_, i);
+            diff(from[i], to[i]);
+            path_.resize(size);
+        }
+        // from the back, so that the indices stay valid
+        for (auto i = from_end; i-- > common;) {
+            appendToken(path_, i);
+            push("remove", nullptr);
+            path_.resize(size);
+        }
+        for (auto i = common; i < to_end; ++i) {
+            appendToken(path_, i);
+            push("add", &to[i]);
+            path_.resize(size);
+        }
+    }
+
+    void push(char const* op, Variant const* value) {
+        Variant::Map x;
+        x.emplace("op", Variant(op));
+        x.emplace("path", Variant(path_));
+        if (value) {
+            x.emplace("value", *value);
+        }
+        patch.emplace_back(std::move(x));
+    }
+
+    std::unordered_map<Variant const*, std::size_t> hashes_;
+    std::string path_;
+};
+
+/// Applies the operations of a patch, moving its values out if `moving`
+template <bool moving>
+class Patcher {
+public:
+    using Patch = std::conditional_t<moving, Variant&, Variant const&>;
+
+    explicit Patcher(Variant& root) noexcept
+            : root_(root) {
+    }
+
+    void apply(Patch patch) {
+        if (patch.type() != TypeTag::vec) {
+            throw JsonPatchError("the patch is not an array", 0);
+        }
+        auto& ops = vec(patch);
+        for (std::size_t i = 0; i < ops.size(); ++i) {
+            index_ = i;
+            operation(ops[i]);
+        }
+    }
+
+private:
+    static auto& vec(Patch x) {
+        if constexpr (moving) {
+            return x.modifyVec();
+        } else {
+            return x.vec();
+        }
+    }
+
+    static auto& map(Patch x) {
+        if constexpr (moving) {
+            return x.modifyMap();
+        } else {
+            return x.map();
+        }
+    }
+
+    [[noreturn]] void fail(std::string const& error) const {
+        throw JsonPatchError(error, index_);
+    }
+
+    std::string_view member(Variant::Map const& op, detail::DecoderKey key) const {
+        auto const it = findKey(op, key);
+        if (it == op.end() || it->second.type() != TypeTag::string) {
+            fail("'" + std::string(detail::keyView(key))
+                 + "' is missing or not a string");
+        }
+        return it->second.str();
+    }
+
+    template <class Map>
+    auto& value(Map& op) const {
+        auto const it = findKey(op, value_key);
+        if (it == op.end()) {
+            fail("'value' is missing");
+        }
+        return it->second;
+    }
+
+    /// The value of `op`, moved out if `moving`
+    template <class Map>
+    Variant take(Map& op) const {
+        if constexpr (moving) {
+            return std::move(value(op));
+        } else {
+            return value(op);
+        }
+    }
+
+    void operation(Patch x) {
+        if (x.type() != TypeTag::map) {
+            fail("the operation is not an object");
+        }
+        auto& op = map(x);
+        auto const name = member(op, op_key);
+        auto const path = member(op, path_key);
+        if (name == "add") {
+            add(path, take(op));
+        } else if (name == "remove") {
+            remove(path);
+        } else if (name == "replace") {
+            at(path) = take(op);
+        } else if (name == "move") {
+            auto const from = member(op, from_key);
+            if (from == path) {
+                at(from);
+            } else if (path.size() > from.size() && path.substr(0, from.size()) == from
+                       && path[from.size()] == '/') {
+                fail("'" + std::string(from) + "' is moved into itself");
+            } else {
+                add(path, remove(from));
+            }
+        } else if (name == "copy") {
+            add(path, Variant(at(member(op, from_key))));
+        } else if (name == "test") {
+            if (at(path) != value(op)) {
+                fail("test of '" + std::string(path) + "' failed");
+            }
+        } else {
+            fail("'" + std::string(name) + "' is not an operation");
+        }
+    }
+
+    /// Split the last token off `path`
+    /// \return the parent container and the unescaped token
+    std::pair<Variant*, std::string> parent(std::string_view path) {
+        auto const slash = path.rfind('/');
+        if (slash == std::string_view::npos) {
+            fail("'" + std::string(path) + "' is not a JSON pointer");
+        }
+        auto& container = at(path.substr(0, slash));
+        return {&container, unescape(path.substr(slash + 1))};
+    }
+
+    std::string unescape(std::string_view token) const {
+        std::string ret;
+        ret.reserve(token.size());
+        for (std::size_t i = 0; i < token.size(); ++i) {
+            if (token[i] != '~') {
+                ret += token[i];
+                continue;
+            }
+            auto const next = i + 1 < token.size() ? token[++i] : '\0';
+            if (next != '0' && next != '1') {
+                fail("'" + std::string(token) + "' is not a valid token");
+            }
+            ret += next == '0' ? '~' : '/';
+        }
+        return ret;
+    }
+
+    /// Index of `token` in `vec`, `-` stands for `vec.size()` if `past_end`
+    std::size_t index(Variant::Vec const& vec,
+                      std::string_view token,
+                      bool past_end) const {
+        if (past_end && token == "-") {
+            return vec.size();
+        }
+        auto const end = vec.size() + (past_end ? 1 : 0);
+        std::size_t ret = 0;
+        // no leading zeros; the length check rules out an overflow
+        bool valid = !token.empty() && token.size() < 19
+                  && (token == "0" || token[0] != '0');
+        for (auto const c : token) {
+            valid = valid && c >= '0' && c <= '9';
+            ret = ret * 10 + static_cast<std::size_t>(c - '0');
+        }
+        if (!valid || ret >= end) {
+            fail("'" + std::string(token) + "' is not an index in range");
+        }
+        return ret;
+    }
+
+    Variant& at(std::string_view path) {
+        if (path.empty()) {
+            return root_;
+        }
+        auto [container, token] = parent(path);
+        switch (container->type()) {
+        case TypeTag::map: {
+            auto& map = container->modifyMap();
+            auto const it = map.find(token);
+            if (it == map.end()) {
+                fail("'" + std::string(path) + "' does not exist");
+            }
+            return it->second;
+        }
+        case TypeTag::vec: {
+            auto& vec = container->modifyVec();
+            return vec[index(vec, token, false)];
+        }
+        default:
+            fail("'" + std::string(path) + "' does not exist");
+        }
+    }
+
+    void add(std::string_view path, Variant value) {
+        if (path.empty()) {
+            root_ = std::move(value);
+            return;
+        }
+        auto [container, token] = parent(path);
+        switch (container->type()) {
+        case TypeTag::map:
+            container->modifyMap().insert_or_assign(std::move(token), std::move(value));
+            break;
+        case TypeTag::vec: {
+            auto& vec = container->modifyVec();
+            auto const i = index(vec, token, true);
+            vec.insert(vec.begin() + static_cast<std::ptrdiff_t>(i), std::move(value));
+            break;
+        }
+        default:
+            fail("the parent of '" + std::string(path) + "' is not a container");
+        }
+    }
+
+    Variant remove(std::string_view path) {
+        if (path.empty()) {
+            return std::move(root_);
+        }
+        auto [container, token] = parent(path);
+        switch (container->type()) {
+        case TypeTag::map: {
+            auto& map = container->modifyMap();
+            auto const it = map.find(token);
+            if (it == map.end()) {
+                fail("'" + std::string(path) + "' does not exist");
+            }
+            auto ret = std::move(it->second);
+            map.erase(it);
+            return ret;
+        }
+        case TypeTag::vec: {
+            auto& vec = container->modifyVec();
+            auto const it = vec.begin()
+                          + static_cast<std::ptrdiff_t>(index(vec, token, false));
+            auto ret = std::move(*it);
+            vec.erase(it);
+            return ret;
+        }
+        default:
+            fail("'" + std::string(path) + "' does not exist");
+        }
+    }
+
+    Variant& root_;
+    std::size_t index_{0};
+};
+
+} // namespace
+
+Variant diff(Variant const& from, Variant const& to) {
+    Differ differ(from, to);
+    differ.diff(from, to);
+    return Variant(std::move(differ.patch));
+}
+
+void apply(Variant& target, Variant const& patch) {
+    Patcher<false>(target).apply(patch);
+}
+
+void apply(Variant& target, Variant&& patch) {
+    Patcher<true>(target).apply(patch);
+}
+
+} // namespace yenxo
@@ -0,0 +1,517 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/lazy_variant.hpp>
+
+#include "from_json.hpp"
+
+#include <rapidjson/error/en.h>
+#include <rapidjson/reader.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace yenxo {
+
+/// Index entry
+///
+/// Entries are laid out in document order; an object is followed by its keys, each one
+/// followed by the value.
+struct LazyVariant::Entry {
+    enum Flags : uint8_t { escaped = 1, shadowed = 2 };
+
+    Variant::TypeTag tag;
+    uint8_t flags;
+    /// Containers: element count without shadowed members; keys: hash
+    uint32_t link;
+    /// Index past the subtree
+    uint32_t next;
+    union {
+        bool bool_;
+        int32_t int32;
+        uint32_t uint32;
+        int64_t int64;
+        uint64_t uint64;
+        double double_;
+        /// Source range of strings, keys and containers
+        struct {
+            uint32_t begin;
+            uint32_t end;
+        } raw;
+    } value;
+};
+
+namespace {
+
+using TypeTag = Variant::TypeTag;
+
+uint32_t hash(std::string_view x) noexcept {
+    uint32_t h = 2166136261u;
+    for (auto c : x) {
+        h = (h ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return h;
+}
+
+struct StringCapture : rapidjson::BaseReaderHandler<rapidjson::UTF8<>, StringCapture> {
+    bool String(char const* str, rapidjson::SizeType length, bool) {
+        value.assign(str, length);
+        return true;
+    }
+
+    std::string value;
+};
+
+} // namespace
+
+struct LazyVariant::Impl {
+    template <class Handler>
+    static void parse(char const* json, Handler& handler) {
+        rapidjson::Reader reader;
+        rapidjson::StringStream ss(json);
+        reader.Parse<rapidjson::kParseStopWhenDoneFlag>(ss, handler);
+        assert(!reader.HasParseError());
+    }
+
+    static std::string unescape(char const* json) {
+        StringCapture handler;
+        parse(json, handler);
+        return std::move(handler.value);
+    }
+
+    static std::string_view key(LazyVariant const& doc, uint32_t index) {
+        auto const& e = doc.index_[index];
+        if (e.flags & Entry::escaped) {
+            return Node(&doc, index).str();
+        }
+        return {doc.json_.data() + e.value.raw.begin + 1,
+                e.value.raw.end - e.value.raw.begin - 2};
+    }
+
+    /// SAX handler recording the index
+    struct Indexer : rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Indexer> {
+        Indexer(LazyVariant& doc, rapidjson::StringStream& ss)
+                : doc(doc)
+                , ss(ss) {
+        }
+
+        uint32_t tell() const noexcept {
+            return static_cast<uint32_t>(ss.Tell());
+        }
+
+        /// Start of the value after the previous token
+        uint32_t begin() const noexcept {
+            auto p = last;
+            for (char c; (c = doc.json_[p]) == ' ' || c == '\t' || c == '\n' || c == '\r'
+                         || c == ',' || c == ':';) {
+                ++p;
+            }
+            return p;
+        }
+
+        Entry& push(TypeTag tag) {
+            Entry e{};
+            e.tag = tag;
+            e.next = static_cast<uint32_t>(doc.index_.size() + 1);
+            doc.index_.push_back(e);
+            last = tell();
+            return doc.index_.back();
+        }
+
+        bool Null() {
+            push(TypeTag::null);
+            return true;
+        }
+        bool Bool(bool b) {
+            push(TypeTag::boolean).value.bool_ = b;
+            return true;
+        }
+        bool Int(int32_t i) {
+            push(TypeTag::int32).value.int32 = i;
+            return true;
+        }
+        bool Uint(uint32_t u) {
+            push(TypeTag::uint32).value.uint32 = u;
+            return true;
+        }
+        bool Int64(int64_t i) {
+            push(TypeTag::int64).value.int64 = i;
+            return true;
+        }
+        bool Uint64(uint64_t u) {
+            push(TypeTag::uint64).value.uint64 = u;
+            return true;
+        }
+        bool Double(double d) {
+            push(TypeTag::double_).value.double_ = d;
+            return true;
+        }
+        bool String(char const*, rapidjson::SizeType length, bool) {
+            auto const b = begin();
+            auto& e = push(TypeTag::string);
+            e.value.raw = {b, last};
+            if (last - b - 2 != length) {
+                e.flags |= Entry::escaped;
+            }
+            return true;
+        }
+        bool Key(char const* str, rapidjson::SizeType length, bool copy) {
+            String(str, length, copy);
+            doc.index_.back().link = hash({str, length});
+            return true;
+        }
+        bool StartObject() {
+            return start(TypeTag::map);
+        }
+        bool EndObject(rapidjson::SizeType n) {
+            auto const i = end(n);
+            if (n > 1) {
+                shadow(i);
+            }
+            return true;
+        }
+        bool StartArray() {
+            return start(TypeTag::vec);
+        }
+        bool EndArray(rapidjson::SizeType n) {
+            end(n);
+            return true;
+        }
+
+        bool start(TypeTag tag) {
+            open.push_back(static_cast<uint32_t>(doc.index_.size()));
+            auto& e = push(tag);
+            e.value.raw.begin = last - 1;
+            return true;
+        }
+
+        uint32_t end(rapidjson::SizeType n) {
+            auto const i = open.back();
+            open.pop_back();
+            auto& e = doc.index_[i];
+            last = tell();
+            e.value.raw.end = last;
+            e.link = n;
+            e.next = static_cast<uint32_t>(doc.index_.size());
+            return i;
+        }
+
+        /// Mark all but the last occurrence of a repeated key
+        void shadow(uint32_t object) {
+            auto& index = doc.index_;
+            keys.clear();
+            for (auto k = object + 1; k != index[object].next; k = index[k + 1].next) {
+                keys.emplace_back(index[k].link, k);
+            }
+            std::sort(keys.begin(), keys.end());
+            uint32_t shadowed = 0;
+            for (std::size_t i = 0; i + 1 < keys.size(); ++i) {
+                for (auto j = i + 1; j < keys.size() && keys[j].first == keys[i].first; ++j) {
+                    if (key(keys[i].second) == key(keys[j].second)) {
+                        index[keys[i].second].flags |= Entry::shadowed;
+                        ++shadowed;
+                        break;
+                    }
+                }
+            }
+            index[object].link -= shadowed;
+        }
+
+        std::string key(uint32_t k) const {
+            auto const& e = doc.index_[k];
+            return unescape(doc.json_.c_str() + e.value.raw.begin);
+        }
+
+        LazyVariant& doc;
+        rapidjson::StringStream& ss;
+        std::vector<uint32_t> open;
+        std::vector<std::pair<uint32_t, uint32_t>> keys;
+        uint32_t last = 0;
+    };
+};
+
+LazyVariant::LazyVariant() noexcept = default;
+
+LazyVariant LazyVariant::fromJson(std::string json) {
+    if (json.size() >= std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("LazyVariant: the document is too big");
+    }
+    LazyVariant ret;
+    ret.json_ = std::move(json);
+    rapidjson::Reader reader;
+    rapidjson::StringStream ss(ret.json_.c_str());
+    Impl::Indexer handler(ret, ss);
+    reader.Parse(ss, handler);
+    if (reader.HasParseError()) {
+        throw std::runtime_error(rapidjson::GetParseError_En(reader.GetParseErrorCode()));
+    }
+    return ret;
+}
+
+LazyVariant::~LazyVariant() noexcept = default;
+
+LazyVariant::LazyVariant(LazyVariant const& rhs) = default;
+
+LazyVariant& LazyVariant::operator=(LazyVariant const& rhs) = default;
+
+LazyVariant::LazyVariant(LazyVariant&& rhs) noexcept = default;
+
+LazyVariant& LazyVariant::operator=(LazyVariant&& rhs) noexcept = default;
+
+LazyVariant::Node LazyVariant::root() const noexcept {
+    return {this, 0};
+}
+
+Variant const& LazyVariant::variant() const {
+    return root().variant();
+}
+
+std::string LazyVariant::toJson() const {
+    return variant().toJson();
+}
+
+std::string LazyVariant::toPrettyJson() const {
+    return variant().toPrettyJson();
+}
+
+LazyVariant::Entry const& LazyVariant::Node::entry() const noexcept {
+    return owner_->index_[index_];
+}
+
+Variant::TypeTag LazyVariant::Node::type() const noexcept {
+    return entry().tag;
+}
+
+/// The value itself for scalars, an empty value of the same type otherwise
+Variant LazyVariant::Node::scalar() const {
+    auto const& e = entry();
+    switch (e.tag) {
+    case TypeTag::boolean:
+        return Variant(e.value.bool_);
+    case TypeTag::int32:
+        return Variant(e.value.int32);
+    case TypeTag::uint32:
+        return Variant(e.value.uint32);
+    case TypeTag::int64:
+        return Variant(e.value.int64);
+    case TypeTag::uint64:
+        return Variant(e.value.uint64);
+    case TypeTag::double_:
+        return Variant(e.value.double_);
+    case TypeTag::string:
+        return Variant(std::string());
+    case TypeTag::vec:
+        return Variant(Variant::Vec());
+    case TypeTag::map:
+        return Variant(Variant::Map());
+    default:
+        return Variant();
+    }
+}
+
+bool LazyVariant::Node::boolean() const {
+    return scalar().boolean();
+}
+
+char LazyVariant::Node::character() const {
+    return scalar().character();
+}
+
+int8_t LazyVariant::Node::int8() const {
+    return scalar().int8();
+}
+
+uint8_t LazyVariant::Node::uint8() const {
+    return scalar().uint8();
+}
+
+int16_t LazyVariant::Node::int16() const {
+    return scalar().int16();
+}
+
+uint16_t LazyVariant::Node::uint16() const {
+    return scalar().uint16();
+}
+
+int32_t LazyVariant::Node::int32() const {
+    return scalar().int32();
+}
+
+uint32_t LazyVariant::Node::uint32() const {
+    return scalar().uint32();
+}
+
+int64_t LazyVariant::Node::int64() const {
+    return scalar().int64();
+}
+
+uint64_t LazyVariant::Node::uint64() const {
+    return scalar().uint64();
+}
+
+double LazyVariant::Node::floating() const {
+    return scalar().floating();
+}
+
+std::string const& LazyVariant::Node::str() const {
+    if (type() != TypeTag::string) {
+        scalar().str();
+    }
+    return variant().str();
+}
+
+LazyVariant::Vec LazyVariant::Node::vec() const {
+    if (type() != TypeTag::vec) {
+        scalar().vec();
+    }
+    return Vec(*this);
+}
+
+LazyVariant::Map LazyVariant::Node::map() const {
+    if (type() != TypeTag::map) {
+        scalar().map();
+    }
+    return Map(*this);
+}
+
+Variant const& LazyVariant::Node::variant() const {
+    auto& cache = owner_->cache_;
+    if (auto const it = cache.find(index_); it != cache.end()) {
+        return it->second;
+    }
+
+    auto const& e = entry();
+    auto const json = owner_->json_.c_str() + e.value.raw.begin;
+    Variant var;
+    switch (e.tag) {
+    case TypeTag::string:
+        var = Variant(Impl::unescape(json));
+        break;
+    case TypeTag::vec:
+    case TypeTag::map: {
+        detail::FromJson<rapidjson::UTF8<>> handler;
+        Impl::parse(json, handler);
+        var = std::move(handler).var;
+        break;
+    }
+    default:
+        var = scalar();
+        break;
+    }
+    return cache.emplace(index_, std::move(var)).first->second;
+}
+
+RawJson LazyVariant::Node::raw() const {
+    auto const& e = entry();
+    switch (e.tag) {
+    case TypeTag::string:
+    case TypeTag::vec:
+    case TypeTag::map:
+        return RawJson(owner_->json_.substr(e.value.raw.begin,
+                                            e.value.raw.end - e.value.raw.begin),
+                       RawJson::Validated{});
+    default:
+        return RawJson(scalar().toJson(), RawJson::Validated{});
+    }
+}
+
+std::size_t LazyVariant::Vec::size() const noexcept {
+    return node_.entry().link;
+}
+
+LazyVariant::Node LazyVariant::Vec::at(std::size_t i) const {
+    if (i >= size()) {
+        throw std::out_of_range("LazyVariant::Vec::at");
+    }
+    auto it = begin();
+    while (i--) {
+        ++it;
+    }
+    return *it;
+}
+
+LazyVariant::Vec::const_iterator LazyVariant::Vec::begin() const noexcept {
+    return const_iterator(Node(node_.owner_, node_.index_ + 1));
+}
+
+LazyVariant::Vec::const_iterator LazyVariant::Vec::end() const noexcept {
+    return const_iterator(Node(node_.owner_, node_.entry().next));
+}
+
+LazyVariant::Vec::const_iterator& LazyVariant::Vec::const_iterator::operator++() noexcept {
+    node_.index_ = node_.entry().next;
+    return *this;
+}
+
+LazyVariant::Map::const_iterator::const_iterator(Node key, uint32_t end) noexcept
+        : key_(key)
+        , end_(end) {
+    while (key_.index_ != end_ && (key_.entry().flags & Entry::shadowed)) {
+        key_.index_ = key_.owner_->index_[key_.index_ + 1].next;
+    }
+}
+
+LazyVariant::Map::value_type LazyVariant::Map::const_iterator::operator*() const {
+    return {Impl::key(*key_.owner_, key_.index_), Node(key_.owner_, key_.index_ + 1)};
+}
+
+LazyVariant::Map::const_iterator& LazyVariant::Map::const_iterator::operator++() noexcept {
+    *this = const_iterator(Node(key_.owner_, key_.owner_->index_[key_.index_ + 1].next),
+                           end_);
+    return *this;
+}
+
+std::size_t LazyVariant::Map::size() const noexcept {
+    return node_.entry().link;
+}
+
+std::optional<LazyVariant::Node> LazyVariant::Map::find(std::string_view key) const {
+    auto const& doc = *node_.owner_;
+    auto const h = hash(key);
+    for (auto k = node_.index_ + 1; k != node_.entry().next; k = doc.index_[k + 1].next) {
+        auto const& e = doc.index_[k];
+        if (e.link == h && !(e.flags & Entry::shadowed) && Impl::key(doc, k) == key) {
+            return Node(&doc, k + 1);
+        }
+    }
+    return std::nullopt;
+}
+
+LazyVariant::Node LazyVariant::Map::at(std::string_view key) const {
+    if (auto const x = find(key)) {
+        return *x;
+    }
+    throw std::out_of_range("LazyVariant::Map::at");
+}
+
+LazyVariant::Map::const_iterator LazyVariant::Map::begin() const noexcept {
+    return {Node(node_.owner_, node_.index_ + 1), node_.entry().next};
+}
+
+LazyVariant::Map::const_iterator LazyVariant::Map::end() const noexcept {
+    return {Node(node_.owner_, node_.entry().next), node_.entry().next};
+}
+
+} // namespace yenxo
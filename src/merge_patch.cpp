@@ -0,0 +1,120 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/merge_patch.hpp>
+
+#include <iterator>
+#include <utility>
+
+namespace yenxo {
+namespace {
+
+using TypeTag = Variant::TypeTag;
+
+/// Drop the null members of the maps in `x`, as a patch applied to nothing would
+void removeNulls(Variant& x) {
+    if (x.type() != TypeTag::map) {
+        return;
+    }
+    auto& map = x.modifyMap();
+    for (auto it = map.begin(); it != map.end();) {
+        if (it->second.null()) {
+            it = map.erase(it);
+        } else {
+            removeNulls(it->second);
+            ++it;
+        }
+    }
+}
+
+void mergeVecs(Variant::Vec& target, Variant::Vec& source, MergeOptions const& options) {
+    auto it = source.begin();
+    if (options.arrays == ArrayMerge::merge_elements) {
+        for (auto& x : target) {
+            if (it == source.end()) {
+                break;
+            }
+            merge(x, std::move(*it++), options);
+        }
+    }
+    target.insert(target.end(),
+                  std::make_move_iterator(it),
+                  std::make_move_iterator(source.end()));
+}
+
+void mergeMaps(Variant& target, Variant::Map& source, MergeOptions const& options) {
+    if (target.type() != TypeTag::map) {
+        target = Variant(Variant::Map());
+    }
+    auto& map = target.modifyMap();
+    for (auto it = source.begin(); it != source.end();) {
+        auto node = source.extract(it++);
+        auto& value = node.mapped();
+        if (options.null_removes && value.null()) {
+            map.erase(node.key());
+            continue;
+        }
+        if (auto const found = map.find(node.key()); found != map.end()) {
+            merge(found->second, std::move(value), options);
+            continue;
+        }
+        if (options.null_removes) {
+            removeNulls(value);
+        }
+        // the node moves over with its key and value
+        map.insert(std::move(node));
+    }
+}
+
+} // namespace
+
+void merge(Variant& target, Variant&& source, MergeOptions const& options) {
+    switch (source.type()) {
+    case TypeTag::map:
+        mergeMaps(target, source.modifyMap(), options);
+        break;
+    case TypeTag::vec:
+        if (options.arrays != ArrayMerge::replace && target.type() == TypeTag::vec) {
+            mergeVecs(target.modifyVec(), source.modifyVec(), options);
+            break;
+        }
+        [[fallthrough]];
+    default:
+        target = std::move(source);
+    }
+}
+
+void merge(Variant& target, Variant const& source, MergeOptions const& options) {
+    merge(target, Variant(source), options);
+}
+
+void mergePatch(Variant& target, Variant&& patch) {
+    merge(target, std::move(patch), MergeOptions{ArrayMerge::replace, true});
+}
+
+void mergePatch(Variant& target, Variant const& patch) {
+    merge(target, Variant(patch), MergeOptions{ArrayMerge::replace, true});
+}
+
+} // namespace yenxo
@@ -22,8 +22,10 @@
   SOFTWARE.
 */
 
+#include "query_string_builder.hpp"
+#include "query_string_scanner.hpp"
+
 #include <yenxo/query_string.hpp>
-#include <yenxo/string_conversion.hpp>
 #include <yenxo/variant.hpp>
 
 #include <boost/fusion/adapted/struct/define_struct_inline.hpp>
@@ -31,6 +33,10 @@
 #include <boost/spirit/include/phoenix.hpp>
 #include <boost/spirit/include/qi.hpp>
 
+#include <optional>
+#include <string_view>
+#include <vector>
+
 namespace qi = boost::spirit::qi;
 namespace phx = boost::phoenix;
 
@@ -56,41 +62,12 @@ int8_t byte(char digit1, char digit2) {
     return 16 * digit(digit1) + digit(digit2);
 }
 
-QueryStringError makeObjectPropertyCountError(uint8_t len) {
-    return QueryStringError("object property count limit exceed " + std::to_string(len));
-}
-
-QueryStringError makeObjectPropertyCountError(std::string const& key, uint8_t len) {
-    return QueryStringError("object property count exceed " + std::to_string(len)
-                            + " for " + key);
-}
-
-QueryStringError makeMixedTypesError(std::string const& key,
-                                     std::string const& expected_type,
-                                     std::string const& actual_type) {
-    return QueryStringError("mixed types for " + key + ": " + expected_type + " and "
-                            + actual_type);
-}
-
-QueryStringError makeArrayIndexError(std::string const& key, uint8_t len) {
-    return QueryStringError("array index out of range [0, " + std::to_string(len - 1)
-                            + "] for " + key);
-}
-
-QueryStringError makeArrayLengthError(std::string const& key, uint8_t len) {
-    return QueryStringError("array length exceed " + std::to_string(len) + " for " + key);
-}
-
-QueryStringError makeObjectDepthError(std::string const& key, uint8_t len) {
-    return QueryStringError("object depth limit exceed " + std::to_string(len) + " for "
-                            + key);
-}
-
 template <class Iterator>
 class Grammar : public qi::grammar<Iterator> {
 public:
-    Grammar()
-            : Grammar::base_type(query_string) {
+    explicit Grammar(detail::QueryStringBuilder& builder)
+            : Grammar::base_type(query_string)
+            , builder(builder) {
         using phx::at_c;
         using qi::alnum;
         using qi::char_;
@@ -167,10 +144,6 @@ public:
         return error_expectation_pos;
     }
 
-    VariantMap const& result() const noexcept {
-        return out;
-    }
-
 private:
     void saveError(boost::spirit::info const& info, Iterator begin, Iterator error_pos) {
         std::stringstream s;
@@ -180,106 +153,28 @@ private:
                 static_cast<size_t>(std::distance(begin, error_pos));
     }
 
-    void incDepth() {
-        if (++this->depth > object_depth_limit) {
-            throw makeObjectDepthError(this->param_name, object_depth_limit);
-        }
-    }
-
-    void paramName(std::string const& name) {
-        param = &out[name];
-        if (out.size() > object_property_count_limit) {
-            throw makeObjectPropertyCountError(object_property_count_limit);
-        }
-        this->param_key = name;
-        this->param_name = name;
-        this->depth = 0;
+    void paramName(std::string const& x) {
+        builder.paramName(x);
     }
 
     void indexOp(uint64_t i) {
-        if (i >= array_length_limit) {
-            throw makeArrayIndexError(this->param_key, array_length_limit);
-        }
-        switch (param->type()) {
-        case Variant::TypeTag::null:
-            *param = Variant(VariantVec());
-            break;
-        case Variant::TypeTag::vec:
-            break;
-        case Variant::TypeTag::map:
-            throw makeMixedTypesError(this->param_key, "vec", "map");
-            break;
-        default:
-            *param = Variant(VariantVec{std::move(*param)});
-            break;
-        }
-        auto& vec = param->modifyVec();
-        while (i >= vec.size()) {
-            vec.push_back(Variant());
-        }
-        param = &vec[i];
-        this->param_key += "[" + std::to_string(i) + "]";
-        incDepth();
+        builder.indexOp(i);
     }
 
-    void propertyOp(std::string const& key) {
-        switch (param->type()) {
-        case Variant::TypeTag::null:
-            *param = Variant(VariantMap());
-            break;
-        case Variant::TypeTag::map:
-            break;
-        default:
-            throw makeMixedTypesError(this->param_key, "map", toString(param->type()));
-        }
-        auto& map = param->modifyMap();
-        param = &map[key];
-        if (map.size() > object_property_count_limit) {
-            throw makeObjectPropertyCountError(param_key, object_property_count_limit);
-        }
-        this->param_key += "[" + key + "]";
-        incDepth();
+    void propertyOp(std::string const& x) {
+        builder.propertyOp(x);
     }
 
     void emptyIndexOp() {
-        switch (param->type()) {
-        case Variant::TypeTag::null:
-            *param = Variant(VariantVec());
-            break;
-        case Variant::TypeTag::vec:
-            break;
-        case Variant::TypeTag::map:
-            throw makeMixedTypesError(this->param_key, "vec", "map");
-        default:
-            *param = Variant(VariantVec{*param});
-        }
+        builder.emptyIndexOp();
     }
 
     void val(std::string const& x) {
-        valImpl(Variant(x));
+        builder.val(x);
     }
 
     void emptyVal() {
-        valImpl(Variant(""));
-    }
-
-    void valImpl(Variant x) {
-        switch (param->type()) {
-        case Variant::TypeTag::null:
-            *param = std::move(x);
-            break;
-        case Variant::TypeTag::vec:
-            param->modifyVec().push_back(std::move(x));
-            if (param->vec().size() > array_length_limit) {
-                throw makeArrayLengthError(this->param_key, array_length_limit);
-            }
-            break;
-        case Variant::TypeTag::map:
-            throw makeMixedTypesError(this->param_key, "map", "string");
-        default:
-            *param = Variant(VariantVec{std::move(*param), Variant(std::move(x))});
-            break;
-        }
+        builder.val({});
     }
 
 private:
@@ -290,7 +185,7 @@ private:
     qi::rule<Iterator, char()> open_bracket;
     qi::rule<Iterator, char()> close_bracket;
     qi::rule<Iterator, std::string()> property;
-    qi::rule<Iterator, uint16_t()> index;
+    qi::rule<Iterator, uint64_t()> index;
     qi::rule<Iterator> empty_index;
     qi::rule<Iterator, std::string()> name;
     qi::rule<Iterator> key;
@@ -305,16 +200,45 @@ private:
     size_t error_expectation_pos;
 
     // out
-    VariantMap out;
-    Variant* param{nullptr};
-    std::string param_name;
-    std::string param_key;
-    uint16_t depth;
-
-    // constraints
-    static constexpr uint8_t const array_length_limit{20};
-    static constexpr uint8_t const object_depth_limit{20};
-    static constexpr uint8_t const object_property_count_limit{20};
+    detail::QueryStringBuilder& builder;
+};
+
+// Builds the object from the parameters found by the scanner
+struct TreeHandler {
+    void paramName(std::string_view x) {
+        builder.paramName(x);
+    }
+    void indexOp(uint64_t i) {
+        builder.indexOp(i);
+    }
+    void propertyOp(std::string_view x) {
+        builder.propertyOp(x);
+    }
+    void emptyIndexOp() {
+        builder.emptyIndexOp();
+    }
+    void value(std::string_view, std::string_view x) {
+        builder.val(x);
+    }
+
+    detail::QueryStringBuilder& builder;
+};
+
+// Collects the decoded parameters found by the scanner
+struct FlatHandler {
+    void paramName(std::string_view) noexcept {
+    }
+    void indexOp(uint64_t) noexcept {
+    }
+    void propertyOp(std::string_view) noexcept {
+    }
+    void emptyIndexOp() noexcept {
+    }
+    void value(std::string_view key, std::string_view x) {
+        params.push_back({key, x});
+    }
+
+    std::vector<QueryStringParser::Param>& params;
 };
 
 } // namespace
@@ -336,16 +260,133 @@ std::string QueryStringError::prettyParseError() const {
 }
 
 Variant query_string(std::string const& str) {
-    Grammar<std::string::const_iterator> grammar;
-    auto const res = qi::parse(str.begin(), str.end(), grammar);
-    if (!res) {
+    return detail::threadQueryStringParser().parse(str);
+}
+
+namespace detail {
+
+QueryStringParser& threadQueryStringParser() {
+    thread_local QueryStringParser parser;
+    return parser;
+}
+
+struct SpiritQueryStringParser::Impl {
+    explicit Impl(QueryStringParser::Limits const& limits)
+            : builder(limits)
+            , grammar(builder) {
+    }
+
+    QueryStringBuilder builder;
+    Grammar<char const*> grammar;
+};
+
+SpiritQueryStringParser::SpiritQueryStringParser(QueryStringParser::Limits const& limits)
+        : impl_(std::make_unique<Impl>(limits)) {
+}
+
+SpiritQueryStringParser::~SpiritQueryStringParser() noexcept = default;
+
+void SpiritQueryStringParser::parse(std::string_view str,
+                                    Variant& out,
+                                    std::size_t offset) {
+    if (out.type() != Variant::TypeTag::map) {
+        out = Variant(VariantMap());
+    }
+    auto& grammar = impl_->grammar;
+    impl_->builder.reset(out.modifyMap());
+    if (!qi::parse(str.data(), str.data() + str.size(), grammar)) {
+        auto const pos = grammar.errorExpectationPos();
         throw QueryStringError("expecting " + grammar.errorExpectation() + " here: \""
-                                       + str.substr(grammar.errorExpectationPos()) + "\"",
-                               str,
+                                       + std::string(str.substr(pos)) + "\"",
+                               std::string(str),
                                grammar.errorExpectation(),
-                               grammar.errorExpectationPos());
+                               pos,
+                               offset);
+    }
+}
+
+} // namespace detail
+
+struct QueryStringParser::Impl {
+    explicit Impl(Limits const& limits)
+            : builder(limits) {
+    }
+
+    /// Room for the decoded `str`
+    char* buffer(std::string_view str) {
+        if (decoded.size() < str.size()) {
+            decoded.resize(str.size());
+        }
+        return decoded.data();
+    }
+
+    /// Describe the syntax error of `str`
+    [[noreturn]] void fail(std::string_view str) {
+        if (!spirit) {
+            spirit.emplace(builder.limits());
+        }
+        Variant out;
+        spirit->parse(str, out);
+        throw QueryStringError("malformed query string", std::string(str));
+    }
+
+    detail::QueryStringBuilder builder;
+    std::string decoded;
+    std::vector<Param> params;
+    // built on the first malformed input
+    std::optional<detail::SpiritQueryStringParser> spirit;
+};
+
+QueryStringParser::QueryStringParser()
+        : QueryStringParser(Limits{}) {
+}
+
+QueryStringParser::QueryStringParser(Limits const& limits)
+        : impl_(std::make_unique<Impl>(limits)) {
+}
+
+QueryStringParser::~QueryStringParser() noexcept = default;
+
+QueryStringParser::QueryStringParser(QueryStringParser&& rhs) noexcept = default;
+
+QueryStringParser& QueryStringParser::operator=(QueryStringParser&& rhs) noexcept =
+        default;
+
+QueryStringParser::Limits const& QueryStringParser::limits() const noexcept {
+    return impl_->builder.limits();
+}
+
+void QueryStringParser::parse(std::string_view str, Variant& out) {
+    if (out.type() != Variant::TypeTag::map) {
+        out = Variant(VariantMap());
+    }
+    impl_->builder.reset(out.modifyMap());
+    TreeHandler handler{impl_->builder};
+    if (!detail::scanQueryString(str, impl_->buffer(str), handler)) {
+        impl_->fail(str);
+    }
+}
+
+Variant QueryStringParser::parse(std::string_view str) {
+    Variant ret{VariantMap()};
+    parse(str, ret);
+    return ret;
+}
+
+std::vector<QueryStringParser::Param> const& QueryStringParser::scan(
+        std::string_view str) {
+    impl_->params.clear();
+    FlatHandler handler{impl_->params};
+    if (!detail::scanQueryString(str, impl_->buffer(str), handler)) {
+        impl_->fail(str);
+    }
+    return impl_->params;
+}
+
+void QueryStringParser::scan(std::string_view str, Handler& handler) {
+    if (!detail::scanQueryString(str, impl_->buffer(str), handler)) {
+        impl_->fail(str);
     }
-    return Variant(grammar.result());
 }
 
 } // namespace yenxo
@@ -0,0 +1,209 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <yenxo/query_string.hpp>
+#include <yenxo/string_conversion.hpp>
+#include <yenxo/variant.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace yenxo::detail {
+
+inline QueryStringError makeObjectPropertyCountError(std::size_t len) {
+    return QueryStringError("object property count limit exceed " + std::to_string(len));
+}
+
+inline QueryStringError makeObjectPropertyCountError(std::string const& key,
+                                                     std::size_t len) {
+    return QueryStringError("object property count exceed " + std::to_string(len)
+                            + " for " + key);
+}
+
+inline QueryStringError makeMixedTypesError(std::string const& key,
+                                            std::string const& expected_type,
+                                            std::string const& actual_type) {
+    return QueryStringError("mixed types for " + key + ": " + expected_type + " and "
+                            + actual_type);
+}
+
+inline QueryStringError makeArrayIndexError(std::string const& key, std::size_t len) {
+    return QueryStringError("array index out of range [0, " + std::to_string(len - 1)
+                            + "] for " + key);
+}
+
+inline QueryStringError makeArrayLengthError(std::string const& key, std::size_t len) {
+    return QueryStringError("array length exceed " + std::to_string(len) + " for " + key);
+}
+
+inline QueryStringError makeObjectDepthError(std::string const& key, std::size_t len) {
+    return QueryStringError("object depth limit exceed " + std::to_string(len) + " for "
+                            + key);
+}
+
+/// Builds the object of a query string from the parsed parameters
+///
+/// A parameter is reported as its name, the index and property operators of its key in
+/// order, an optional empty index operator and the value.
+class QueryStringBuilder {
+public:
+    explicit QueryStringBuilder(QueryStringParser::Limits const& limits) noexcept
+            : limits_(limits) {
+    }
+
+    QueryStringParser::Limits const& limits() const noexcept {
+        return limits_;
+    }
+
+    /// Start building into `x`
+    void reset(VariantMap& x) noexcept {
+        x.clear();
+        out_ = &x;
+        param_ = nullptr;
+    }
+
+    void paramName(std::string_view name) {
+        auto it = findKey(*out_, name);
+        if (it == out_->end()) {
+            it = out_->emplace(std::string(name), Variant()).first;
+        }
+        param_ = &it->second;
+        if (out_->size() > limits_.object_property_count) {
+            throw makeObjectPropertyCountError(limits_.object_property_count);
+        }
+        param_key_ = name;
+        param_name_ = name;
+        depth_ = 0;
+    }
+
+    void indexOp(uint64_t i) {
+        if (i >= limits_.array_length) {
+            throw makeArrayIndexError(param_key_, limits_.array_length);
+        }
+        switch (param_->type()) {
+        case Variant::TypeTag::null:
+            *param_ = Variant(VariantVec());
+            break;
+        case Variant::TypeTag::vec:
+            break;
+        case Variant::TypeTag::map:
+            throw makeMixedTypesError(param_key_, "vec", "map");
+            break;
+        default:
+            *param_ = Variant(VariantVec{std::move(*param_)});
+            break;
+        }
+        auto& vec = param_->modifyVec();
+        while (i >= vec.size()) {
+            vec.push_back(Variant());
+        }
+        param_ = &vec[i];
+        param_key_ += '[';
+        param_key_ += std::to_string(i);
+        param_key_ += ']';
+        incDepth();
+    }
+
+    void propertyOp(std::string_view key) {
+        switch (param_->type()) {
+        case Variant::TypeTag::null:
+            *param_ = Variant(VariantMap());
+            break;
+        case Variant::TypeTag::map:
+            break;
+        default:
+            throw makeMixedTypesError(param_key_, "map", toString(param_->type()));
+        }
+        auto& map = param_->modifyMap();
+        auto it = findKey(map, key);
+        if (it == map.end()) {
+            it = map.emplace(std::string(key), Variant()).first;
+        }
+        param_ = &it->second;
+        if (map.size() > limits_.object_property_count) {
+            throw makeObjectPropertyCountError(param_key_, limits_.object_property_count);
+        }
+        param_key_ += '[';
+        param_key_ += key;
+        param_key_ += ']';
+        incDepth();
+    }
+
+    void emptyIndexOp() {
+        switch (param_->type()) {
+        case Variant::TypeTag::null:
+            *param_ = Variant(VariantVec());
+            break;
+        case Variant::TypeTag::vec:
+            break;
+        case Variant::TypeTag::map:
+            throw makeMixedTypesError(param_key_, "vec", "map");
+        default:
+            *param_ = Variant(VariantVec{*param_});
+        }
+    }
+
+    void val(std::string_view x) {
+        valImpl(Variant(std::string(x)));
+    }
+
+private:
+    void incDepth() {
+        if (++depth_ > limits_.object_depth) {
+            throw makeObjectDepthError(param_name_, limits_.object_depth);
+        }
+    }
+
+    void valImpl(Variant x) {
+        switch (param_->type()) {
+        case Variant::TypeTag::null:
+            *param_ = std::move(x);
+            break;
+        case Variant::TypeTag::vec:
+            param_->modifyVec().push_back(std::move(x));
+            if (param_->vec().size() > limits_.array_length) {
+                throw makeArrayLengthError(param_key_, limits_.array_length);
+            }
+            break;
+        case Variant::TypeTag::map:
+            throw makeMixedTypesError(param_key_, "map", "string");
+        default:
+            *param_ = Variant(VariantVec{std::move(*param_), Variant(std::move(x))});
+            break;
+        }
+    }
+
+    QueryStringParser::Limits limits_;
+    VariantMap* out_{nullptr};
+    Variant* param_{nullptr};
+    std::string param_name_;
+    std::string param_key_;
+    std::size_t depth_{0};
+};
+
+} // namespace yenxo::detail
@@ -0,0 +1,351 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+#include <yenxo/enum_traits.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Hand-written scanner of the query string grammar of query_string.cpp
+//
+// The scanner accepts exactly what the Spirit grammar accepts, including stopping at the
+// first parameter not followed by `&`. It does not describe syntax errors, the caller
+// reruns the grammar for that.
+
+namespace yenxo::detail {
+
+enum class QueryChar : uint8_t { other, pchar, pct, open, close, amp, eq };
+
+/// Class of every byte, `pchar` stands for the literal `pchar`s of RFC 3986
+constexpr std::array<QueryChar, 256> query_chars = [] {
+    std::array<QueryChar, 256> ret{};
+    for (int c = '0'; c <= '9'; ++c) {
+        ret[c] = QueryChar::pchar;
+    }
+    for (int c = 'a'; c <= 'z'; ++c) {
+        ret[c] = QueryChar::pchar;
+        ret[c - 'a' + 'A'] = QueryChar::pchar;
+    }
+    for (char c : std::string_view("-._~!$'()*+,;:@")) {
+        ret[static_cast<unsigned char>(c)] = QueryChar::pchar;
+    }
+    ret['%'] = QueryChar::pct;
+    ret['['] = QueryChar::open;
+    ret[']'] = QueryChar::close;
+    ret['&'] = QueryChar::amp;
+    ret['='] = QueryChar::eq;
+    return ret;
+}();
+
+/// Value of every hex digit, -1 for the other bytes
+constexpr std::array<int8_t, 256> hex_digits = [] {
+    std::array<int8_t, 256> ret{};
+    for (auto& x : ret) {
+        x = -1;
+    }
+    for (int c = 0; c < 10; ++c) {
+        ret['0' + c] = static_cast<int8_t>(c);
+    }
+    for (int c = 0; c < 6; ++c) {
+        ret['a' + c] = static_cast<int8_t>(10 + c);
+        ret['A' + c] = static_cast<int8_t>(10 + c);
+    }
+    return ret;
+}();
+
+inline QueryChar queryChar(char c) noexcept {
+    return query_chars[static_cast<unsigned char>(c)];
+}
+
+inline bool isAlnum(char c) noexcept {
+    return (c >= '0' && c <= '9') || ((c | 0x20) >= 'a' && (c | 0x20) <= 'z');
+}
+
+/// End of the run of ASCII letters and digits starting at `p`
+inline char const* skipAlnum(char const* p, char const* end) noexcept {
+#if defined(__SSE2__)
+    auto const digit_lo = _mm_set1_epi8('0' - 1);
+    auto const digit_hi = _mm_set1_epi8('9' + 1);
+    auto const alpha_lo = _mm_set1_epi8('a' - 1);
+    auto const alpha_hi = _mm_set1_epi8('z' + 1);
+    auto const lower = _mm_set1_epi8(0x20);
+    for (; end - p >= 16; p += 16) {
+        auto const x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+        auto const l = _mm_or_si128(x, lower);
+        auto const digit =
+                _mm_and_si128(_mm_cmpgt_epi8(x, digit_lo), _mm_cmplt_epi8(x, digit_hi));
+        auto const alpha =
+                _mm_and_si128(_mm_cmpgt_epi8(l, alpha_lo), _mm_cmplt_epi8(l, alpha_hi));
+        auto const mask =
+                static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(digit, alpha)));
+        if (mask != 0xFFFF) {
+            return p + lowestBit(~mask);
+        }
+    }
+#endif
+    while (p != end && isAlnum(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+template <class Handler>
+class QueryStringScanner {
+public:
+    /// `out` has room for `in.size()` chars, `plus_as_space` decodes `+` as space
+    QueryStringScanner(std::string_view in,
+                       char* out,
+                       Handler& handler,
+                       bool plus_as_space = false) noexcept
+            : p_(in.data())
+            , end_(in.data() + in.size())
+            , out_(out)
+            , handler_(handler)
+            , plus_as_space_(plus_as_space) {
+    }
+
+    /// Where the scan stopped, the end of the input unless a parameter is not followed
+    /// by `&`
+    char const* position() const noexcept {
+        return p_;
+    }
+
+    /// \return false if the input is malformed
+    bool scan() {
+        for (;;) {
+            if (p_ == end_) {
+                return true;
+            }
+            if (*p_ != '&') {
+                if (!parameter()) {
+                    return false;
+                }
+                if (p_ == end_ || *p_ != '&') {
+                    return true;
+                }
+            }
+            ++p_;
+        }
+    }
+
+private:
+    enum class Status { index, property, error };
+
+    /// Bracket at the current position, literal or percent-encoded
+    /// \return the bracket and the length of its encoding, or zero length
+    std::pair<char, int> bracket() const noexcept {
+        if (p_ == end_) {
+            return {0, 0};
+        }
+        if (*p_ == '[' || *p_ == ']') {
+            return {*p_, 1};
+        }
+        if (*p_ == '%' && end_ - p_ >= 3 && p_[1] == '5') {
+            switch (p_[2]) {
+            case 'b':
+            case 'B':
+                return {'[', 3};
+            case 'd':
+            case 'D':
+                return {']', 3};
+            }
+        }
+        return {0, 0};
+    }
+
+    bool closeBracket() noexcept {
+        auto const [c, n] = bracket();
+        if (c != ']') {
+            return false;
+        }
+        p_ += n;
+        *out_++ = ']';
+        return true;
+    }
+
+    /// Copy the decoded run of `pchar`s, and brackets if `brackets`
+    /// \return false on a malformed percent-encoding
+    bool pchars(bool brackets) noexcept {
+        for (;;) {
+            auto const run = skipAlnum(p_, end_);
+            std::memcpy(out_, p_, static_cast<std::size_t>(run - p_));
+            out_ += run - p_;
+            p_ = run;
+            if (p_ == end_) {
+                return true;
+            }
+            switch (queryChar(*p_)) {
+            case QueryChar::pchar:
+                *out_++ = *p_ == '+' && plus_as_space_ ? ' ' : *p_;
+                ++p_;
+                break;
+            case QueryChar::open:
+            case QueryChar::close:
+                if (!brackets) {
+                    return true;
+                }
+                *out_++ = *p_++;
+                break;
+            case QueryChar::pct: {
+                if (auto const [c, n] = bracket(); n != 0) {
+                    if (!brackets) {
+                        return true;
+                    }
+                    *out_++ = c;
+                    p_ += n;
+                    break;
+                }
+                if (end_ - p_ < 3) {
+                    return false;
+                }
+                auto const hi = hex_digits[static_cast<unsigned char>(p_[1])];
+                auto const lo = hex_digits[static_cast<unsigned char>(p_[2])];
+                if (hi < 0 || lo < 0) {
+                    return false;
+                }
+                *out_++ = static_cast<char>(16 * hi + lo);
+                p_ += 3;
+                break;
+            }
+            default:
+                return true;
+            }
+        }
+    }
+
+    /// Index operator after the open bracket, the input starts with a digit
+    /// \return whether the operator is an index or a property
+    Status index() {
+        auto const begin = p_;
+        auto const out_begin = out_;
+        uint64_t i = 0;
+        for (; p_ != end_ && *p_ >= '0' && *p_ <= '9'; ++p_) {
+            auto const d = static_cast<uint64_t>(*p_ - '0');
+            if (i > (std::numeric_limits<uint64_t>::max() - d) / 10) {
+                // `ulong_long` fails on overflow, the operator is a property then
+                p_ = begin;
+                out_ = out_begin;
+                return Status::property;
+            }
+            i = 10 * i + d;
+            *out_++ = *p_;
+        }
+        if (!closeBracket()) {
+            return Status::error;
+        }
+        handler_.indexOp(i);
+        return Status::index;
+    }
+
+    /// \return false if the parameter is malformed
+    bool parameter() {
+        auto const key = out_;
+        if (!pchars(false) || out_ == key) {
+            return false;
+        }
+        handler_.paramName(std::string_view(key, static_cast<std::size_t>(out_ - key)));
+
+        for (;;) {
+            auto const [c, n] = bracket();
+            if (c != '[') {
+                break;
+            }
+            auto const op = p_;
+            p_ += n;
+            *out_++ = '[';
+            if (p_ != end_ && *p_ >= '0' && *p_ <= '9') {
+                auto const status = index();
+                if (status == Status::index) {
+                    continue;
+                }
+                if (status == Status::error) {
+                    return false;
+                }
+            }
+            auto const property = out_;
+            if (!pchars(false)) {
+                return false;
+            }
+            if (out_ == property) {
+                // the empty index operator
+                p_ = op;
+                --out_;
+                break;
+            }
+            auto const name = std::string_view(property,
+                                               static_cast<std::size_t>(out_ - property));
+            if (!closeBracket()) {
+                return false;
+            }
+            handler_.propertyOp(name);
+        }
+
+        if (auto const [c, n] = bracket(); c == '[') {
+            p_ += n;
+            *out_++ = '[';
+            if (!closeBracket()) {
+                return false;
+            }
+            handler_.emptyIndexOp();
+        }
+
+        if (p_ == end_ || *p_ != '=') {
+            return false;
+        }
+        ++p_;
+
+        auto const key_view = std::string_view(key, static_cast<std::size_t>(out_ - key));
+        auto const value = out_;
+        if (!pchars(true) || (out_ == value && p_ != end_ && *p_ != '&')) {
+            return false;
+        }
+        handler_.value(key_view,
+                       std::string_view(value, static_cast<std::size_t>(out_ - value)));
+        return true;
+    }
+
+    char const* p_;
+    char const* const end_;
+    char* out_;
+    Handler& handler_;
+    bool const plus_as_space_;
+};
+
+/// Scan the query string `in`, decoding into `out` of at least `in.size()` chars
+/// \return false if `in` is malformed
+template <class Handler>
+bool scanQueryString(std::string_view in, char* out, Handler& handler) {
+    return QueryStringScanner<Handler>(in, out, handler).scan();
+}
+
+} // namespace yenxo::detail
@@ -0,0 +1,84 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/raw_json.hpp>
+#include <yenxo/variant.hpp>
+
+#include <rapidjson/error/en.h>
+#include <rapidjson/reader.h>
+
+#include <stdexcept>
+
+namespace yenxo {
+
+namespace {
+
+std::string trim(std::string json) {
+    auto const ws = " \t\n\r";
+    json.erase(0, json.find_first_not_of(ws));
+    json.erase(json.find_last_not_of(ws) + 1);
+    return json;
+}
+
+} // namespace
+
+RawJson::RawJson()
+        : json_("null") {
+}
+
+RawJson::RawJson(std::string json)
+        : json_(trim(std::move(json))) {
+    rapidjson::BaseReaderHandler<> handler;
+    rapidjson::Reader reader;
+    rapidjson::StringStream ss(json_.c_str());
+    reader.Parse(ss, handler);
+    if (reader.HasParseError()) {
+        throw std::runtime_error(rapidjson::GetParseError_En(reader.GetParseErrorCode()));
+    }
+    if (ss.Tell() != json_.size()) {
+        throw std::runtime_error(
+                rapidjson::GetParseError_En(rapidjson::kParseErrorDocumentRootNotSingular));
+    }
+}
+
+RawJson::RawJson(std::string json, Validated) noexcept
+        : json_(std::move(json)) {
+}
+
+Variant RawJson::parse() const {
+    return Variant::fromJson(json_);
+}
+
+Variant RawJson::toVariant(RawJson const& x) {
+    return Variant(x);
+}
+
+RawJson RawJson::fromVariant(Variant const& x) {
+    if (x.type() == Variant::TypeTag::raw_json) {
+        return x.raw();
+    }
+    return RawJson(x.toJson(), Validated{});
+}
+
+} // namespace yenxo
@@ -0,0 +1,143 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/raw_number.hpp>
+#include <yenxo/variant.hpp>
+
+#include <charconv>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+namespace yenxo {
+
+namespace {
+
+bool isDigit(char c) noexcept {
+    return c >= '0' && c <= '9';
+}
+
+// -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+bool isJsonNumber(std::string const& x) noexcept {
+    auto it = x.begin();
+    auto const end = x.end();
+    auto const digits = [&] {
+        auto const first = it;
+        while (it != end && isDigit(*it)) {
+            ++it;
+        }
+        return it != first;
+    };
+
+    if (it != end && *it == '-') {
+        ++it;
+    }
+    if (it != end && *it == '0') {
+        ++it;
+    } else if (!digits()) {
+        return false;
+    }
+    if (it != end && *it == '.') {
+        ++it;
+        if (!digits()) {
+            return false;
+        }
+    }
+    if (it != end && (*it == 'e' || *it == 'E')) {
+        ++it;
+        if (it != end && (*it == '+' || *it == '-')) {
+            ++it;
+        }
+        if (!digits()) {
+            return false;
+        }
+    }
+    return it == end;
+}
+
+} // namespace
+
+RawNumber::RawNumber()
+        : text_("0") {
+}
+
+RawNumber::RawNumber(std::string text)
+        : text_(std::move(text)) {
+    if (!isJsonNumber(text_)) {
+        throw std::runtime_error("'" + text_ + "' is not a JSON number");
+    }
+}
+
+RawNumber::RawNumber(std::string text, Validated) noexcept
+        : text_(std::move(text)) {
+}
+
+Variant RawNumber::parse() const noexcept {
+    auto const first = text_.data();
+    auto const last = first + text_.size();
+    if (text_.find_first_of(".eE") == std::string::npos) {
+        if (text_.front() == '-') {
+            int64_t x;
+            if (std::from_chars(first, last, x).ec == std::errc()) {
+                if (x >= std::numeric_limits<int32_t>::min()) {
+                    return Variant(static_cast<int32_t>(x));
+                }
+                return Variant(x);
+            }
+        } else {
+            uint64_t x;
+            if (std::from_chars(first, last, x).ec == std::errc()) {
+                if (x <= std::numeric_limits<uint32_t>::max()) {
+                    return Variant(static_cast<uint32_t>(x));
+                }
+                return Variant(x);
+            }
+        }
+    }
+    return Variant(std::strtod(text_.c_str(), nullptr));
+}
+
+Variant RawNumber::toVariant(RawNumber const& x) {
+    return Variant(x);
+}
+
+RawNumber RawNumber::fromVariant(Variant const& x) {
+    switch (x.type()) {
+    case Variant::TypeTag::char_:
+    case Variant::TypeTag::int8:
+    case Variant::TypeTag::uint8:
+    case Variant::TypeTag::int16:
+    case Variant::TypeTag::uint16:
+    case Variant::TypeTag::int32:
+    case Variant::TypeTag::uint32:
+    case Variant::TypeTag::int64:
+    case Variant::TypeTag::uint64:
+    case Variant::TypeTag::double_:
+        return RawNumber(x.toJson(), Validated{});
+    default:
+        return x.number();
+    }
+}
+
+} // namespace yenxo
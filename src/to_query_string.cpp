@@ -0,0 +1,236 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/query_string.hpp>
+#include <yenxo/raw_json.hpp>
+#include <yenxo/raw_number.hpp>
+#include <yenxo/to_query_string.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdio>
+
+namespace yenxo {
+namespace detail {
+namespace {
+
+/// Hex digits of the escape of every byte, zeros for the unreserved characters
+constexpr std::array<std::array<char, 2>, 256> query_escapes = [] {
+    constexpr char hex[] = "0123456789ABCDEF";
+    std::array<std::array<char, 2>, 256> ret{};
+    for (int c = 0; c < 256; ++c) {
+        ret[c] = {hex[c >> 4], hex[c & 0xf]};
+    }
+    for (int c = '0'; c <= '9'; ++c) {
+        ret[c] = {};
+    }
+    for (int c = 'a'; c <= 'z'; ++c) {
+        ret[c] = {};
+        ret[c - 'a' + 'A'] = {};
+    }
+    for (char c : std::string_view("-._~")) {
+        ret[static_cast<unsigned char>(c)] = {};
+    }
+    return ret;
+}();
+
+constexpr std::string_view open_bracket = "%5B";
+constexpr std::string_view close_bracket = "%5D";
+
+template <class T>
+std::string_view toChars(char* buf, std::size_t size, T x) {
+    auto const end = std::to_chars(buf, buf + size, x).ptr;
+    return std::string_view(buf, static_cast<std::size_t>(end - buf));
+}
+
+/// Text of the scalar `x`, `buf` is room for a number
+std::string_view scalarText(Variant const& x, char (&buf)[32]) {
+    switch (x.type()) {
+    case Variant::TypeTag::boolean:
+        return x.boolean() ? "true" : "false";
+    case Variant::TypeTag::char_:
+        buf[0] = x.character();
+        return std::string_view(buf, 1);
+    case Variant::TypeTag::int8:
+        return toChars(buf, sizeof(buf), x.int8());
+    case Variant::TypeTag::uint8:
+        return toChars(buf, sizeof(buf), x.uint8());
+    case Variant::TypeTag::int16:
+        return toChars(buf, sizeof(buf), x.int16());
+    case Variant::TypeTag::uint16:
+        return toChars(buf, sizeof(buf), x.uint16());
+    case Variant::TypeTag::int32:
+        return toChars(buf, sizeof(buf), x.int32());
+    case Variant::TypeTag::uint32:
+        return toChars(buf, sizeof(buf), x.uint32());
+    case Variant::TypeTag::int64:
+        return toChars(buf, sizeof(buf), x.int64());
+    case Variant::TypeTag::uint64:
+        return toChars(buf, sizeof(buf), x.uint64());
+    case Variant::TypeTag::double_:
+#if defined(__cpp_lib_to_chars)
+        return toChars(buf, sizeof(buf), x.floating());
+#else
+        return std::string_view(
+                buf, std::snprintf(buf, sizeof(buf), "%.17g", x.floating()));
+#endif
+    case Variant::TypeTag::string:
+        return x.str();
+    case Variant::TypeTag::raw_json:
+        return x.raw().json();
+    case Variant::TypeTag::raw_number:
+        return x.number().text();
+    default:
+        return {};
+    }
+}
+
+bool isScalar(Variant const& x) noexcept {
+    switch (x.type()) {
+    case Variant::TypeTag::null:
+    case Variant::TypeTag::vec:
+    case Variant::TypeTag::map:
+        return false;
+    default:
+        return true;
+    }
+}
+
+} // namespace
+
+void appendQueryEncoded(std::string& out, std::string_view x) {
+    auto const size = out.size();
+    out.resize(size + 3 * x.size());
+    auto p = out.data() + size;
+    for (auto const c : x) {
+        auto const& escape = query_escapes[static_cast<unsigned char>(c)];
+        if (escape[0] == '\0') {
+            *p++ = c;
+        } else {
+            p[0] = '%';
+            p[1] = escape[0];
+            p[2] = escape[1];
+            p += 3;
+        }
+    }
+    out.resize(static_cast<std::size_t>(p - out.data()));
+}
+
+std::size_t QueryEncoder::member(std::string_view x) {
+    // an empty key would read back as `[]`, a bracket as one more level
+    if (x.empty() || x.find_first_of("[]") != std::string_view::npos) {
+        YENXO_THROW(QueryStringError("no query string form of the key '" + std::string(x)
+                                     + "'"));
+    }
+    auto const size = key_.size();
+    if (size == 0) {
+        appendQueryEncoded(key_, x);
+    } else {
+        key_ += open_bracket;
+        // a bracketed key starting with a digit would read back as an index
+        if (!x.empty() && x.front() >= '0' && x.front() <= '9') {
+            key_ += "%3";
+            key_ += x.front();
+            x.remove_prefix(1);
+        }
+        appendQueryEncoded(key_, x);
+        key_ += close_bracket;
+    }
+    return size;
+}
+
+std::size_t QueryEncoder::index(uint64_t i) {
+    auto const size = key_.size();
+    char buf[24];
+    key_ += open_bracket;
+    key_ += toChars(buf, sizeof(buf), i);
+    key_ += close_bracket;
+    return size;
+}
+
+void QueryEncoder::param(std::string_view x, bool append) {
+    if (!out_.empty()) {
+        out_ += '&';
+    }
+    out_ += key_;
+    if (append) {
+        out_ += open_bracket;
+        out_ += close_bracket;
+    }
+    out_ += '=';
+    appendQueryEncoded(out_, x);
+}
+
+void QueryEncoder::variant(Variant const& x) {
+    char buf[32];
+    switch (x.type()) {
+    case Variant::TypeTag::null:
+        break;
+    case Variant::TypeTag::vec: {
+        auto const& vec = x.vec();
+        if (std::all_of(vec.begin(), vec.end(), isScalar)) {
+            for (auto const& e : vec) {
+                param(scalarText(e, buf), true);
+            }
+        } else {
+            // a null element is a gap in the indexes
+            for (std::size_t i = 0; i < vec.size(); ++i) {
+                auto const size = index(i);
+                variant(vec[i]);
+                restore(size);
+            }
+        }
+        break;
+    }
+    case Variant::TypeTag::map:
+        for (auto const& [key, value] : x.map()) {
+            auto const size = member(key);
+            variant(value);
+            restore(size);
+        }
+        break;
+    default:
+        param(scalarText(x, buf), false);
+        break;
+    }
+}
+
+void QueryEncoder::root(Variant const& x) {
+    static_cast<void>(x.map());
+    variant(x);
+}
+
+QueryStringWriter& threadQueryStringWriter() {
+    thread_local QueryStringWriter writer;
+    return writer;
+}
+
+} // namespace detail
+
+std::string toQueryString(Variant const& x) {
+    return std::string(detail::threadQueryStringWriter().write(x));
+}
+
+} // namespace yenxo
@@ -0,0 +1,176 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "checked_cast.hpp"
+
+#include <yenxo/try_from_variant.hpp>
+
+namespace yenxo {
+
+namespace {
+
+using detail::FlagVariantIntegralOverflow;
+
+template <typename T, typename U>
+std::optional<FromVariantError> checkedCast(U x, T& out) {
+    FlagVariantIntegralOverflow::overflow = false;
+    out = detail::arithmeticCheckedCast<T, FlagVariantIntegralOverflow>(x);
+    if (FlagVariantIntegralOverflow::overflow) {
+        return FromVariantError::overflow(boost::hana::type_c<T>, std::to_string(x));
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+std::string FromVariantError::message() const {
+    switch (code_) {
+    case VariantErrc::empty:
+        return "expected '" + expected_() + "', actual: 'Empty'";
+    case VariantErrc::bad_type:
+        return "expected '" + expected_() + "', actual '" + actual_() + "'";
+    case VariantErrc::integral_overflow:
+        return "The type '" + expected_() + "' can not hold the value '" + text_ + "'";
+    case VariantErrc::bad_value:
+        return "'" + text_ + "' is not of type '" + expected_() + "'";
+    case VariantErrc::bad_size:
+        return "expected size of the " + text_ + " is " + std::to_string(expected_size_)
+             + ", actual " + std::to_string(actual_size_);
+    case VariantErrc::missing_member:
+        return "'" + text_ + "' is required";
+    case VariantErrc::unknown_member:
+        return "'" + text_ + "' is unknown";
+    case VariantErrc::other:
+        break;
+    }
+    return text_;
+}
+
+std::string FromVariantError::path() const {
+    return frames_.render() + inner_path_;
+}
+
+FromVariantError::TypeNameFn FromVariantError::typeNameFor(
+        Variant::TypeTag tag) noexcept {
+    using TypeTag = Variant::TypeTag;
+    switch (tag) {
+    case TypeTag::null:
+        return &detail::typeNameOf<Variant::NullType>;
+    case TypeTag::boolean:
+        return &detail::typeNameOf<bool>;
+    case TypeTag::char_:
+        return &detail::typeNameOf<char>;
+    case TypeTag::int8:
+        return &detail::typeNameOf<int8_t>;
+    case TypeTag::uint8:
+        return &detail::typeNameOf<uint8_t>;
+    case TypeTag::int16:
+        return &detail::typeNameOf<int16_t>;
+    case TypeTag::uint16:
+        return &detail::typeNameOf<uint16_t>;
+    case TypeTag::int32:
+        return &detail::typeNameOf<int32_t>;
+    case TypeTag::uint32:
+        return &detail::typeNameOf<uint32_t>;
+    case TypeTag::int64:
+        return &detail::typeNameOf<int64_t>;
+    case TypeTag::uint64:
+        return &detail::typeNameOf<uint64_t>;
+    case TypeTag::double_:
+        return &detail::typeNameOf<double>;
+    case TypeTag::string:
+        return &detail::typeNameOf<std::string>;
+    case TypeTag::vec:
+        return &detail::typeNameOf<Variant::Vec>;
+    case TypeTag::map:
+        return &detail::typeNameOf<Variant::Map>;
+    case TypeTag::raw_json:
+        return &detail::typeNameOf<RawJson>;
+    case TypeTag::raw_number:
+        break;
+    }
+    return &detail::typeNameOf<RawNumber>;
+}
+
+namespace detail {
+
+template <typename T>
+std::optional<FromVariantError> tryArithmetic(Variant const& x, T& out) {
+    using TypeTag = Variant::TypeTag;
+    switch (x.type()) {
+    case TypeTag::null:
+        return FromVariantError::empty(boost::hana::type_c<T>);
+    case TypeTag::boolean:
+        return checkedCast(x.boolean(), out);
+    case TypeTag::char_:
+        return checkedCast(x.character(), out);
+    case TypeTag::int8:
+        return checkedCast(x.int8(), out);
+    case TypeTag::uint8:
+        return checkedCast(x.uint8(), out);
+    case TypeTag::int16:
+        return checkedCast(x.int16(), out);
+    case TypeTag::uint16:
+        return checkedCast(x.uint16(), out);
+    case TypeTag::int32:
+        return checkedCast(x.int32(), out);
+    case TypeTag::uint32:
+        return checkedCast(x.uint32(), out);
+    case TypeTag::int64:
+        return checkedCast(x.int64(), out);
+    case TypeTag::uint64:
+        return checkedCast(x.uint64(), out);
+    case TypeTag::double_:
+        return checkedCast(x.floating(), out);
+    case TypeTag::raw_number:
+        FlagVariantIntegralOverflow::overflow = false;
+        out = rawNumberCheckedCast<T, FlagVariantIntegralOverflow>(x.number());
+        if (FlagVariantIntegralOverflow::overflow) {
+            return FromVariantError::overflow(boost::hana::type_c<T>, x.number().text());
+        }
+        return std::nullopt;
+    case TypeTag::string:
+    case TypeTag::vec:
+    case TypeTag::map:
+    case TypeTag::raw_json:
+        break;
+    }
+    return FromVariantError::badType(boost::hana::type_c<T>, x.type());
+}
+
+template std::optional<FromVariantError> tryArithmetic(Variant const&, bool&);
+template std::optional<FromVariantError> tryArithmetic(Variant const&, char&);
+template std::optional<FromVariantError> tryArithmetic(Variant const&, int8_t&);
+template std::optional<FromVariantError> tryArithmetic(Variant const&, uint8_t&);
+template std::optional<FromVariantError> tryArithmetic(Variant const&, int16_t&);
+template std::optional<FromVariantError> tryArithmetic(Variant const&, uint16_t&);
+template std::optional<FromVariantError> tryArithmetic(Variant const&, int32_t&);
+template std::optional<FromVariantError> tryArithmetic(Variant const&, uint32_t&);
+template std::optional<FromVariantError> tryArithmetic(Variant const&, int64_t&);
+template std::optional<FromVariantError> tryArithmetic(Variant const&, uint64_t&);
+template std::optional<FromVariantError> tryArithmetic(Variant const&, double&);
+
+} // namespace detail
+
+} // namespace yenxo
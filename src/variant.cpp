@@ -23,10 +23,14 @@
 */
 
 #include <yenxo/exception.hpp>
+#include <yenxo/hash.hpp>
 #include <yenxo/meta.hpp>
 #include <yenxo/type_name.hpp>
 #include <yenxo/variant.hpp>
 
+#include "checked_cast.hpp"
+#include "from_json.hpp"
+
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
 #include <rapidjson/prettywriter.h>
@@ -34,7 +38,9 @@
 #include <rapidjson/writer.h>
 
 #include <algorithm>
+#include <charconv>
 #include <cmath>
+#include <optional>
 #include <ostream>
 #include <typeinfo>
 
@@ -51,6 +57,12 @@ Variant::~Variant() noexcept {
     case TypeTag::map:
         delete reinterpret_cast<Map*>(value_.ptr);
         break;
+    case TypeTag::raw_json:
+        delete reinterpret_cast<RawJson*>(value_.ptr);
+        break;
+    case TypeTag::raw_number:
+        delete reinterpret_cast<RawNumber*>(value_.ptr);
+        break;
     default:
         break;
     }
@@ -141,6 +153,24 @@ Variant::Variant(Map&& x)
         , value_(new Map(std::move(x))) {
 }
 
+Variant::Variant(RawJson const& x)
+        : type_tag_(TypeTag::raw_json)
+        , value_(new RawJson(x)) {
+}
+Variant::Variant(RawJson&& x)
+        : type_tag_(TypeTag::raw_json)
+        , value_(new RawJson(std::move(x))) {
+}
+
+Variant::Variant(RawNumber const& x)
+        : type_tag_(TypeTag::raw_number)
+        , value_(new RawNumber(x)) {
+}
+Variant::Variant(RawNumber&& x)
+        : type_tag_(TypeTag::raw_number)
+        , value_(new RawNumber(std::move(x))) {
+}
+
 struct Variant::Impl {
     static inline ValueType copy(TypeTag tag, ValueType x) {
         ValueType ret;
@@ -154,6 +184,12 @@ struct Variant::Impl {
         case TypeTag::map:
             ret = new Map(*reinterpret_cast<Map*>(x.ptr));
             break;
+        case TypeTag::raw_json:
+            ret = new RawJson(*reinterpret_cast<RawJson*>(x.ptr));
+            break;
+        case TypeTag::raw_number:
+            ret = new RawNumber(*reinterpret_cast<RawNumber*>(x.ptr));
+            break;
         default:
             ret = x;
             break;
@@ -162,6 +198,7 @@ struct Variant::Impl {
     }
 
     struct ToJson;
+    struct ToCanonicalJson;
 };
 
 Variant::Variant(Variant const& rhs)
@@ -219,193 +256,9 @@ struct GetHelper<Variant::NullType> {
     }
 };
 
-template <typename A, typename B>
-constexpr auto same_sign_v = std::is_signed_v<A> == std::is_signed_v<B>;
-
-struct ThrowVariantIntegralOverflow {
-    template <class Type, class Value>
-    [[noreturn]] static typename Type::type apply(Type t, Value const& v) {
-        throw VariantIntegralOverflow(std::string(typeName(t)), std::to_string(v));
-    }
-};
-
-// Casts `U` to `T` if a specific value of `U` is representable in `T` else throws
-// `VariantIntegralOverflow`.
-template <typename T,
-          typename U,
-          typename ThrowPolicy = ThrowVariantIntegralOverflow,
-          typename = void>
-struct ArithmeticCheckedCast final
-        : ArithmeticCheckedCast<T, U, ThrowPolicy, When<true>> {
-    static_assert(std::is_arithmetic_v<T> && std::is_arithmetic_v<U>);
-};
-
-template <typename T, typename U, typename P>
-struct ArithmeticCheckedCast<T, U, P, When<same_sign_v<T, U> && sizeof(T) >= sizeof(U)>> {
-    static T apply(U x) noexcept {
-        return x;
-    }
-};
-
-template <typename T, typename U, typename P>
-struct ArithmeticCheckedCast<T, U, P, When<same_sign_v<T, U> && sizeof(T) < sizeof(U)>> {
-    static T apply(U x) {
-        if (x < std::numeric_limits<T>::min() || x > std::numeric_limits<T>::max()) {
-            return P::apply(boost::hana::type_c<T>, x);
-        } else {
-            return static_cast<T>(x);
-        }
-    }
-};
-
-template <typename T, typename U, typename P>
-struct ArithmeticCheckedCast<
-        T,
-        U,
-        P,
-        When<std::is_signed_v<T> && std::is_unsigned_v<U> && (sizeof(T) > sizeof(U))>> {
-    static T apply(U x) noexcept {
-        return x;
-    }
-};
-
-template <typename T, typename U, typename P>
-struct ArithmeticCheckedCast<
-        T,
-        U,
-        P,
-        When<std::is_signed_v<T> && std::is_unsigned_v<U> && (sizeof(T) <= sizeof(U))>> {
-    static T apply(U x) {
-#if defined(__GNUG__) || defined(__clang__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wsign-compare"
-        if (x > std::numeric_limits<T>::max()) {
-#pragma GCC diagnostic pop
-#else
-#error The compiler not supported
-#endif
-            return P::apply(boost::hana::type_c<T>, x);
-        }
-        return static_cast<T>(x);
-    }
-};
-
-template <typename T, typename U, typename P>
-struct ArithmeticCheckedCast<
-        T,
-        U,
-        P,
-        When<std::is_unsigned_v<T> && std::is_signed_v<U> && sizeof(T) >= sizeof(U)>> {
-    static T apply(U x) {
-        if (x < 0) {
-            return P::apply(boost::hana::type_c<T>, x);
-        } else {
-            return static_cast<T>(x);
-        }
-    }
-};
-
-template <typename T, typename U, typename P>
-struct ArithmeticCheckedCast<
-        T,
-        U,
-        P,
-        When<std::is_unsigned_v<T> && std::is_signed_v<U> && sizeof(T) < sizeof(U)>> {
-    static T apply(U x) {
-#if defined(__GNUG__) || defined(__clang__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wsign-compare"
-        if (x < 0 || x > std::numeric_limits<T>::max()) {
-#pragma GCC diagnostic pop
-#else
-#error The compiler not supported
-#endif
-            return P::apply(boost::hana::type_c<T>, x);
-        }
-        return static_cast<T>(x);
-    }
-};
-
-template <typename U>
-struct ArithmeticCheckedCast<double, U> {
-    static double apply(U x) noexcept {
-        return x;
-    }
-};
-
-template <typename T, typename P>
-struct ArithmeticCheckedCast<T, double, P> {
-    static T apply(double x) {
-        double iptr;
-        if (std::modf(x, &iptr) == 0.0) {
-            return ArithmeticCheckedCast<T, int64_t, P>::apply(static_cast<int64_t>(x));
-        } else {
-            return P::apply(boost::hana::type_c<T>, x);
-        }
-    }
-};
-
-template <>
-struct ArithmeticCheckedCast<double, double> {
-    static double apply(double x) noexcept {
-        return x;
-    }
-};
-
-template <typename U, typename P>
-struct ArithmeticCheckedCast<bool, U, P> {
-    static bool apply(U x) {
-        if (x != 0 && x != 1) {
-            return P::apply(boost::hana::type_c<bool>, x);
-        } else {
-            return static_cast<bool>(x);
-        }
-    }
-};
-
-template <typename T>
-struct ArithmeticCheckedCast<T, bool> {
-    static T apply(bool x) noexcept {
-        return x;
-    }
-};
-
-template <>
-struct ArithmeticCheckedCast<bool, bool> {
-    static bool apply(bool x) noexcept {
-        return x;
-    }
-};
-
-template <>
-struct ArithmeticCheckedCast<double, bool> {
-    static double apply(bool x) noexcept {
-        return x;
-    }
-};
-
-template <typename P>
-struct ArithmeticCheckedCast<bool, double, P> {
-    static bool apply(double x) {
-        if (x != 0.0 && x != 1.0) {
-            return P::apply(boost::hana::type_c<bool>, x);
-        } else {
-            return static_cast<bool>(x);
-        }
-    }
-};
-
-template <typename Dst>
-struct ArithmeticCheckedCastT {
-    template <typename Src>
-    Dst operator()(Src x) const
-            noexcept(noexcept(ArithmeticCheckedCast<Dst, Src>::apply(x))) {
-        return ArithmeticCheckedCast<Dst, Src>::apply(x);
-    }
-};
-
-template <typename T>
-constexpr ArithmeticCheckedCastT<T> arithmeticCheckedCast;
+using detail::arithmeticCheckedCast;
+using detail::same_sign_v;
+using detail::rawNumberCheckedCast;
 
 template <typename T>
 struct GetHelper<T, When<std::is_arithmetic_v<T>>> {
@@ -448,6 +301,12 @@ struct GetHelper<T, When<std::is_arithmetic_v<T>>> {
     [[noreturn]] static T apply(Variant::Map) {
         throw VariantBadType(boost::hana::type_c<T>, boost::hana::type_c<Variant::Map>);
     }
+    [[noreturn]] static T apply(RawJson const&) {
+        throw VariantBadType(boost::hana::type_c<T>, boost::hana::type_c<RawJson>);
+    }
+    static T apply(RawNumber const& x) {
+        return rawNumberCheckedCast<T>(x);
+    }
 };
 
 template <typename T>
@@ -502,6 +361,10 @@ decltype(auto) getHelper(Variant::TypeTag tag, U value_) {
         return GetHelper<T>::apply(*reinterpret_cast<Variant::Vec*>(value_.ptr));
     case TypeTag::map:
         return GetHelper<T>::apply(*reinterpret_cast<Variant::Map*>(value_.ptr));
+    case TypeTag::raw_json:
+        return GetHelper<T>::apply(*reinterpret_cast<RawJson*>(value_.ptr));
+    case TypeTag::raw_number:
+        return GetHelper<T>::apply(*reinterpret_cast<RawNumber*>(value_.ptr));
     }
 }
 #pragma GCC diagnostic pop
@@ -615,6 +478,10 @@ std::string const& Variant::str() const {
     return getHelper<std::string>(type_tag_, value_);
 }
 
+std::string& Variant::modifyStr() {
+    return getHelper<std::string&>(type_tag_, value_);
+}
+
 std::string Variant::strOr(std::string const& x) const {
     GET_HELPER(std::string, type_tag_, value_, x);
 }
@@ -643,6 +510,14 @@ Variant::Map& Variant::modifyMap() {
     return getHelper<Map&>(type_tag_, value_);
 }
 
+RawJson const& Variant::raw() const {
+    return getHelper<RawJson>(type_tag_, value_);
+}
+
+RawNumber const& Variant::number() const {
+    return getHelper<RawNumber>(type_tag_, value_);
+}
+
 #if defined(__GNUG__) || defined(__clang__)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wfloat-equal" // safe comparation
@@ -684,6 +559,12 @@ bool Variant::operator==(Variant const& rhs) const noexcept {
         case TypeTag::map:
             return *reinterpret_cast<Variant::Map*>(value_.ptr)
                 == *reinterpret_cast<Variant::Map*>(rhs.value_.ptr);
+        case TypeTag::raw_json:
+            return *reinterpret_cast<RawJson*>(value_.ptr)
+                == *reinterpret_cast<RawJson*>(rhs.value_.ptr);
+        case TypeTag::raw_number:
+            return *reinterpret_cast<RawNumber*>(value_.ptr)
+                == *reinterpret_cast<RawNumber*>(rhs.value_.ptr);
         }
         return false;
     }
@@ -798,6 +679,103 @@ bool ArithmeticCheckedEqT::operator()(Lhs lhs, Rhs rhs) const noexcept {
     return ArithmeticCheckedEq<Lhs, Rhs>::apply(lhs, rhs);
 }
 
+/// Exact decimal value of a number text, `digits` has no leading and trailing zeros
+struct Decimal {
+    bool negative{false};
+    std::string digits;
+    int64_t exponent{0};
+
+    bool operator==(Decimal const& rhs) const noexcept {
+        return negative == rhs.negative && exponent == rhs.exponent
+            && digits == rhs.digits;
+    }
+};
+
+std::optional<Decimal> decimal(std::string_view x) {
+    Decimal ret;
+    std::size_t i = 0;
+    if (i < x.size() && x[i] == '-') {
+        ret.negative = true;
+        ++i;
+    }
+    bool dot = false;
+    int64_t fraction = 0;
+    for (; i < x.size(); ++i) {
+        auto const c = x[i];
+        if (c >= '0' && c <= '9') {
+            if (!ret.digits.empty() || c != '0') {
+                ret.digits += c;
+            }
+            if (dot) {
+                ++fraction;
+            }
+        } else if (c == '.' && !dot) {
+            dot = true;
+        } else {
+            break;
+        }
+    }
+    if (i < x.size()) {
+        if (x[i] != 'e' && x[i] != 'E') {
+            return std::nullopt;
+        }
+        if (++i < x.size() && x[i] == '+') {
+            ++i;
+        }
+        auto const end = x.data() + x.size();
+        auto const [ptr, ec] = std::from_chars(x.data() + i, end, ret.exponent);
+        if (ec != std::errc() || ptr != end) {
+            return std::nullopt;
+        }
+    }
+    auto const last = ret.digits.find_last_not_of('0');
+    if (last == std::string::npos) {
+        return Decimal{};
+    }
+    ret.exponent += static_cast<int64_t>(ret.digits.size() - last - 1) - fraction;
+    ret.digits.erase(last + 1);
+    return ret;
+}
+
+/// Compare the values of two number texts without rounding
+bool sameNumber(std::string_view lhs, std::string_view rhs) {
+    auto const l = decimal(lhs);
+    auto const r = decimal(rhs);
+    if (!l || !r) {
+        return lhs == rhs;
+    }
+    return *l == *r;
+}
+
+/// `equal` of a `RawNumber` and a node
+///
+/// A text that does not convert exactly to a 64-bit integer is compared by its decimal
+/// value, so the numbers that only a double rounding makes equal stay distinct.
+bool equalNumber(RawNumber const& lhs, Variant const& rhs) {
+    using TypeTag = Variant::TypeTag;
+    if (rhs.type() == TypeTag::raw_number) {
+        return sameNumber(lhs.text(), rhs.number().text());
+    }
+    auto const parsed = lhs.parse();
+    if (parsed.type() != TypeTag::double_ || rhs.type() < TypeTag::int8
+        || rhs.type() > TypeTag::double_) {
+        return equal(parsed, rhs);
+    }
+    char buf[32];
+    auto const [ptr, ec] = [&] {
+        auto const end = buf + sizeof(buf);
+        switch (rhs.type()) {
+        case TypeTag::double_:
+            return std::to_chars(buf, end, rhs.floating());
+        case TypeTag::uint64:
+            return std::to_chars(buf, end, rhs.uint64());
+        default:
+            return std::to_chars(buf, end, rhs.int64());
+        }
+    }();
+    return ec == std::errc() && sameNumber(lhs.text(), std::string_view(buf, ptr - buf));
+}
+
 template <class T, class U>
 bool equalArithmetic(T lhs, Variant::TypeTag tag, U const& rhs) {
     using TypeTag = Variant::TypeTag;
@@ -833,16 +811,29 @@ bool equalArithmetic(T lhs, Variant::TypeTag tag, U const& rhs) {
         return false;
     case TypeTag::map:
         return false;
+    case TypeTag::raw_json:
+        return false;
+    case TypeTag::raw_number:
+        return equalNumber(*reinterpret_cast<RawNumber*>(rhs.ptr), Variant(lhs));
     }
     assert(false);
     return false;
 }
 
+/// `equal` of array elements, the same typed arithmetic ones skip the conversions
+bool equalElement(Variant const& lhs, Variant const& rhs) noexcept {
+    using TypeTag = Variant::TypeTag;
+    auto const tag = lhs.type();
+    if (tag == rhs.type() && tag >= TypeTag::boolean && tag <= TypeTag::double_) {
+        return lhs == rhs;
+    }
+    return equal(lhs, rhs);
+}
+
 } // namespace
 
 bool equal(Variant const& lhs, Variant const& rhs) noexcept {
     using TypeTag = Variant::TypeTag;
-    using Map = Variant::Map;
 
     switch (lhs.type_tag_) {
     case TypeTag::null:
@@ -871,7 +862,11 @@ bool equal(Variant const& lhs, Variant const& rhs) noexcept {
     case TypeTag::double_:
         return equalArithmetic(lhs.value_.double_, rhs.type_tag_, rhs.value_);
 
+    case TypeTag::raw_number:
+        return equalNumber(lhs.number(), rhs);
+
     case TypeTag::string:
+    case TypeTag::raw_json:
         return lhs == rhs;
     case TypeTag::vec: {
         if (TypeTag::vec != rhs.type()) {
@@ -880,7 +875,7 @@ bool equal(Variant const& lhs, Variant const& rhs) noexcept {
         auto const& lhs_vec = lhs.vec();
         auto const& rhs_vec = rhs.vec();
         return lhs_vec.size() == rhs_vec.size()
-            && std::equal(lhs_vec.begin(), lhs_vec.end(), rhs_vec.begin(), &equal);
+            && std::equal(lhs_vec.begin(), lhs_vec.end(), rhs_vec.begin(), &equalElement);
     }
     case TypeTag::map: {
         if (TypeTag::map != rhs.type()) {
@@ -891,28 +886,79 @@ bool equal(Variant const& lhs, Variant const& rhs) noexcept {
         if (lhs_map.size() != rhs_map.size()) {
             return false;
         }
-        std::vector<Map::const_pointer> lhs(lhs_map.size());
-        std::vector<Map::const_pointer> rhs(rhs_map.size());
-        std::transform(lhs_map.begin(), lhs_map.end(), lhs.begin(), [](auto const& x) {
-            return std::addressof(x);
-        });
-        std::transform(rhs_map.begin(), rhs_map.end(), rhs.begin(), [](auto const& x) {
-            return std::addressof(x);
-        });
-        std::sort(lhs.begin(), lhs.end(), [](auto lhs, auto rhs) {
-            return lhs->first < rhs->first;
-        });
-        std::sort(rhs.begin(), rhs.end(), [](auto lhs, auto rhs) {
-            return lhs->first < rhs->first;
-        });
-        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](auto lhs, auto rhs) {
-            return lhs->first == rhs->first && equal(lhs->second, rhs->second);
-        });
+        // the keys are unique, so probing each of `lhs` in `rhs` covers both
+        for (auto const& [key, value] : lhs_map) {
+            auto const it = rhs_map.find(key);
+            if (it == rhs_map.end() || !equal(value, it->second)) {
+                return false;
+            }
+        }
+        return true;
     }
     }
     return false;
 }
 
+std::size_t hashValue(Variant const& x) noexcept {
+    using TypeTag = Variant::TypeTag;
+    auto const& v = x.value_;
+    auto const scalar = [&](auto y) {
+        return hashCombine(static_cast<std::size_t>(x.type_tag_), hashOf(y));
+    };
+
+    switch (x.type_tag_) {
+    case TypeTag::null:
+        return scalar(0);
+    case TypeTag::boolean:
+        return scalar(v.bool_);
+    case TypeTag::char_:
+        return scalar(v.char_);
+    case TypeTag::int8:
+        return scalar(v.int8);
+    case TypeTag::uint8:
+        return scalar(v.uint8);
+    case TypeTag::int16:
+        return scalar(v.int16);
+    case TypeTag::uint16:
+        return scalar(v.uint16);
+    case TypeTag::int32:
+        return scalar(v.int32);
+    case TypeTag::uint32:
+        return scalar(v.uint32);
+    case TypeTag::int64:
+        return scalar(v.int64);
+    case TypeTag::uint64:
+        return scalar(v.uint64);
+    case TypeTag::double_:
+        return scalar(v.double_);
+    case TypeTag::string:
+        return scalar(*reinterpret_cast<std::string const*>(v.ptr));
+    case TypeTag::raw_json:
+        return scalar(reinterpret_cast<RawJson const*>(v.ptr)->json());
+    case TypeTag::raw_number:
+        return scalar(reinterpret_cast<RawNumber const*>(v.ptr)->text());
+    case TypeTag::vec: {
+        auto const& vec = *reinterpret_cast<Variant::Vec const*>(v.ptr);
+        std::size_t ret = hashCombine(static_cast<std::size_t>(x.type_tag_), vec.size());
+        for (auto const& e : vec) {
+            ret = hashCombine(ret, hashValue(e));
+        }
+        return ret;
+    }
+    case TypeTag::map: {
+        // the members are summed up, the iteration order does not matter
+        auto const& map = *reinterpret_cast<Variant::Map const*>(v.ptr);
+        std::size_t sum = 0;
+        for (auto const& [key, value] : map) {
+            sum += hashMix(hashCombine(hashOf(key), hashValue(value)));
+        }
+        return hashCombine(hashCombine(static_cast<std::size_t>(x.type_tag_), map.size()),
+                           sum);
+    }
+    }
+    return 0;
+}
+
 bool Variant::operator!=(Variant const& rhs) const noexcept {
     return !this->operator==(rhs);
 }
@@ -921,100 +967,7 @@ namespace {
 
 using namespace rapidjson;
 
-/// RapidJSON visitor
-template <typename Encoding>
-struct FromJson : rapidjson::BaseReaderHandler<Encoding, FromJson<Encoding>> {
-    template <class T>
-    void val(T&& x) {
-        switch (ptrs.back()->type()) {
-        case Variant::TypeTag::map:
-            ptrs.back()->modifyMap()[std::move(key)] = Variant(std::forward<T>(x));
-            break;
-        case Variant::TypeTag::vec:
-            ptrs.back()->modifyVec().push_back(Variant(std::forward<T>(x)));
-            break;
-        default:
-            *ptrs.back() = Variant(std::forward<T>(x));
-        }
-    }
-
-    template <class T>
-    Variant* val2(T&& x) {
-        switch (ptrs.back()->type()) {
-        case Variant::TypeTag::map:
-            return &(ptrs.back()->modifyMap()[std::move(key)] = Variant(std::forward<T>(x)));
-        case Variant::TypeTag::vec:
-            ptrs.back()->modifyVec().push_back(Variant(std::forward<T>(x)));
-            return &ptrs.back()->modifyVec().back();
-        default:
-            return &(*ptrs.back() = Variant(std::forward<T>(x)));
-        }
-    }
-
-    bool Null() {
-        val(Variant::NullType());
-        return true;
-    }
-    bool Bool(bool b) {
-        val(b);
-        return true;
-    }
-    bool Int(int32_t i) {
-        val(i);
-        return true;
-    }
-    bool Uint(uint32_t u) {
-        val(u);
-        return true;
-    }
-    bool Int64(int64_t i64) {
-        val(i64);
-        return true;
-    }
-    bool Uint64(uint64_t u64) {
-        val(u64);
-        return true;
-    }
-    bool Double(double d) {
-        val(d);
-        return true;
-    }
-    bool String(typename Encoding::Ch const* str, SizeType length, bool) {
-        val(std::string(str, length));
-        return true;
-    }
-    bool StartObject() {
-        ptrs.push_back(val2(Variant::Map()));
-        return true;
-    }
-    bool Key(typename Encoding::Ch const* str, SizeType length, bool) {
-        assert(ptrs.back()->type() == Variant::TypeTag::map);
-        key = std::string(str, length);
-        return true;
-    }
-    bool EndObject(SizeType n) {
-        assert(ptrs.back()->type() == Variant::TypeTag::map);
-        assert(ptrs.back()->map().size() == n);
-        (void)n;
-        ptrs.pop_back();
-        return true;
-    }
-    bool StartArray() {
-        ptrs.push_back(val2(Variant::Vec()));
-        return true;
-    }
-    bool EndArray(SizeType n) {
-        assert(ptrs.back()->type() == Variant::TypeTag::vec);
-        assert(ptrs.back()->vec().size() == n);
-        (void)n;
-        ptrs.pop_back();
-        return true;
-    }
-
-    Variant var;
-    std::vector<Variant*> ptrs{&var};
-    std::string key;
-};
+using detail::FromJson;
 
 } // namespace
 
@@ -1026,10 +979,21 @@ Variant Variant::from(Value const& json) {
 }
 
 Variant Variant::fromJson(std::string const& json) {
+    return fromJson(json, NumberParsing::convert);
+}
+
+Variant Variant::fromJson(std::string const& json, NumberParsing numbers) {
     FromJson<rapidjson::UTF8<>> handler;
     rapidjson::Reader reader;
     rapidjson::StringStream ss(json.c_str());
-    reader.Parse(ss, handler);
+    switch (numbers) {
+    case NumberParsing::convert:
+        reader.Parse(ss, handler);
+        break;
+    case NumberParsing::keep_text:
+        reader.Parse<kParseNumbersAsStringsFlag>(ss, handler);
+        break;
+    }
     if (reader.HasParseError()) {
         throw std::runtime_error(rapidjson::GetParseError_En(reader.GetParseErrorCode()));
     }
@@ -1113,8 +1077,148 @@ struct Variant::Impl::ToJson {
             dst.EndObject(static_cast<unsigned int>(map->size()));
             break;
         }
+        case TypeTag::raw_json: {
+            auto const& json = reinterpret_cast<RawJson*>(var.value_.ptr)->json();
+            raw(dst, json, rawType(json), 0);
+            break;
+        }
+        case TypeTag::raw_number:
+            raw(dst, reinterpret_cast<RawNumber*>(var.value_.ptr)->text(), kNumberType, 0);
+            break;
+        }
+    }
+
+    template <class Handler>
+    static auto raw(Handler& dst, std::string const& json, Type type, int)
+            -> decltype(dst.RawValue(json.c_str(), json.size(), type), void()) {
+        dst.RawValue(json.c_str(), json.size(), type);
+    }
+
+    // Handlers building a DOM receive the SAX events of the text
+    template <class Handler>
+    static void raw(Handler& dst, std::string const& json, Type, long) {
+        Reader reader;
+        StringStream ss(json.c_str());
+        reader.Parse(ss, dst);
+    }
+
+    static Type rawType(std::string const& json) noexcept {
+        switch (json.front()) {
+        case '{':
+            return kObjectType;
+        case '[':
+            return kArrayType;
+        case '"':
+            return kStringType;
+        case 't':
+            return kTrueType;
+        case 'f':
+            return kFalseType;
+        case 'n':
+            return kNullType;
+        default:
+            return kNumberType;
+        }
+    }
+};
+
+struct Variant::Impl::ToCanonicalJson {
+    template <class Handler>
+    static void apply(Handler& dst, Variant const& var) {
+        switch (var.type_tag_) {
+        case TypeTag::null:
+            dst.Null();
+            break;
+        case TypeTag::boolean:
+            dst.Bool(var.value_.bool_);
+            break;
+        case TypeTag::char_:
+            dst.Int64(var.value_.char_);
+            break;
+        case TypeTag::int8:
+            dst.Int64(var.value_.int8);
+            break;
+        case TypeTag::uint8:
+            dst.Uint64(var.value_.uint8);
+            break;
+        case TypeTag::int16:
+            dst.Int64(var.value_.int16);
+            break;
+        case TypeTag::uint16:
+            dst.Uint64(var.value_.uint16);
+            break;
+        case TypeTag::int32:
+            dst.Int64(var.value_.int32);
+            break;
+        case TypeTag::uint32:
+            dst.Uint64(var.value_.uint32);
+            break;
+        case TypeTag::int64:
+            dst.Int64(var.value_.int64);
+            break;
+        case TypeTag::uint64:
+            dst.Uint64(var.value_.uint64);
+            break;
+        case TypeTag::double_:
+            number(dst, var.value_.double_);
+            break;
+        case TypeTag::string: {
+            auto const str = reinterpret_cast<std::string*>(var.value_.ptr);
+            dst.String(str->c_str(), static_cast<unsigned int>(str->size()), true);
+            break;
+        }
+        case TypeTag::vec: {
+            dst.StartArray();
+            auto const vec = reinterpret_cast<Variant::Vec*>(var.value_.ptr);
+            for (auto const& var : *vec) {
+                apply(dst, var);
+            }
+            dst.EndArray(static_cast<unsigned int>(vec->size()));
+            break;
+        }
+        case TypeTag::map: {
+            auto const map = reinterpret_cast<Variant::Map*>(var.value_.ptr);
+            std::vector<Map::const_pointer> members(map->size());
+            std::transform(map->begin(), map->end(), members.begin(), [](auto const& x) {
+                return std::addressof(x);
+            });
+            std::sort(members.begin(), members.end(), [](auto lhs, auto rhs) {
+                return lhs->first < rhs->first;
+            });
+            dst.StartObject();
+            for (auto const member : members) {
+                auto const& key = member->first;
+                dst.Key(key.c_str(), static_cast<unsigned int>(key.size()), true);
+                apply(dst, member->second);
+            }
+            dst.EndObject(static_cast<unsigned int>(members.size()));
+            break;
+        }
+        case TypeTag::raw_json:
+            apply(dst, reinterpret_cast<RawJson*>(var.value_.ptr)->parse());
+            break;
+        case TypeTag::raw_number:
+            apply(dst, reinterpret_cast<RawNumber*>(var.value_.ptr)->parse());
+            break;
         }
     }
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal" // exact integral check
+    template <class Handler>
+    static void number(Handler& dst, double x) {
+        // integral values in the range of the 64-bit integers, as they would be written
+        constexpr double int64_end = 9223372036854775808.0;
+        constexpr double uint64_end = 18446744073709551616.0;
+        if (std::trunc(x) != x || x >= uint64_end || x < -int64_end) {
+            dst.Double(x);
+        } else if (x < int64_end) {
+            dst.Int64(static_cast<int64_t>(x));
+        } else {
+            dst.Uint64(static_cast<uint64_t>(x));
+        }
+    }
+#pragma GCC diagnostic pop
 };
 
 rapidjson::Document& Variant::to(rapidjson::Document& json) const {
@@ -1137,6 +1241,13 @@ std::string Variant::toPrettyJson() const {
     return sb.GetString();
 }
 
+std::string Variant::toCanonicalJson() const {
+    rapidjson::StringBuffer sb;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(sb);
+    Impl::ToCanonicalJson::apply(writer, *this);
+    return sb.GetString();
+}
+
 std::ostream& operator<<(std::ostream& os, Variant const& var) {
     using TypeTag = Variant::TypeTag;
     switch (var.type_tag_) {
@@ -1199,6 +1310,12 @@ std::ostream& operator<<(std::ostream& os, Variant const& var) {
         os << "}";
         break;
     }
+    case TypeTag::raw_json:
+        os << reinterpret_cast<RawJson*>(var.value_.ptr)->json();
+        break;
+    case TypeTag::raw_number:
+        os << reinterpret_cast<RawNumber*>(var.value_.ptr)->text();
+        break;
     }
     return os;
 }
@@ -1238,6 +1355,10 @@ std::type_info const& Variant::typeInfo() const noexcept {
         return typeid(Vec);
     case TypeTag::map:
         return typeid(Map);
+    case TypeTag::raw_json:
+        return typeid(RawJson);
+    case TypeTag::raw_number:
+        return typeid(RawNumber);
     }
 }
 #pragma GCC diagnostic pop
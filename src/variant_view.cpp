@@ -0,0 +1,261 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/variant_view.hpp>
+
+#include <rapidjson/document.h>
+
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+
+namespace yenxo {
+
+Variant::TypeTag VariantView::type() const noexcept {
+    // the order of `rapidjson::Value::Accept`, which `Variant::from` relies on
+    switch (json_->GetType()) {
+    case rapidjson::kNullType:
+        return TypeTag::null;
+    case rapidjson::kFalseType:
+    case rapidjson::kTrueType:
+        return TypeTag::boolean;
+    case rapidjson::kObjectType:
+        return TypeTag::map;
+    case rapidjson::kArrayType:
+        return TypeTag::vec;
+    case rapidjson::kStringType:
+        return TypeTag::string;
+    case rapidjson::kNumberType:
+        if (json_->IsDouble()) {
+            return TypeTag::double_;
+        } else if (json_->IsInt()) {
+            return TypeTag::int32;
+        } else if (json_->IsUint()) {
+            return TypeTag::uint32;
+        } else if (json_->IsInt64()) {
+            return TypeTag::int64;
+        }
+        return TypeTag::uint64;
+    }
+    return TypeTag::null;
+}
+
+/// The value itself for scalars, an empty value of the same type otherwise
+Variant VariantView::scalar() const {
+    switch (type()) {
+    case TypeTag::boolean:
+        return Variant(json_->GetBool());
+    case TypeTag::int32:
+        return Variant(static_cast<int32_t>(json_->GetInt()));
+    case TypeTag::uint32:
+        return Variant(static_cast<uint32_t>(json_->GetUint()));
+    case TypeTag::int64:
+        return Variant(static_cast<int64_t>(json_->GetInt64()));
+    case TypeTag::uint64:
+        return Variant(static_cast<uint64_t>(json_->GetUint64()));
+    case TypeTag::double_:
+        return Variant(json_->GetDouble());
+    case TypeTag::string:
+        return Variant(std::string());
+    case TypeTag::vec:
+        return Variant(Variant::Vec());
+    case TypeTag::map:
+        return Variant(Variant::Map());
+    default:
+        return Variant();
+    }
+}
+
+bool VariantView::boolean() const {
+    return scalar().boolean();
+}
+
+char VariantView::character() const {
+    return scalar().character();
+}
+
+int8_t VariantView::int8() const {
+    return scalar().int8();
+}
+
+uint8_t VariantView::uint8() const {
+    return scalar().uint8();
+}
+
+int16_t VariantView::int16() const {
+    return scalar().int16();
+}
+
+uint16_t VariantView::uint16() const {
+    return scalar().uint16();
+}
+
+int32_t VariantView::int32() const {
+    return scalar().int32();
+}
+
+uint32_t VariantView::uint32() const {
+    return scalar().uint32();
+}
+
+int64_t VariantView::int64() const {
+    return scalar().int64();
+}
+
+uint64_t VariantView::uint64() const {
+    return scalar().uint64();
+}
+
+double VariantView::floating() const {
+    return scalar().floating();
+}
+
+std::string_view VariantView::str() const {
+    if (type() != TypeTag::string) {
+        scalar().str();
+    }
+    return {json_->GetString(), json_->GetStringLength()};
+}
+
+VariantView::Vec VariantView::vec() const {
+    if (type() != TypeTag::vec) {
+        scalar().vec();
+    }
+    return Vec(json_);
+}
+
+VariantView::Map VariantView::map() const {
+    if (type() != TypeTag::map) {
+        scalar().map();
+    }
+    return Map(json_);
+}
+
+Variant VariantView::variant() const {
+    return Variant::from(*json_);
+}
+
+std::ostream& operator<<(std::ostream& os, VariantView const& x) {
+    return os << x.variant();
+}
+
+std::size_t VariantView::Vec::size() const noexcept {
+    return json_->Size();
+}
+
+VariantView VariantView::Vec::operator[](std::size_t i) const noexcept {
+    return VariantView((*json_)[static_cast<rapidjson::SizeType>(i)]);
+}
+
+VariantView VariantView::Vec::at(std::size_t i) const {
+    if (i >= size()) {
+        throw std::out_of_range("VariantView::Vec::at");
+    }
+    return (*this)[i];
+}
+
+Variant VariantView::Vec::variant() const {
+    return Variant::from(*json_);
+}
+
+namespace {
+
+std::string_view name(rapidjson::Value const& json, uint32_t i) noexcept {
+    auto const& x = json.MemberBegin()[i].name;
+    return {x.GetString(), x.GetStringLength()};
+}
+
+} // namespace
+
+VariantView::Map::Map(rapidjson::Value const* json)
+        : json_(json) {
+    auto const n = json->MemberCount();
+    // a small object is checked pairwise without allocating
+    if (n <= 32) {
+        bool repeated = false;
+        for (uint32_t i = 0; i < n && !repeated; ++i) {
+            for (auto j = i + 1; j < n && !repeated; ++j) {
+                repeated = name(*json, i) == name(*json, j);
+            }
+        }
+        if (!repeated) {
+            return;
+        }
+    }
+
+    std::vector<std::pair<std::string_view, uint32_t>> names(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        names[i] = {name(*json, i), i};
+    }
+    std::sort(names.begin(), names.end());
+    Visible visible;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i + 1 == n || names[i + 1].first != names[i].first) {
+            visible.push_back(names[i].second);
+        }
+    }
+    if (visible.size() != n) {
+        std::sort(visible.begin(), visible.end());
+        visible_ = std::make_shared<Visible const>(std::move(visible));
+    }
+}
+
+std::size_t VariantView::Map::size() const noexcept {
+    return visible_ ? visible_->size() : json_->MemberCount();
+}
+
+VariantView::Map::value_type VariantView::Map::member(rapidjson::Value const* json,
+                                                      uint32_t i) noexcept {
+    auto const& x = json->MemberBegin()[i];
+    return {{x.name.GetString(), x.name.GetStringLength()}, VariantView(x.value)};
+}
+
+VariantView::Map::const_iterator VariantView::Map::find(std::string_view key) const
+        noexcept {
+    // the last of repeated keys is taken, as `Variant::from` does
+    for (auto i = json_->MemberCount(); i-- > 0;) {
+        if (name(*json_, i) == key) {
+            if (!visible_) {
+                return {*this, i};
+            }
+            auto const it = std::lower_bound(visible_->begin(), visible_->end(), i);
+            return {*this, static_cast<uint32_t>(it - visible_->begin())};
+        }
+    }
+    return end();
+}
+
+VariantView VariantView::Map::at(std::string_view key) const {
+    auto const it = find(key);
+    if (it == end()) {
+        throw std::out_of_range("VariantView::Map::at");
+    }
+    return it->second;
+}
+
+Variant VariantView::Map::variant() const {
+    return Variant::from(*json_);
+}
+
+} // namespace yenxo
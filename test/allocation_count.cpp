@@ -0,0 +1,204 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/variant_conversion.hpp>
+#include <yenxo/variant_traits.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+bool counting = false;
+std::size_t allocations = 0;
+
+template <class F>
+std::size_t countAllocations(F&& f) {
+    allocations = 0;
+    counting = true;
+    std::forward<F>(f)();
+    counting = false;
+    return allocations;
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (counting) {
+        ++allocations;
+    }
+    if (auto const p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+// the replaced operators below are a matching pair
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+using namespace yenxo;
+
+namespace {
+
+std::string const long_text = "a string that does not fit the small string buffer";
+
+struct Person : trait::Var<Person> {
+    BOOST_HANA_DEFINE_STRUCT(Person,
+                             (std::string, name),
+                             (int, age),
+                             (std::vector<int>, scores));
+};
+
+} // namespace
+
+TEST_CASE("Check toVariant allocations", "[allocation_count]") {
+    // `Variant` holds a string, a list or a map on the heap, so each node of the result
+    // is the holder plus what the container allocates itself, and nothing is copied
+
+    SECTION("collection") {
+        std::vector<int> const x{1, 2, 3};
+        // the list, its buffer
+        REQUIRE(countAllocations([&] { toVariant(x); }) == 2);
+    }
+
+    SECTION("map") {
+        std::unordered_map<std::string, int> const x{{"a", 1}, {"b", 2}};
+        // the map, its buckets, two nodes
+        REQUIRE(countAllocations([&] { toVariant(x); }) == 4);
+    }
+
+    SECTION("pair") {
+        std::pair<int, int> const x{1, 2};
+        // the map, its buckets, two nodes
+        REQUIRE(countAllocations([&] { toVariant(x); }) == 4);
+    }
+
+    SECTION("struct") {
+        Person x;
+        x.name = long_text;
+        x.age = 42;
+        x.scores = {1, 2, 3};
+        // the map, its buckets, three nodes; the string, its text; the list, its buffer
+        REQUIRE(countAllocations([&] { toVariant(x); }) == 9);
+    }
+}
+
+TEST_CASE("Check fromVariant allocations", "[allocation_count]") {
+    // Strings and containers of an expiring `Variant` are moved out, so each long text
+    // is one allocation less than for a copy
+
+    SECTION("string") {
+        Variant var(long_text);
+        REQUIRE(countAllocations([&] { fromVariant<std::string>(var); }) == 1);
+        REQUIRE(countAllocations([&] { fromVariant<std::string>(std::move(var)); }) == 0);
+    }
+
+    SECTION("collection") {
+        Variant var(VariantVec{Variant(long_text), Variant(long_text)});
+        // the buffer, two texts
+        REQUIRE(countAllocations([&] { fromVariant<std::vector<std::string>>(var); })
+                == 3);
+        // the buffer
+        REQUIRE(countAllocations([&] {
+                    fromVariant<std::vector<std::string>>(std::move(var));
+                })
+                == 1);
+    }
+
+    SECTION("map") {
+        Variant var(VariantMap{{"a", Variant(long_text)}});
+        using Map = std::unordered_map<std::string, std::string>;
+        // the buckets, the node, the text
+        REQUIRE(countAllocations([&] { fromVariant<Map>(var); }) == 3);
+        // the buckets, the node
+        REQUIRE(countAllocations([&] { fromVariant<Map>(std::move(var)); }) == 2);
+    }
+
+    SECTION("struct") {
+        Person x;
+        x.name = long_text;
+        x.age = 42;
+        x.scores = {1, 2, 3};
+        auto var = toVariant(x);
+        // the text, the buffer of the scores
+        REQUIRE(countAllocations([&] { fromVariant<Person>(var); }) == 2);
+        // the buffer of the scores
+        REQUIRE(countAllocations([&] { fromVariant<Person>(std::move(var)); }) == 1);
+    }
+}
+
+TEST_CASE("Check conversion error allocations", "[allocation_count]") {
+    auto const convert = [](auto type, Variant const& var) {
+        return [type, &var] {
+            try {
+                fromVariant<typename decltype(type)::type>(var);
+            } catch (VariantErr const&) {
+            }
+        };
+    };
+
+    SECTION("the message is not formatted unless asked for") {
+        REQUIRE(countAllocations(convert(boost::hana::type_c<int>, Variant("a"))) == 0);
+        REQUIRE(countAllocations(convert(boost::hana::type_c<int>, Variant())) == 0);
+        REQUIRE(countAllocations(convert(boost::hana::type_c<uint8_t>, Variant(300)))
+                == 0);
+    }
+
+    SECTION("a path frame is recorded without formatting") {
+        Variant const var(VariantVec{Variant(1), Variant("a")});
+        // the result buffer, the frame stack
+        REQUIRE(countAllocations(convert(boost::hana::type_c<std::vector<int>>, var))
+                == 2);
+    }
+}
+
+TEST_CASE("Check equal allocations", "[allocation_count]") {
+    VariantMap map;
+    for (int i = 0; i < 10; ++i) {
+        map.emplace(std::to_string(i) + long_text, Variant(i));
+    }
+    map.emplace("vec", Variant(VariantVec{Variant(1), Variant(2.5)}));
+    Variant const lhs(map);
+    map.at("vec") = Variant(VariantVec{Variant(int64_t(1)), Variant(2.5)});
+    Variant const rhs(map);
+    bool result = false;
+    REQUIRE(countAllocations([&] { result = equal(lhs, rhs); }) == 0);
+    REQUIRE(result);
+}
@@ -22,8 +22,11 @@
   SOFTWARE.
 */
 
+#include "matchers.hpp"
+
 #include <yenxo/define_enum.hpp>
 #include <yenxo/string_conversion.hpp>
+#include <yenxo/try_from_variant.hpp>
 #include <yenxo/variant_conversion.hpp>
 
 #include <catch2/catch.hpp>
@@ -74,6 +77,10 @@ DEFINE_ENUM(E,
             e31,
             e32);
 
+DEFINE_ENUM(Shared, (a, , "x", "y"), (b, , "y", "z"));
+
+DEFINE_FLAGS_ENUM(Permission, (none, 0), (read, 1), (write, 2, "w"), (exec, 4), (all, 7));
+
 } // namespace
 
 TEST_CASE("Check DEFINE_ENUM", "[define_enum]") {
@@ -254,3 +261,77 @@ TEST_CASE("Check DEFINE_ENUM", "[define_enum]") {
     os << E::e3;
     REQUIRE(os.str() == "e3");
 }
+
+TEST_CASE("Check enumFromString", "[define_enum]") {
+    static_assert(detail::enumSpellingCount<E1_1>() == 10);
+    static_assert(detail::enumSpellingCount<E>() == 32);
+
+    for (auto const e : EnumTraits<E>::values) {
+        REQUIRE(enumFromString<E>(toString(e)) == e);
+    }
+    REQUIRE(enumFromString<E1_1>("e_10") == E1_1::e1);
+    REQUIRE(enumFromString<E>("e5") == std::nullopt);
+    REQUIRE(enumFromString<E>("") == std::nullopt);
+
+    REQUIRE(enumFromString<Shared>("x") == Shared::a);
+    REQUIRE(enumFromString<Shared>("y") == Shared::a);
+    REQUIRE(enumFromString<Shared>("z") == Shared::b);
+}
+
+TEST_CASE("Check DEFINE_FLAGS_ENUM", "[define_enum]") {
+    static_assert(isFlagsEnum(boost::hana::type_c<Permission>));
+    static_assert(!isFlagsEnum(boost::hana::type_c<E>));
+    static_assert((Permission::read | Permission::write | Permission::exec)
+                  == Permission::all);
+    static_assert((Permission::all & ~Permission::write)
+                  == (Permission::read | Permission::exec));
+
+    auto p = Permission::read;
+    p |= Permission::exec;
+    p ^= Permission::read;
+    REQUIRE(p == Permission::exec);
+
+    SECTION("string") {
+        REQUIRE(toString(Permission::none) == "");
+        REQUIRE(toString(Permission::write | Permission::read) == "read|w");
+        REQUIRE(toString(Permission::all) == "read|w|exec");
+        REQUIRE_THROWS_AS(toString(Permission(8)), BadEnumValue);
+
+        REQUIRE(fromString<Permission>("") == Permission::none);
+        REQUIRE(fromString<Permission>("exec|read")
+                == (Permission::read | Permission::exec));
+        REQUIRE(fromString<Permission>("all") == Permission::all);
+        REQUIRE_THROWS_WITH(fromString<Permission>("read|"),
+                            "'read|' is not of type 'Permission'");
+        REQUIRE_THROWS_AS(fromString<Permission>("read|x"), StringConversionError);
+
+        std::ostringstream os;
+        os << (Permission::read | Permission::exec);
+        REQUIRE(os.str() == "read|exec");
+    }
+
+    SECTION("variant") {
+        REQUIRE(toVariant(Permission::none) == Variant(VariantVec{}));
+        REQUIRE(toVariant(Permission::read | Permission::exec)
+                == Variant(VariantVec{Variant("read"), Variant("exec")}));
+        REQUIRE_THROWS_AS(toVariant(Permission(16)), BadEnumValue);
+
+        REQUIRE(fromVariant<Permission>(
+                        Variant(VariantVec{Variant("w"), Variant("none")}))
+                == Permission::write);
+        REQUIRE(fromVariant<Permission>(toVariant(Permission::all)) == Permission::all);
+        REQUIRE_THROWS_MATCHES(
+                fromVariant<Permission>(
+                        Variant(VariantVec{Variant("read"), Variant("x")})),
+                VariantBadType,
+                ExceptionIs<VariantBadType>("'x' is not of type 'Permission'", "/1"));
+        REQUIRE_THROWS_AS(fromVariant<Permission>(Variant("read")), VariantBadType);
+
+        REQUIRE(tryFromVariant<Permission>(Variant(VariantVec{Variant("exec")})).value()
+                == Permission::exec);
+        auto const r = tryFromVariant<Permission>(Variant(VariantVec{Variant(1)}));
+        REQUIRE(!r);
+        REQUIRE(r.error().code() == VariantErrc::bad_type);
+        REQUIRE(r.error().path() == "/0");
+    }
+}
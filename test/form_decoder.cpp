@@ -0,0 +1,196 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/form_decoder.hpp>
+#include <yenxo/query_string.hpp>
+#include <yenxo/variant.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace yenxo;
+
+namespace {
+
+struct Login {
+    BOOST_HANA_DEFINE_STRUCT(Login,
+                             (std::string, user),
+                             (std::optional<bool>, remember),
+                             (std::vector<int>, ids));
+};
+
+FormDecoder::Options verbatimPlus() {
+    FormDecoder::Options ret;
+    ret.plus_as_space = false;
+    return ret;
+}
+
+Variant decodeSplit(FormDecoder& decoder, std::string const& str, std::size_t split) {
+    Variant ret;
+    decoder.start(ret);
+    decoder.feed(std::string_view(str).substr(0, split));
+    decoder.feed(std::string_view(str).substr(split));
+    decoder.finish();
+    return ret;
+}
+
+} // namespace
+
+TEST_CASE("Check FormDecoder", "[query]") {
+    SECTION("any split matches query_string") {
+        FormDecoder decoder(verbatimPlus());
+        for (std::string const str : {"a=1&b=2",
+                                      "a[]=1&a[]=2&a[5]=x&b=%20c%2Bd",
+                                      "o.x.y=1&o[z]=2&&e=&f=",
+                                      "x=a+b&k%5Bq%5D=%E2%82%AC",
+                                      "a=1&b=2|c=3&d=4"}) {
+            auto const expected = query_string(str);
+            for (std::size_t i = 0; i <= str.size(); ++i) {
+                CAPTURE(str, i);
+                REQUIRE(decodeSplit(decoder, str, i) == expected);
+            }
+        }
+    }
+
+    SECTION("byte by byte") {
+        std::string const str = "name=J%C3%B6rg+K&tags[]=a&tags[]=b";
+        FormDecoder decoder;
+        Variant out;
+        decoder.start(out);
+        for (char const c : str) {
+            decoder.feed(std::string_view(&c, 1));
+        }
+        decoder.finish();
+        Variant::Vec const tags{Variant("a"), Variant("b")};
+        Variant::Map const expected{{"name", Variant("J\xC3\xB6rg K")},
+                                    {"tags", Variant(tags)}};
+        REQUIRE(out == Variant(expected));
+    }
+
+    SECTION("plus as space") {
+        REQUIRE(decodeForm("a=b+c") == Variant(Variant::Map{{"a", Variant("b c")}}));
+        REQUIRE(decodeForm("a=b%2Bc") == Variant(Variant::Map{{"a", Variant("b+c")}}));
+        REQUIRE(decodeForm("a=b+c", verbatimPlus())
+                == Variant(Variant::Map{{"a", Variant("b+c")}}));
+    }
+
+    SECTION("reuse") {
+        FormDecoder decoder;
+        Variant out(1);
+        decoder.start(out);
+        decoder.feed("a=1&b");
+        decoder.start(out);
+        decoder.feed("c=2");
+        decoder.finish();
+        REQUIRE(out == Variant(Variant::Map{{"c", Variant("2")}}));
+    }
+
+    SECTION("parameter length") {
+        FormDecoder::Options options;
+        options.param_length = 4;
+        FormDecoder decoder(options);
+        Variant out;
+        decoder.start(out);
+        decoder.feed("a=12&b=");
+        REQUIRE_THROWS_AS(decoder.feed("345"), QueryStringError);
+        decoder.start(out);
+        REQUIRE_THROWS_AS(decoder.feed("a=123&b=1"), QueryStringError);
+        REQUIRE_THROWS_AS(decodeForm("a=1&bb=12345", options), QueryStringError);
+        REQUIRE_NOTHROW(decodeForm("a=12&b=12", options));
+    }
+
+    SECTION("limits") {
+        std::string str;
+        for (int i = 0; i < 500; ++i) {
+            str += "a[]=" + std::to_string(i) + "&";
+        }
+        REQUIRE(decodeForm(str).map().at("a").vec().size() == 500);
+        REQUIRE_THROWS_AS(query_string(str), QueryStringError);
+
+        FormDecoder::Options options;
+        options.array_length = 10;
+        REQUIRE_THROWS_AS(decodeForm(str, options), QueryStringError);
+    }
+
+    SECTION("malformed") {
+        FormDecoder decoder;
+        Variant out;
+        decoder.start(out);
+        decoder.feed("a=1&b[");
+        REQUIRE_THROWS_AS(decoder.finish(), QueryStringError);
+        REQUIRE_THROWS_AS(decodeForm("a=%G1"), QueryStringError);
+
+        // the error is placed in the whole body, as by `query_string`
+        std::string const str = "a=1&bb=2&c[";
+        std::size_t expected = 0;
+        try {
+            query_string(str);
+        } catch (QueryStringError const& e) {
+            expected = e.errorOffset();
+        }
+        REQUIRE(expected > 8);
+        for (std::size_t i = 0; i <= str.size(); ++i) {
+            CAPTURE(i);
+            std::size_t offset = 0;
+            try {
+                decodeSplit(decoder, str, i);
+            } catch (QueryStringError const& e) {
+                offset = e.errorOffset();
+            }
+            REQUIRE(offset == expected);
+        }
+    }
+
+    SECTION("struct") {
+        std::string const str = "user=J+Doe&remember=true&ids[]=1&ids[]=2";
+        for (std::size_t i = 0; i <= str.size(); ++i) {
+            CAPTURE(i);
+            FormDecoder decoder;
+            Login login;
+            decoder.start(login);
+            decoder.feed(std::string_view(str).substr(0, i));
+            decoder.feed(std::string_view(str).substr(i));
+            decoder.finish();
+            REQUIRE(login.user == "J Doe");
+            REQUIRE(login.remember == true);
+            REQUIRE(login.ids == std::vector<int>{1, 2});
+        }
+
+        FormDecoder decoder;
+        Login login;
+        decoder.start(login);
+        decoder.feed("remember=1");
+        REQUIRE_THROWS_AS(decoder.finish(), QueryStringError);
+
+        login.ids = {7};
+        decoder.start(login);
+        decoder.feed("user=x&ids[]=1");
+        decoder.finish();
+        REQUIRE(!login.remember);
+        REQUIRE(login.ids == std::vector<int>{1});
+    }
+}
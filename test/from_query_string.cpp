@@ -0,0 +1,266 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/define_enum.hpp>
+#include <yenxo/from_query_string.hpp>
+#include <yenxo/query_string.hpp>
+#include <yenxo/variant_traits.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace yenxo;
+using namespace std::string_literals;
+namespace hana = boost::hana;
+using namespace hana::literals;
+
+namespace {
+
+DEFINE_ENUM(Sort, (asc), (desc, , "descending"));
+DEFINE_FLAGS_ENUM(Field, (none, 0), (name, 1), (age, 2), (email, 4));
+
+struct Range {
+    BOOST_HANA_DEFINE_STRUCT(Range, (int, from), (std::optional<int>, to));
+};
+
+struct Item {
+    BOOST_HANA_DEFINE_STRUCT(Item, (std::string, id), (uint32_t, count));
+};
+
+struct Query {
+    static auto defaults() {
+        return hana::make_map(hana::make_pair("page"_s, 1),
+                              hana::make_pair("fields"_s, Field::none));
+    }
+
+    static constexpr auto names() {
+        return hana::make_map(hana::make_pair("page_size"_s, "page-size"));
+    }
+
+    BOOST_HANA_DEFINE_STRUCT(Query,
+                             (std::string, q),
+                             (int, page),
+                             (std::optional<uint16_t>, page_size),
+                             (double, ratio),
+                             (bool, exact),
+                             (Sort, sort),
+                             (Field, fields),
+                             (std::vector<std::string>, tag),
+                             (std::optional<Range>, range),
+                             (std::vector<Item>, item),
+                             (std::map<std::string, int>, weight));
+};
+
+struct LenientPolicy : trait::VarPolicy {
+    static auto constexpr empty_container_not_required = true;
+};
+
+template <class... Args>
+Query parse(Args&&... args) {
+    return fromQueryString<Query, LenientPolicy>(std::forward<Args>(args)...);
+}
+
+struct StrictPolicy : trait::VarPolicy {
+    static auto constexpr allow_additional_properties = false;
+    static auto constexpr empty_container_not_required = true;
+};
+
+struct Strict {
+    BOOST_HANA_DEFINE_STRUCT(Strict, (std::string, a), (std::vector<Range>, r));
+};
+
+struct TagPolicy : StrictPolicy {
+    static constexpr auto tag = "circle"_s;
+};
+
+struct Tagged {
+    BOOST_HANA_DEFINE_STRUCT(Tagged, (int, x));
+};
+
+struct Strings {
+    BOOST_HANA_DEFINE_STRUCT(Strings,
+                             (std::string, a),
+                             (std::vector<std::string>, b),
+                             (std::map<std::string, std::string>, c));
+};
+
+auto const required = "q=x&ratio=0.5&exact=false&sort=asc";
+
+} // namespace
+
+TEST_CASE("Check fromQueryString", "[query]") {
+    SECTION("scalars") {
+        auto const x = parse(
+                "q=a%20b+c&page=-3&page-size=50&ratio=2.5e-1&exact=true&sort=descending");
+        REQUIRE(x.q == "a b+c");
+        REQUIRE(x.page == -3);
+        REQUIRE(x.page_size == 50);
+        REQUIRE(x.ratio == 0.25);
+        REQUIRE(x.exact);
+        REQUIRE(x.sort == Sort::desc);
+        REQUIRE(x.fields == Field::none);
+        REQUIRE(x.tag.empty());
+        REQUIRE(!x.range);
+    }
+
+    SECTION("defaults and the last of repeated scalars") {
+        auto const x = parse(required + "&q=y"s);
+        REQUIRE(x.q == "y");
+        REQUIRE(x.page == 1);
+        REQUIRE(!x.page_size);
+    }
+
+    SECTION("flags") {
+        auto const x = parse(required + "&fields=name%7Cemail&fields=age"s);
+        REQUIRE(x.fields == (Field::name | Field::age | Field::email));
+    }
+
+    SECTION("sequences") {
+        auto const x = parse(required + "&tag=a&tag%5B%5D=b&tag[3]=d"s);
+        REQUIRE(x.tag == std::vector<std::string>{"a", "b", "", "d"});
+    }
+
+    SECTION("nested structs and maps") {
+        auto const x = parse(
+                required
+                + "&range[from]=1&item[1][id]=b&item[1][count]=2&item[0][id]=a"
+                  "&item[0][count]=1&weight[x]=3&weight%5By%5D=4"s);
+        REQUIRE(x.range);
+        REQUIRE(x.range->from == 1);
+        REQUIRE(!x.range->to);
+        REQUIRE(x.item.size() == 2);
+        REQUIRE(x.item[0].id == "a");
+        REQUIRE(x.item[0].count == 1);
+        REQUIRE(x.item[1].id == "b");
+        REQUIRE(x.item[1].count == 2);
+        REQUIRE(x.weight == std::map<std::string, int>{{"x", 3}, {"y", 4}});
+    }
+
+    SECTION("unknown parameters are skipped") {
+        REQUIRE_NOTHROW(parse(required + "&x=1&y[a][0]=2&z[]=3"s));
+    }
+
+    SECTION("bad values") {
+        REQUIRE_THROWS_WITH(parse(required + "&page=1x"s),
+                            "'1x' is not of type 'int32' for page");
+        REQUIRE_THROWS_WITH(parse(required + "&page-size=-1"s),
+                            "'-1' is not of type 'uint16' for page-size");
+        REQUIRE_THROWS_WITH(parse(required + "&exact=1"s),
+                            "'1' is not of type 'boolean' for exact");
+        REQUIRE_THROWS_WITH(parse(required + "&sort=up"s),
+                            "'up' is not of type 'Sort' for sort");
+        REQUIRE_THROWS_WITH(parse(required + "&item[0][count]=a"s),
+                            "'a' is not of type 'uint32' for item[0][count]");
+    }
+
+    SECTION("mixed types") {
+        REQUIRE_THROWS_WITH(parse(required + "&range=1"s),
+                            "mixed types for range: map and string");
+        REQUIRE_THROWS_WITH(parse(required + "&q[a]=1"s),
+                            "mixed types for q: map and string");
+        REQUIRE_THROWS_WITH(parse(required + "&tag[a]=1"s),
+                            "mixed types for tag: map and vec");
+        REQUIRE_THROWS_WITH(parse(required + "&range[0]=1"s),
+                            "mixed types for range: vec and map");
+    }
+
+    SECTION("missing members") {
+        REQUIRE_THROWS_WITH(parse("q=x"), "'ratio' is required");
+        REQUIRE_THROWS_WITH(parse(required + "&range[to]=1"s),
+                            "'from' is required for range");
+        REQUIRE_THROWS_WITH(parse(required + "&item[1][count]=1"s),
+                            "'count' is required for item[0]");
+    }
+
+    SECTION("limits") {
+        QueryStringParser parser({2, 2, 2});
+        REQUIRE_THROWS_WITH(parse(parser, required + "&tag[2]=a"s),
+                            "array index out of range [0, 1] for tag");
+        REQUIRE_THROWS_WITH(parse(parser, required + "&tag=a&tag=b&tag=c"s),
+                            "array length exceed 2 for tag");
+        REQUIRE_THROWS_WITH(
+                parse(parser, required + "&weight[a]=1&weight[b]=1&weight[c]=1"s),
+                "object property count exceed 2 for weight");
+        REQUIRE_THROWS_WITH(parse(parser, required + "&x[a][b][c]=1"s),
+                            "object depth limit exceed 2 for x");
+    }
+
+    SECTION("syntax errors") {
+        try {
+            parse("q=x&a[=1");
+            FAIL("no throw");
+        } catch (QueryStringError const& e) {
+            REQUIRE(e.isParseError());
+        }
+    }
+
+    SECTION("policy") {
+        auto const x =
+                fromQueryString<Strict, StrictPolicy>("a=1&r[1][from]=2&r[0][from]=1");
+        REQUIRE(x.a == "1");
+        REQUIRE(x.r.size() == 2);
+        REQUIRE(x.r[0].from == 1);
+        REQUIRE(x.r[1].from == 2);
+
+        REQUIRE_NOTHROW(fromQueryString<Strict, StrictPolicy>("a=1"));
+        REQUIRE_THROWS_WITH((fromQueryString<Strict, StrictPolicy>("a=1&b=2")),
+                            "'b' is unknown");
+        REQUIRE_THROWS_WITH((fromQueryString<Strict, StrictPolicy>("a=1&r[0][x]=2")),
+                            "'x' is unknown for r[0]");
+
+        // the members seen before the elements are moved by a growth stay seen
+        REQUIRE_THROWS_WITH((fromQueryString<Strict, StrictPolicy>(
+                                    "r[0][to]=1&r[3][from]=2&r[0][from]=1")),
+                            "'from' is required for r[1]");
+    }
+
+    SECTION("tag") {
+        REQUIRE(fromQueryString<Tagged, TagPolicy>("x=1&__tag=circle").x == 1);
+        REQUIRE_THROWS_WITH((fromQueryString<Tagged, TagPolicy>("x=1")),
+                            "'__tag' is required");
+        REQUIRE_THROWS_WITH(
+                (trait::fromVariantImpl<Tagged, TagPolicy>(query_string("x=1"))),
+                "'__tag' is required");
+        REQUIRE_THROWS_WITH((fromQueryString<Tagged, TagPolicy>("__tag=square&x=1")),
+                            "'square' is not of type 'circle literal' for __tag");
+        REQUIRE_THROWS_WITH((fromQueryString<Tagged, TagPolicy>("__tag[a]=circle&x=1")),
+                            "mixed types for __tag: map and string");
+    }
+
+    SECTION("same as fromVariantImpl of query_string") {
+        for (auto const str :
+             {"a=1&b=2&b=3&c[x]=4&c[y]=5", "a=%20&b[1]=x&b[0]=y", "a="}) {
+            auto const expected =
+                    trait::fromVariantImpl<Strings, LenientPolicy>(query_string(str));
+            auto const actual = fromQueryString<Strings, LenientPolicy>(str);
+            REQUIRE(actual.a == expected.a);
+            REQUIRE(actual.b == expected.b);
+            REQUIRE(actual.c == expected.c);
+        }
+    }
+}
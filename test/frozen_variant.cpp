@@ -0,0 +1,143 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/exception.hpp>
+#include <yenxo/frozen_variant.hpp>
+#include <yenxo/variant.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace yenxo;
+
+TEST_CASE("Check FrozenVariant", "[FrozenVariant]") {
+    auto const var = Variant::fromJson(R"({
+        "name": "config",
+        "port": 8080,
+        "ratio": 0.5,
+        "enabled": true,
+        "nothing": null,
+        "tags": ["a", "bb", "ccc"],
+        "nested": {"z": -1, "a": {"deep": [1, [2, 3], {}]}, "m": []}
+    })");
+
+    auto const frozen = var.freeze();
+    auto const root = frozen.root();
+
+    SECTION("scalars") {
+        REQUIRE(root.type() == Variant::TypeTag::map);
+        REQUIRE(!root.isScalar());
+        REQUIRE(root.map().at("name").str() == "config");
+        REQUIRE(root.map().at("port").uint16() == 8080);
+        REQUIRE(root.map().at("port").int64() == 8080);
+        REQUIRE(root.map().at("ratio").floating() == 0.5);
+        REQUIRE(root.map().at("enabled").boolean());
+        REQUIRE(root.map().at("nothing").null());
+    }
+
+    SECTION("errors are those of Variant") {
+        REQUIRE_THROWS_AS(root.map().at("port").int8(), VariantIntegralOverflow);
+        REQUIRE_THROWS_AS(root.map().at("nothing").int32(), VariantEmpty);
+        REQUIRE_THROWS_AS(root.map().at("name").int32(), VariantBadType);
+        REQUIRE_THROWS_AS(root.map().at("port").str(), VariantBadType);
+        REQUIRE_THROWS_AS(root.map().at("tags").map(), VariantBadType);
+        REQUIRE_THROWS_AS(root.vec(), VariantBadType);
+        REQUIRE_THROWS_AS(root.map().at("nothing").vec(), VariantEmpty);
+        REQUIRE_THROWS_WITH(root.map().at("tags").int32(),
+                            "expected 'int32', actual 'list of variant'");
+        REQUIRE_THROWS_AS(root.map().at("missing"), std::out_of_range);
+        REQUIRE_THROWS_AS(root.map().at("tags").vec().at(3), std::out_of_range);
+    }
+
+    SECTION("vec") {
+        auto const tags = root.map().at("tags").vec();
+        REQUIRE(tags.size() == 3);
+        REQUIRE(tags[1].str() == "bb");
+        std::vector<std::string> strs;
+        for (auto const x : tags) {
+            strs.emplace_back(x.str());
+        }
+        REQUIRE(strs == std::vector<std::string>{"a", "bb", "ccc"});
+        REQUIRE(tags.end() - tags.begin() == 3);
+    }
+
+    SECTION("map") {
+        auto const nested = root.map().at("nested").map();
+        REQUIRE(nested.size() == 3);
+        REQUIRE(nested.count("z") == 1);
+        REQUIRE(!nested.find("y"));
+        REQUIRE(nested.find("z")->int32() == -1);
+        REQUIRE(nested.at("m").vec().empty());
+
+        std::vector<std::string> keys;
+        for (auto const [key, x] : nested) {
+            keys.emplace_back(key);
+            (void)x;
+        }
+        REQUIRE(keys == std::vector<std::string>{"a", "m", "z"});
+
+        auto const deep = nested.at("a").map().at("deep").vec();
+        REQUIRE(deep.size() == 3);
+        REQUIRE(deep[0].int32() == 1);
+        REQUIRE(deep[1].vec()[1].int32() == 3);
+        REQUIRE(deep[2].map().empty());
+    }
+
+    SECTION("thaw") {
+        REQUIRE(frozen.thaw() == var);
+        REQUIRE(root.map().at("nested").thaw() == var.map().at("nested"));
+        REQUIRE(FrozenVariant().thaw() == Variant());
+        REQUIRE(Variant("x").freeze().thaw() == Variant("x"));
+    }
+
+    SECTION("copy, move and compare") {
+        auto copy = frozen;
+        REQUIRE(copy == frozen);
+        REQUIRE(copy.byteSize() == frozen.byteSize());
+        auto moved = std::move(copy);
+        REQUIRE(moved == frozen);
+        REQUIRE(moved.root().map().at("name").str() == "config");
+        REQUIRE(Variant(1).freeze() != Variant(2).freeze());
+        REQUIRE(Variant(1).freeze() != Variant(uint8_t(1)).freeze());
+    }
+
+    SECTION("moved from") {
+        auto source = frozen;
+        auto moved = std::move(source);
+        auto const copy = source;
+        REQUIRE(source.thaw() == Variant());
+        REQUIRE(copy.thaw() == Variant());
+        REQUIRE(copy == FrozenVariant());
+        REQUIRE(source.root().null());
+
+        source = std::move(moved);
+        REQUIRE(source == frozen);
+        auto& alias = source;
+        source = std::move(alias);
+        REQUIRE(source == frozen);
+        REQUIRE(source.thaw() == var);
+    }
+}
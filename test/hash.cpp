@@ -0,0 +1,153 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+// tested
+#include <yenxo/hash.hpp>
+
+// local
+#include <yenxo/comparison_traits.hpp>
+#include <yenxo/variant.hpp>
+
+// 3rd
+#include <catch2/catch.hpp>
+
+// std
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace yenxo;
+
+namespace {
+
+struct Point
+        : trait::Hash<Point>
+        , trait::EqualityComparison<Point> {
+    BOOST_HANA_DEFINE_STRUCT(Point, (int32_t, x), (int32_t, y));
+};
+
+struct Person
+        : trait::Hash<Person>
+        , trait::EqualityComparison<Person> {
+    BOOST_HANA_DEFINE_STRUCT(Person,
+                             (std::string, name),
+                             (std::optional<double>, height),
+                             (std::vector<Point>, path),
+                             (Variant, extra));
+};
+
+struct Pet {
+    YENXO_HASH_FUNCTION(Pet)
+    YENXO_EQUALITY_COMPARISON_OPERATORS(Pet)
+    BOOST_HANA_DEFINE_STRUCT(Pet,
+                             (std::string, name),
+                             (std::map<std::string, int>, tags));
+};
+
+Point point(int32_t x, int32_t y) {
+    Point ret;
+    ret.x = x;
+    ret.y = y;
+    return ret;
+}
+
+} // namespace
+
+YENXO_STD_HASH(Person)
+
+TEST_CASE("Check hashValue(Variant)", "[hash]") {
+    Variant::Map a;
+    Variant::Map b;
+    b.reserve(64);
+    for (int i = 0; i < 20; ++i) {
+        a.emplace(std::to_string(i), Variant(i));
+    }
+    for (int i = 20; i--;) {
+        b.emplace(std::to_string(i), Variant(i));
+    }
+    REQUIRE(Variant(a) == Variant(b));
+    REQUIRE(hashValue(Variant(a)) == hashValue(Variant(b)));
+
+    b["5"] = Variant(6);
+    REQUIRE(hashValue(Variant(a)) != hashValue(Variant(b)));
+
+    Variant const nested(Variant::Vec{Variant(a), Variant("x"), Variant()});
+    REQUIRE(hashValue(nested) == hashValue(Variant(nested)));
+    REQUIRE(hashValue(Variant(0.0)) == hashValue(Variant(-0.0)));
+    REQUIRE(hashValue(Variant(Variant::Vec{Variant(1), Variant(2)}))
+            != hashValue(Variant(Variant::Vec{Variant(2), Variant(1)})));
+    REQUIRE(hashValue(Variant("1")) != hashValue(Variant(1)));
+
+    std::unordered_set<Variant> set{Variant(a), Variant(b), Variant(a), nested};
+    REQUIRE(set.size() == 3);
+    REQUIRE(set.count(Variant(a)));
+}
+
+TEST_CASE("Check hashOf", "[hash]") {
+    REQUIRE(hashOf(std::string("abc")) == hashOf(std::string_view("abc")));
+    REQUIRE(hashOf(std::vector<int>{1, 2}) != hashOf(std::vector<int>{2, 1}));
+    REQUIRE(hashOf(std::optional<int>()) != hashOf(std::optional<int>(0)));
+
+    std::unordered_map<std::string, int> a;
+    std::unordered_map<std::string, int> b(128);
+    for (int i = 0; i < 20; ++i) {
+        a.emplace(std::to_string(i), i);
+        b.emplace(std::to_string(19 - i), 19 - i);
+    }
+    REQUIRE(hashOf(a) == hashOf(b));
+}
+
+TEST_CASE("Check trait::Hash", "[hash]") {
+    Point const p = point(1, 2);
+    REQUIRE(hashValue(p) == hashValue(point(1, 2)));
+    REQUIRE(hashValue(p) != hashValue(point(2, 1)));
+
+    Person person;
+    person.name = "Efendi";
+    person.height = 1.8;
+    person.path = {p, p};
+    person.extra = Variant(Variant::Map{{"a", Variant(1)}});
+    Person other = person;
+    REQUIRE(hashValue(person) == hashValue(other));
+    other.path.push_back(p);
+    REQUIRE(hashValue(person) != hashValue(other));
+
+    std::unordered_set<Person> set{person, other, person};
+    REQUIRE(set.size() == 2);
+
+    std::unordered_set<Point, Hash> points{p, p, point(3, 4)};
+    REQUIRE(points.size() == 2);
+}
+
+TEST_CASE("Check YENXO_HASH_FUNCTION", "[hash]") {
+    Pet const x{"Rex", {{"dog", 1}}};
+    Pet const y{"Rex", {{"dog", 1}}};
+    Pet const z{"Rex", {{"dog", 2}}};
+    REQUIRE(hashValue(x) == hashValue(y));
+    REQUIRE(hashValue(x) != hashValue(z));
+    REQUIRE(hashOf(std::vector<Pet>{x, z}) == hashOf(std::vector<Pet>{y, z}));
+}
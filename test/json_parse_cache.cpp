@@ -0,0 +1,107 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/json_parse_cache.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace yenxo;
+
+TEST_CASE("Check JsonParseCache", "[json_parse_cache]") {
+    SECTION("repeated input shares the document") {
+        JsonParseCache cache;
+        auto const a = cache.parse(R"({"x": [1, 2]})");
+        auto const b = cache.parse(std::string(R"({"x": [1, 2]})"));
+        REQUIRE(a == b);
+        REQUIRE(*a == Variant::fromJson(R"({"x": [1, 2]})"));
+        REQUIRE(cache.size() == 1);
+        REQUIRE(cache.byteSize() == 13);
+
+        auto const c = cache.parse(R"({"x": [1, 3]})");
+        REQUIRE(c != a);
+        REQUIRE(cache.size() == 2);
+    }
+
+    SECTION("least recently used is evicted") {
+        JsonParseCache cache({2, 1024});
+        auto const a = cache.parse("[1]");
+        auto const b = cache.parse("[2]");
+        REQUIRE(cache.parse("[1]") == a);
+        cache.parse("[3]");
+        REQUIRE(cache.size() == 2);
+        REQUIRE(cache.parse("[1]") == a);
+        REQUIRE(cache.parse("[2]") != b);
+    }
+
+    SECTION("byte capacity") {
+        JsonParseCache cache({100, 8});
+        cache.parse("[1,2]");
+        cache.parse("[3,4]");
+        REQUIRE(cache.size() == 1);
+        REQUIRE(cache.byteSize() == 5);
+        auto const big = cache.parse("[1,2,3,4,5]");
+        REQUIRE(*big == Variant::fromJson("[1,2,3,4,5]"));
+        REQUIRE(cache.size() == 1);
+        REQUIRE(cache.parse("[1,2,3,4,5]") != big);
+    }
+
+    SECTION("number parsing") {
+        JsonParseCache cache({}, Variant::NumberParsing::keep_text);
+        REQUIRE(cache.parse("1.50")->type() == Variant::TypeTag::raw_number);
+    }
+
+    SECTION("errors are not cached") {
+        JsonParseCache cache;
+        REQUIRE_THROWS_AS(cache.parse("{abc"), std::runtime_error);
+        REQUIRE(cache.size() == 0);
+        cache.clear();
+        REQUIRE(cache.byteSize() == 0);
+    }
+
+    SECTION("threads") {
+        JsonParseCache cache({4, 1024});
+        std::atomic<int> mismatches{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&cache, &mismatches] {
+                for (int i = 0; i < 200; ++i) {
+                    auto const json = "[" + std::to_string(i % 8) + "]";
+                    if (!equal(cache.parse(json)->vec().at(0), Variant(i % 8))) {
+                        ++mismatches;
+                    }
+                }
+            });
+        }
+        for (auto& x : threads) {
+            x.join();
+        }
+        REQUIRE(mismatches == 0);
+        REQUIRE(cache.size() <= 4);
+    }
+}
@@ -0,0 +1,179 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/json_patch.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <utility>
+
+using namespace yenxo;
+
+namespace {
+
+Variant json(std::string const& x) {
+    return Variant::fromJson(x);
+}
+
+Variant patched(std::string const& target, std::string const& patch) {
+    auto ret = json(target);
+    apply(ret, json(patch));
+    return ret;
+}
+
+} // namespace
+
+TEST_CASE("Check apply", "[json_patch]") {
+    SECTION("add") {
+        REQUIRE(patched(R"({"a":1})", R"([{"op":"add","path":"/b","value":[2]}])")
+                == json(R"({"a":1,"b":[2]})"));
+        REQUIRE(patched(R"({"a":[1,3]})", R"([{"op":"add","path":"/a/1","value":2}])")
+                == json(R"({"a":[1,2,3]})"));
+        REQUIRE(patched(R"({"a":[1]})", R"([{"op":"add","path":"/a/-","value":2}])")
+                == json(R"({"a":[1,2]})"));
+        REQUIRE(patched(R"({"a":1})", R"([{"op":"add","path":"/a","value":2}])")
+                == json(R"({"a":2})"));
+        REQUIRE(patched(R"({"a":1})", R"([{"op":"add","path":"","value":[]}])")
+                == json(R"([])"));
+        REQUIRE(patched(R"({})", R"([{"op":"add","path":"/a~1b~0","value":1}])")
+                == json(R"({"a/b~":1})"));
+    }
+
+    SECTION("remove and replace") {
+        REQUIRE(patched(R"({"a":1,"b":2})", R"([{"op":"remove","path":"/a"}])")
+                == json(R"({"b":2})"));
+        REQUIRE(patched(R"([1,2,3])", R"([{"op":"remove","path":"/1"}])")
+                == json(R"([1,3])"));
+        REQUIRE(patched(R"({"a":{"b":1}})",
+                        R"([{"op":"replace","path":"/a/b","value":"x"}])")
+                == json(R"({"a":{"b":"x"}})"));
+    }
+
+    SECTION("move and copy") {
+        REQUIRE(patched(R"({"a":{"b":1},"c":[]})",
+                        R"([{"op":"move","from":"/a/b","path":"/c/0"}])")
+                == json(R"({"a":{},"c":[1]})"));
+        REQUIRE(patched(R"([1,2,3])", R"([{"op":"move","from":"/0","path":"/2"}])")
+                == json(R"([2,3,1])"));
+        REQUIRE(patched(R"({"a":[1]})", R"([{"op":"copy","from":"/a","path":"/b"}])")
+                == json(R"({"a":[1],"b":[1]})"));
+    }
+
+    SECTION("test") {
+        REQUIRE(patched(R"({"a":[1,"x"]})",
+                        R"([{"op":"test","path":"/a","value":[1,"x"]}])")
+                == json(R"({"a":[1,"x"]})"));
+        REQUIRE_THROWS_AS(
+                patched(R"({"a":1})", R"([{"op":"test","path":"/a","value":2}])"),
+                JsonPatchError);
+        REQUIRE_THROWS_AS(
+                patched(R"({"a":true})", R"([{"op":"test","path":"/a","value":1}])"),
+                JsonPatchError);
+        REQUIRE_THROWS_AS(
+                patched(R"({"a":[0]})", R"([{"op":"test","path":"/a","value":[false]}])"),
+                JsonPatchError);
+        REQUIRE_THROWS_AS(
+                patched(R"({"a":1})", R"([{"op":"test","path":"/a","value":1.0}])"),
+                JsonPatchError);
+    }
+
+    SECTION("errors") {
+        auto const fails = [](std::string const& target, std::string const& patch) {
+            try {
+                patched(target, patch);
+            } catch (JsonPatchError const& e) {
+                return e.operation();
+            }
+            return std::size_t(-1);
+        };
+        REQUIRE(fails(R"({})", R"([{"op":"add","path":"/a/b","value":1}])") == 0);
+        REQUIRE(fails(R"({})", R"([{"op":"add","path":"/a","value":1},
+                                   {"op":"remove","path":"/b"}])")
+                == 1);
+        REQUIRE(fails(R"([1])", R"([{"op":"add","path":"/2","value":1}])") == 0);
+        REQUIRE(fails(R"([1])", R"([{"op":"replace","path":"/01","value":1}])") == 0);
+        REQUIRE(fails(R"([1])", R"([{"op":"replace","path":"/-","value":1}])") == 0);
+        REQUIRE(fails(R"({"a":1})", R"([{"op":"add","path":"/a/b","value":1}])") == 0);
+        REQUIRE(fails(R"({"a":{}})", R"([{"op":"move","from":"/a","path":"/a/b"}])")
+                == 0);
+        REQUIRE(fails(R"({})", R"([{"op":"add","path":"a","value":1}])") == 0);
+        REQUIRE(fails(R"({})", R"([{"op":"add","path":"/a~2","value":1}])") == 0);
+        REQUIRE(fails(R"({})", R"([{"op":"add","path":"/a"}])") == 0);
+        REQUIRE(fails(R"({})", R"([{"op":"patch","path":"/a"}])") == 0);
+        REQUIRE(fails(R"({})", R"({"op":"add","path":"/a","value":1})") == 0);
+    }
+
+    SECTION("moving the patch values") {
+        Variant target = json(R"({"a":[1]})");
+        Variant patch =
+                json(R"([{"op":"add","path":"/b","value":"a long string value"}])");
+        apply(target, std::move(patch));
+        REQUIRE(target == json(R"({"a":[1],"b":"a long string value"})"));
+    }
+}
+
+TEST_CASE("Check diff", "[json_patch]") {
+    SECTION("round trip") {
+        std::pair<char const*, char const*> const cases[] = {
+                {R"({"a":1,"b":[1,2,3],"c":{"d":"e"}})",
+                 R"({"c":{"d":"e"},"b":[1,2,3],"a":1})"},
+                {R"({"a":1,"b":2})", R"({"b":3,"c":4})"},
+                {R"({"a":{"b":{"c":[1,{"d":1}]}}})", R"({"a":{"b":{"c":[1,{"d":2}]}}})"},
+                {R"([1,2,3,4,5])", R"([1,3,4,6,7,5])"},
+                {R"([1,2,3])", R"([])"},
+                {R"([])", R"([1,[2],{"a":3}])"},
+                {R"([[1],[2]])", R"([[1],[3],[2]])"},
+                {R"({"a/b":1,"c~":2})", R"({"a/b":2,"c~":[]})"},
+                {R"({"a":1})", R"([1])"},
+                {R"("x")", R"(null)"},
+                {R"({"a":[1,1,1]})", R"({"a":[1,1]})"},
+        };
+        for (auto const& [from, to] : cases) {
+            CAPTURE(from, to);
+            auto target = json(from);
+            auto const patch = diff(target, json(to));
+            apply(target, patch);
+            REQUIRE(target == json(to));
+        }
+    }
+
+    SECTION("minimal") {
+        REQUIRE(diff(json(R"({"a":[1,2]})"), json(R"({"a":[1,2]})")) == json("[]"));
+        REQUIRE(diff(json(R"([1,2,3,4])"), json(R"([1,2,9,3,4])"))
+                == json(R"([{"op":"add","path":"/2","value":9}])"));
+        REQUIRE(diff(json(R"([1,2,3,4])"), json(R"([1,3,4])"))
+                == json(R"([{"op":"remove","path":"/1"}])"));
+        REQUIRE(diff(json(R"({"a":{"b":1,"c":2},"d":1})"),
+                     json(R"({"a":{"b":1,"c":3},"d":1})"))
+                == json(R"([{"op":"replace","path":"/a/c","value":3}])"));
+        REQUIRE(diff(json(R"({"a":1,"b":2})"), json(R"({"c":1,"b":2})"))
+                == json(R"([{"op":"remove","path":"/a"},
+                             {"op":"add","path":"/c","value":1}])"));
+        REQUIRE(diff(json(R"({"a":1})"), json(R"({"a":"1"})"))
+                == json(R"([{"op":"replace","path":"/a","value":"1"}])"));
+        REQUIRE(diff(json("1"), json("2"))
+                == json(R"([{"op":"replace","path":"","value":2}])"));
+    }
+}
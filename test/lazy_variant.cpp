@@ -0,0 +1,116 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/exception.hpp>
+#include <yenxo/lazy_variant.hpp>
+#include <yenxo/variant.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace yenxo;
+
+TEST_CASE("Check LazyVariant", "[LazyVariant]") {
+    std::string const json = R"({
+        "id": 42,
+        "neg": -7,
+        "big": 18446744073709551615,
+        "ratio": 0.25,
+        "ok": false,
+        "none": null,
+        "plain": "text",
+        "esc\"aped": "line\nbreak é",
+        "list": [1, "two", [3], {"four": 4}],
+        "obj": {"a": {"b": [true]}},
+        "dup": 1,
+        "dup": 2
+    })";
+
+    auto const eager = Variant::fromJson(json);
+    auto const lazy = LazyVariant::fromJson(json);
+    auto const root = lazy.root();
+
+    SECTION("scalars match eager parsing") {
+        auto const map = root.map();
+        REQUIRE(map.at("id").type() == eager.map().at("id").type());
+        REQUIRE(map.at("id").int32() == 42);
+        REQUIRE(map.at("neg").type() == Variant::TypeTag::int32);
+        REQUIRE(map.at("big").uint64() == eager.map().at("big").uint64());
+        REQUIRE(map.at("ratio").floating() == 0.25);
+        REQUIRE(!map.at("ok").boolean());
+        REQUIRE(map.at("none").null());
+        REQUIRE(map.at("plain").str() == "text");
+        REQUIRE(map.at("esc\"aped").str() == eager.map().at("esc\"aped").str());
+    }
+
+    SECTION("errors match eager parsing") {
+        auto const map = root.map();
+        REQUIRE_THROWS_AS(map.at("neg").uint32(), VariantIntegralOverflow);
+        REQUIRE_THROWS_AS(map.at("none").int32(), VariantEmpty);
+        REQUIRE_THROWS_WITH(map.at("list").str(), "expected 'string', actual 'list of variant'");
+        REQUIRE_THROWS_AS(map.at("plain").map(), VariantBadType);
+        REQUIRE_THROWS_AS(map.at("id").vec(), VariantBadType);
+        REQUIRE_THROWS_AS(map.at("missing"), std::out_of_range);
+        REQUIRE_THROWS_AS(LazyVariant::fromJson("{\"a\": }"), std::runtime_error);
+    }
+
+    SECTION("containers") {
+        auto const list = root.map().at("list").vec();
+        REQUIRE(list.size() == 4);
+        REQUIRE(list.at(1).str() == "two");
+        REQUIRE(list.at(2).vec().at(0).int32() == 3);
+        REQUIRE(list.at(3).map().at("four").int32() == 4);
+        std::vector<Variant::TypeTag> types;
+        for (auto const x : list) {
+            types.push_back(x.type());
+        }
+        REQUIRE(types.size() == 4);
+        REQUIRE(types[1] == Variant::TypeTag::string);
+
+        REQUIRE(root.map().at("obj").map().at("a").map().at("b").vec().at(0).boolean());
+        REQUIRE(root.map().at("list").variant() == eager.map().at("list"));
+    }
+
+    SECTION("repeated keys") {
+        auto const map = root.map();
+        REQUIRE(map.size() == eager.map().size());
+        REQUIRE(map.at("dup").int32() == eager.map().at("dup").int32());
+        std::size_t n = 0;
+        for (auto const [key, x] : map) {
+            REQUIRE(eager.map().at(std::string(key)) == x.variant());
+            ++n;
+        }
+        REQUIRE(n == eager.map().size());
+    }
+
+    SECTION("whole document") {
+        REQUIRE(lazy.variant() == eager);
+        REQUIRE(lazy.toJson() == eager.toJson());
+        REQUIRE(LazyVariant::fromJson("[]").root().vec().empty());
+        REQUIRE(LazyVariant::fromJson(" \"x\" ").root().str() == "x");
+        REQUIRE(LazyVariant::fromJson("12").root().int32() == 12);
+    }
+}
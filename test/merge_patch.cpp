@@ -0,0 +1,112 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/merge_patch.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <utility>
+
+using namespace yenxo;
+
+namespace {
+
+Variant json(std::string const& x) {
+    return Variant::fromJson(x);
+}
+
+} // namespace
+
+TEST_CASE("Check mergePatch", "[merge_patch]") {
+    SECTION("RFC 7396 examples") {
+        // target, patch, result
+        char const* const cases[][3] = {
+                {R"({"a":"b"})", R"({"a":"c"})", R"({"a":"c"})"},
+                {R"({"a":"b"})", R"({"b":"c"})", R"({"a":"b","b":"c"})"},
+                {R"({"a":"b"})", R"({"a":null})", R"({})"},
+                {R"({"a":"b","b":"c"})", R"({"a":null})", R"({"b":"c"})"},
+                {R"({"a":["b"]})", R"({"a":"c"})", R"({"a":"c"})"},
+                {R"({"a":"c"})", R"({"a":["b"]})", R"({"a":["b"]})"},
+                {R"({"a":{"b":"c"}})",
+                 R"({"a":{"b":"d","c":null}})",
+                 R"({"a":{"b":"d"}})"},
+                {R"({"a":[{"b":"c"}]})", R"({"a":[1]})", R"({"a":[1]})"},
+                {R"(["a","b"])", R"(["c","d"])", R"(["c","d"])"},
+                {R"({"a":"b"})", R"(["c"])", R"(["c"])"},
+                {R"({"a":"foo"})", R"(null)", R"(null)"},
+                {R"({"a":"foo"})", R"("bar")", R"("bar")"},
+                {R"({"e":null})", R"({"a":1})", R"({"e":null,"a":1})"},
+                {R"([1,2])", R"({"a":"b","c":null})", R"({"a":"b"})"},
+                {R"({})", R"({"a":{"bb":{"ccc":null}}})", R"({"a":{"bb":{}}})"},
+        };
+        for (auto const& [target, patch, result] : cases) {
+            CAPTURE(target, patch);
+            auto moved = json(target);
+            mergePatch(moved, json(patch));
+            REQUIRE(moved == json(result));
+
+            auto copied = json(target);
+            auto const patch_var = json(patch);
+            mergePatch(copied, patch_var);
+            REQUIRE(copied == json(result));
+            REQUIRE(patch_var == json(patch));
+        }
+    }
+
+    SECTION("subtrees are moved") {
+        auto target = json(R"({"a":{"b":1}})");
+        auto patch = json(R"({"a":{"c":"a string longer than the small buffer"},
+                               "d":{"e":"another long string that is not copied"}})");
+        auto const c = patch.map().at("a").map().at("c").str().data();
+        auto const d = &patch.map().at("d");
+        auto const e = d->map().at("e").str().data();
+        mergePatch(target, std::move(patch));
+        REQUIRE(target.map().at("a").map().at("c").str().data() == c);
+        REQUIRE(&target.map().at("d") == d);
+        REQUIRE(target.map().at("d").map().at("e").str().data() == e);
+    }
+}
+
+TEST_CASE("Check merge", "[merge_patch]") {
+    auto const target = json(R"({"a":[1,{"x":1}],"b":{"c":1},"n":1})");
+    auto const source = json(R"({"a":[2,{"y":2},3],"b":{"d":2},"n":null})");
+    auto const merged = [&](MergeOptions const& options) {
+        auto ret = target;
+        merge(ret, source, options);
+        return ret;
+    };
+
+    REQUIRE(merged({}) == json(R"({"a":[2,{"y":2},3],"b":{"c":1,"d":2},"n":null})"));
+    REQUIRE(merged({ArrayMerge::append, false})
+            == json(R"({"a":[1,{"x":1},2,{"y":2},3],"b":{"c":1,"d":2},"n":null})"));
+    REQUIRE(merged({ArrayMerge::merge_elements, true})
+            == json(R"({"a":[2,{"x":1,"y":2},3],"b":{"c":1,"d":2}})"));
+
+    auto x = json(R"({"a":[1]})");
+    merge(x, json(R"({"a":{"b":2}})"), {ArrayMerge::append, false});
+    REQUIRE(x == json(R"({"a":{"b":2}})"));
+    merge(x, json(R"([1])"), {ArrayMerge::append, false});
+    REQUIRE(x == json(R"([1])"));
+}
@@ -0,0 +1,89 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+// Built with exceptions disabled, checks that the non-throwing conversion is usable there
+
+#include <yenxo/try_from_variant.hpp>
+#include <yenxo/variant_traits.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace yenxo;
+
+namespace {
+
+struct Point : trait::Var<Point> {
+    BOOST_HANA_DEFINE_STRUCT(Point, (int, x), (std::optional<int>, y));
+};
+
+int failures = 0;
+
+void check(bool x, char const* what) {
+    if (!x) {
+        std::fprintf(stderr, "failed: %s\n", what);
+        ++failures;
+    }
+}
+
+#define CHECK(...) check(__VA_ARGS__, #__VA_ARGS__)
+
+} // namespace
+
+int main() {
+    CHECK(tryFromVariant<int>(Variant(1)).value() == 1);
+    CHECK(tryFromVariant<uint8_t>(Variant(256)).error().code()
+          == VariantErrc::integral_overflow);
+
+    auto const points = tryFromVariant<std::vector<Point>>(Variant::fromJson(R"(
+        [{"x": 1}, {"x": 2, "y": 3}]
+    )"));
+    CHECK(points && points->at(1).y == 3);
+
+    auto const bad = tryFromVariant<std::map<std::string, Point>>(Variant::fromJson(R"(
+        {"a": {"x": 1, "y": "1"}}
+    )"));
+    CHECK(!bad);
+    CHECK(bad.error().code() == VariantErrc::bad_type);
+    CHECK(bad.error().path() == "/a/y");
+    CHECK(bad.error().message() == "expected 'int32', actual 'string'");
+
+    auto const missing = tryFromVariant<Point>(Variant(VariantMap{}));
+    CHECK(missing.error().code() == VariantErrc::missing_member);
+    CHECK(missing.error().message() == "'x' is required");
+
+    CHECK(tryFromVariant<RawNumber>(Variant(5)).value().text() == "5");
+    CHECK(tryFromVariant<RawNumber>(Variant("5")).error().code()
+          == VariantErrc::bad_type);
+    CHECK(tryFromVariant<RawJson>(Variant(VariantVec{})).value().json() == "[]");
+
+    using Tuple = decltype(boost::hana::make_tuple(1, std::string()));
+    CHECK(tryFromVariant<Tuple>(Variant::fromJson("[1]")).error().code()
+          == VariantErrc::bad_size);
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
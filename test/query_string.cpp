@@ -28,8 +28,10 @@
 #include <catch2/catch.hpp>
 
 #include <regex>
+#include <string>
 
 using namespace yenxo;
+using namespace std::string_literals;
 
 std::string operator""_b(char const* str, size_t s) {
     std::string ret(str, s);
@@ -289,3 +291,128 @@ TEST_CASE("Check query_string", "[query]") {
                             R"(mixed types for a: vec and map)");
     }
 }
+
+TEST_CASE("Check QueryStringParser", "[query]") {
+    SECTION("default limits match query_string") {
+        QueryStringParser parser;
+        REQUIRE(parser.limits().array_length == 20);
+        REQUIRE(parser.parse("a[x]=1&b=2&b=3"_b) == query_string("a[x]=1&b=2&b=3"_b));
+    }
+
+    SECTION("reuse") {
+        QueryStringParser parser;
+        Variant out;
+        parser.parse("a=1&b=2", out);
+        REQUIRE(out == R"({"a": "1", "b": "2"})"_j);
+        parser.parse("c[]=3"_b, out);
+        REQUIRE(out == R"({"c": ["3"]})"_j);
+        REQUIRE_THROWS_WITH(parser.parse("a[[x]=1", out),
+                            R"(expecting <close_bracket> here: "[x]=1")");
+        parser.parse("", out);
+        REQUIRE(out == R"({})"_j);
+    }
+
+    SECTION("configured limits") {
+        QueryStringParser parser({2, 1, 3});
+        REQUIRE(parser.parse("a=1&a=2&b[x]=1"_b)
+                == R"({"a": ["1", "2"], "b": {"x": "1"}})"_j);
+        REQUIRE_THROWS_WITH(parser.parse("a=1&a=2&a=3"), "array length exceed 2 for a");
+        REQUIRE_THROWS_WITH(parser.parse("a[2]=1"_b),
+                            "array index out of range [0, 1] for a");
+        REQUIRE_THROWS_WITH(parser.parse("a[x][y]=1"_b),
+                            "object depth limit exceed 1 for a");
+        REQUIRE_THROWS_WITH(parser.parse("a=1&b=1&c=1&d=1"),
+                            "object property count limit exceed 3");
+
+        QueryStringParser big({1000, 20, 20});
+        REQUIRE(big.parse("a[999]=1"_b).map().at("a").vec().size() == 1000);
+    }
+}
+
+TEST_CASE("Check QueryStringParser against the Spirit grammar", "[query]") {
+    auto const inputs = {
+            ""s,
+            "&"s,
+            "&&x&"s,
+            "&&x=&"s,
+            "&&=x&"s,
+            "a=b c"s,
+            "a=b=c&d=e"s,
+            "a=1&b"s,
+            "a"s,
+            "=a"s,
+            "a=="s,
+            "a= "s,
+            "a%5"s,
+            "a=%4"s,
+            "a=%4g"s,
+            "a%41b=%41%42"s,
+            "a%5x=x"s,
+            "a[b[=x"s,
+            "a[[x]=1"s,
+            "a[b]]=x"s,
+            "a]b=x"s,
+            "a[][u]=b"s,
+            "a[]=1&a[]=2&a=3"s,
+            "a[1a]=1"s,
+            "a[+1]=1"s,
+            "a[007]=1"s,
+            "a[1%5d=1"s,
+            "a%5B1%5D=1"s,
+            "a[%30]=1"s,
+            "a[x][1][y][]=1"s,
+            "a[99999999999999999999999]=1"s,
+            "a[18446744073709551615]=1"s,
+            "a[18446744073709551616]=1"s,
+            "a=x[0]%5b%5D"s,
+            "a=!$'()*+,;:@-._~"s,
+            "a=\x80"s,
+            "abcdefghijklmnopqrstuvwxyz0123456789=ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"s,
+            "abcdefghijklmnop#=1"s,
+            "a[b]=1&a[0]=2"s,
+            "a=1&a[x]=2"s,
+    };
+
+    QueryStringParser parser;
+    detail::SpiritQueryStringParser spirit(parser.limits());
+    for (auto const& x : inputs) {
+        INFO(x);
+        Variant expected;
+        std::string expected_error;
+        try {
+            spirit.parse(x, expected);
+        } catch (QueryStringError const& e) {
+            expected_error = e.what();
+        }
+        Variant actual;
+        std::string actual_error;
+        try {
+            parser.parse(x, actual);
+        } catch (QueryStringError const& e) {
+            actual_error = e.what();
+        }
+        REQUIRE(actual_error == expected_error);
+        if (expected_error.empty()) {
+            REQUIRE(actual == expected);
+        }
+    }
+}
+
+TEST_CASE("Check QueryStringParser::scan", "[query]") {
+    QueryStringParser parser({1, 1, 1});
+
+    auto const& params = parser.scan("a=1&&b%5Bx%5d[2][]=%5b%41%5D&c=&a=2");
+    REQUIRE(params.size() == 4);
+    REQUIRE(params[0].key == "a");
+    REQUIRE(params[0].value == "1");
+    REQUIRE(params[1].key == "b[x][2][]");
+    REQUIRE(params[1].value == "[A]");
+    REQUIRE(params[2].key == "c");
+    REQUIRE(params[2].value == "");
+    REQUIRE(params[3].key == "a");
+    REQUIRE(params[3].value == "2");
+
+    REQUIRE(parser.scan("").empty());
+    REQUIRE_THROWS_WITH(parser.scan("a[[x]=1"),
+                        R"(expecting <close_bracket> here: "[x]=1")");
+}
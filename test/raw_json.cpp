@@ -0,0 +1,103 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/exception.hpp>
+#include <yenxo/frozen_variant.hpp>
+#include <yenxo/lazy_variant.hpp>
+#include <yenxo/raw_json.hpp>
+#include <yenxo/variant.hpp>
+#include <yenxo/variant_conversion.hpp>
+#include <yenxo/variant_traits.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <rapidjson/document.h>
+
+using namespace yenxo;
+
+namespace {
+
+struct Envelope : trait::Var<Envelope> {
+    std::string id;
+    RawJson meta;
+};
+
+} // namespace
+
+BOOST_HANA_ADAPT_STRUCT(Envelope, id, meta);
+
+TEST_CASE("Check RawJson", "[RawJson]") {
+    SECTION("validation") {
+        REQUIRE(RawJson().json() == "null");
+        REQUIRE(RawJson(" {\"a\": [1, 2]}\n").json() == "{\"a\": [1, 2]}");
+        REQUIRE_THROWS_AS(RawJson("{\"a\": }"), std::runtime_error);
+        REQUIRE_THROWS_AS(RawJson("1 2"), std::runtime_error);
+        REQUIRE_THROWS_AS(RawJson(std::string("1\0 2", 4)), std::runtime_error);
+        REQUIRE(RawJson("[1]").parse() == Variant(Variant::Vec{Variant(1u)}));
+    }
+
+    SECTION("Variant node") {
+        Variant const raw(RawJson("{\"b\":  1.50, \"a\": [ ]}"));
+        REQUIRE(raw.type() == Variant::TypeTag::raw_json);
+        REQUIRE(raw.raw().json() == "{\"b\":  1.50, \"a\": [ ]}");
+        REQUIRE_THROWS_AS(raw.map(), VariantBadType);
+        REQUIRE_THROWS_WITH(raw.int32(), "expected 'int32', actual 'raw json'");
+        REQUIRE_THROWS_AS(Variant().raw(), VariantEmpty);
+        REQUIRE(raw == Variant(RawJson("{\"b\":  1.50, \"a\": [ ]}")));
+        REQUIRE(raw != Variant(RawJson("{\"b\": 1.50, \"a\": []}")));
+
+        Variant const doc(Variant::Vec{Variant(1), raw, Variant(RawJson("\"x\""))});
+        REQUIRE(doc.toJson() == "[1,{\"b\":  1.50, \"a\": [ ]},\"x\"]");
+
+        rapidjson::Document expected;
+        expected.Parse("[1,{\"b\":1.50,\"a\":[]},\"x\"]");
+        rapidjson::Document actual;
+        REQUIRE(doc.to(actual) == expected);
+    }
+
+    SECTION("struct member") {
+        auto const var = Variant::fromJson(R"({"id": "x", "meta": {"k": [1, "v"]}})");
+        auto const envelope = Envelope::fromVariant(var);
+        REQUIRE(envelope.meta.parse() == var.map().at("meta"));
+
+        auto const out = Envelope::toVariant(envelope);
+        REQUIRE(out.map().at("meta").type() == Variant::TypeTag::raw_json);
+        REQUIRE(Envelope::fromVariant(out).meta == envelope.meta);
+        REQUIRE(fromVariant<RawJson>(toVariant(RawJson("[ 1 ]"))).json() == "[ 1 ]");
+    }
+
+    SECTION("from LazyVariant") {
+        auto const doc = LazyVariant::fromJson(R"({"id": "x", "meta": {"k" : [1, "v"] }})");
+        REQUIRE(doc.root().map().at("meta").raw().json() == R"({"k" : [1, "v"] })");
+        REQUIRE(doc.root().map().at("id").raw().json() == "\"x\"");
+    }
+
+    SECTION("FrozenVariant") {
+        Variant const var(Variant::Map{{"m", Variant(RawJson("[1, 2]"))}});
+        auto const frozen = var.freeze();
+        REQUIRE(frozen.root().map().at("m").raw().json() == "[1, 2]");
+        REQUIRE_THROWS_AS(frozen.root().map().at("m").str(), VariantBadType);
+        REQUIRE(frozen.thaw() == var);
+    }
+}
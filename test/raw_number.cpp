@@ -0,0 +1,148 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/exception.hpp>
+#include <yenxo/frozen_variant.hpp>
+#include <yenxo/raw_number.hpp>
+#include <yenxo/variant.hpp>
+#include <yenxo/variant_conversion.hpp>
+#include <yenxo/variant_traits.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <rapidjson/document.h>
+
+using namespace yenxo;
+
+namespace {
+
+struct Quote : trait::Var<Quote> {
+    std::string symbol;
+    RawNumber price;
+};
+
+} // namespace
+
+BOOST_HANA_ADAPT_STRUCT(Quote, symbol, price);
+
+TEST_CASE("Check RawNumber", "[RawNumber]") {
+    auto const json = R"({"big":123456789012345678901234567890,"dec":0.10,"neg":-7,)"
+                      R"("exp":1.5e2,"list":[1,2.50]})";
+    auto const var = Variant::fromJson(json, Variant::NumberParsing::keep_text);
+
+    SECTION("validation") {
+        REQUIRE(RawNumber().text() == "0");
+        REQUIRE(RawNumber("-1.25E+3").text() == "-1.25E+3");
+        REQUIRE_THROWS_AS(RawNumber(""), std::runtime_error);
+        REQUIRE_THROWS_AS(RawNumber("01"), std::runtime_error);
+        REQUIRE_THROWS_AS(RawNumber("1."), std::runtime_error);
+        REQUIRE_THROWS_AS(RawNumber(" 1"), std::runtime_error);
+        REQUIRE_THROWS_AS(RawNumber("1e"), std::runtime_error);
+        REQUIRE(RawNumber("7").parse().type() == Variant::TypeTag::uint32);
+        REQUIRE(RawNumber("-7").parse().type() == Variant::TypeTag::int32);
+        REQUIRE(RawNumber("18446744073709551615").parse() == Variant(UINT64_MAX));
+        REQUIRE(RawNumber("0.5").parse() == Variant(0.5));
+    }
+
+    SECTION("text is kept") {
+        REQUIRE(var.map().at("big").type() == Variant::TypeTag::raw_number);
+        REQUIRE(var.map().at("dec").number().text() == "0.10");
+        REQUIRE(var.map().at("list").vec()[1].number().text() == "2.50");
+        REQUIRE(Variant(Variant::Vec{var.map().at("big"), var.map().at("dec")}).toJson()
+                == "[123456789012345678901234567890,0.10]");
+        REQUIRE(Variant::fromJson("[1.0]").vec()[0].type() == Variant::TypeTag::double_);
+    }
+
+    SECTION("lazy conversion") {
+        REQUIRE(var.map().at("neg").int8() == -7);
+        REQUIRE(var.map().at("neg").floating() == -7.0);
+        REQUIRE(var.map().at("exp").uint16() == 150);
+        REQUIRE(var.map().at("dec").floating() == 0.1);
+        REQUIRE(var.map().at("list").vec()[0].boolean());
+        REQUIRE(var.map().at("big").floating() == 123456789012345678901234567890.0);
+        REQUIRE(var.map().at("neg").int32Or(0) == -7);
+    }
+
+    SECTION("range checks") {
+        REQUIRE_THROWS_WITH(var.map().at("neg").uint32(),
+                            "The type 'uint32' can not hold the value '-7'");
+        REQUIRE_THROWS_WITH(var.map().at("big").uint64(),
+                            "The type 'uint64' can not hold the value "
+                            "'123456789012345678901234567890'");
+        REQUIRE_THROWS_AS(var.map().at("dec").int32(), VariantIntegralOverflow);
+        REQUIRE_THROWS_AS(var.map().at("exp").int8(), VariantIntegralOverflow);
+        REQUIRE_THROWS_AS(Variant(RawNumber("1e400")).floating(), VariantIntegralOverflow);
+        REQUIRE_THROWS_WITH(var.map().at("neg").str(), "expected 'string', actual 'number'");
+        REQUIRE_THROWS_AS(Variant().number(), VariantEmpty);
+    }
+
+    SECTION("comparison") {
+        REQUIRE(Variant(RawNumber("1.0")) != Variant(RawNumber("1")));
+        REQUIRE(equal(Variant(RawNumber("1.0")), Variant(RawNumber("1"))));
+        REQUIRE(equal(Variant(RawNumber("150")), var.map().at("exp")));
+        REQUIRE(equal(Variant(uint8_t(150)), var.map().at("exp")));
+        REQUIRE(!equal(Variant(RawNumber("1")), Variant("1")));
+        REQUIRE(!equal(Variant(RawNumber("18446744073709551616000001")),
+                       Variant(RawNumber("18446744073709551616000002"))));
+        REQUIRE(equal(Variant(RawNumber("18446744073709551616000001")),
+                      Variant(RawNumber("1.8446744073709551616000001e25"))));
+        REQUIRE(!equal(Variant(RawNumber("18446744073709551616000001")),
+                       Variant(18446744073709551616000001.0)));
+        REQUIRE(!equal(Variant(18446744073709551616000001.0),
+                       Variant(RawNumber("18446744073709551616000001"))));
+        REQUIRE(equal(Variant(RawNumber("-0.0")), Variant(RawNumber("0"))));
+        REQUIRE(equal(Variant(RawNumber("100e-2")), Variant(1)));
+        REQUIRE(equal(Variant(RawNumber("0.1")), Variant(0.1)));
+        REQUIRE(!equal(Variant(RawNumber("0.1000000000000000000001")), Variant(0.1)));
+        REQUIRE(equal(Variant(RawNumber("1.0")), Variant(true)));
+    }
+
+    SECTION("DOM output") {
+        rapidjson::Document expected;
+        expected.Parse(json);
+        rapidjson::Document actual;
+        REQUIRE(var.to(actual) == expected);
+    }
+
+    SECTION("struct member") {
+        auto const quote = Quote::fromVariant(
+                Variant::fromJson(R"({"symbol": "X", "price": 10.050})",
+                                  Variant::NumberParsing::keep_text));
+        REQUIRE(quote.price.text() == "10.050");
+        REQUIRE(Quote::toVariant(quote).toJson().find("10.050") != std::string::npos);
+        REQUIRE(Quote::fromVariant(Variant::fromJson(R"({"symbol": "X", "price": 3})"))
+                        .price.text()
+                == "3");
+        REQUIRE_THROWS_AS(
+                Quote::fromVariant(Variant::fromJson(R"({"symbol": "X", "price": "3"})")),
+                VariantBadType);
+    }
+
+    SECTION("FrozenVariant") {
+        auto const frozen = var.freeze();
+        REQUIRE(frozen.root().map().at("neg").int64() == -7);
+        REQUIRE_THROWS_AS(frozen.root().map().at("dec").int64(), VariantIntegralOverflow);
+        REQUIRE(frozen.thaw() == var);
+    }
+}
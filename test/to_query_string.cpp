@@ -0,0 +1,214 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/define_enum.hpp>
+#include <yenxo/from_query_string.hpp>
+#include <yenxo/query_string.hpp>
+#include <yenxo/to_query_string.hpp>
+#include <yenxo/variant.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace yenxo;
+using namespace std::string_literals;
+namespace hana = boost::hana;
+using namespace hana::literals;
+
+namespace {
+
+Variant json(char const* x) {
+    return Variant::fromJson(x);
+}
+
+DEFINE_ENUM(Order, (asc), (desc, , "descending"));
+DEFINE_FLAGS_ENUM(Scope, (none, 0), (read, 1), (write, 2));
+
+struct Page {
+    BOOST_HANA_DEFINE_STRUCT(Page, (uint32_t, number), (std::optional<uint32_t>, size));
+};
+
+struct Search {
+    static auto defaults() {
+        return hana::make_map(hana::make_pair("order"_s, Order::asc));
+    }
+
+    static constexpr auto names() {
+        return hana::make_map(hana::make_pair("query"_s, "q"));
+    }
+
+    BOOST_HANA_DEFINE_STRUCT(Search,
+                             (std::string, query),
+                             (Order, order),
+                             (Scope, scope),
+                             (double, boost),
+                             (bool, exact),
+                             (std::vector<std::string>, tag),
+                             (std::vector<Page>, pages),
+                             (std::map<std::string, int>, weight));
+};
+
+struct WithVariant {
+    BOOST_HANA_DEFINE_STRUCT(WithVariant, (std::string, a), (Variant, extra));
+};
+
+struct SkipDefaults : trait::VarPolicy {
+    static auto constexpr serialize_default_value = false;
+};
+
+} // namespace
+
+TEST_CASE("Check toQueryString", "[query]") {
+    SECTION("scalars") {
+        REQUIRE(toQueryString(json(R"({"a": "x y"})")) == "a=x%20y");
+        REQUIRE(toQueryString(json(R"({"a": 1})")) == "a=1");
+        REQUIRE(toQueryString(json(R"({"a": -1.5})")) == "a=-1.5");
+        REQUIRE(toQueryString(json(R"({"a": true})")) == "a=true");
+        REQUIRE(toQueryString(json(R"({"a": null})")) == "");
+        REQUIRE(toQueryString(json(R"({})")) == "");
+    }
+
+    SECTION("reserved characters") {
+        REQUIRE(toQueryString(json(R"({"a b&c": "[=%+/?#]"})"))
+                == "a%20b%26c=%5B%3D%25%2B%2F%3F%23%5D");
+        REQUIRE(toQueryString(json(R"({"a": "-._~Az09"})")) == "a=-._~Az09");
+        REQUIRE(toQueryString(Variant(VariantMap{{"a", Variant("\xd0\xb9")}}))
+                == "a=%D0%B9");
+    }
+
+    SECTION("deep objects and arrays") {
+        REQUIRE(toQueryString(json(R"({"a": ["1", 2]})")) == "a%5B%5D=1&a%5B%5D=2");
+        REQUIRE(toQueryString(json(R"({"a": {"b": "c"}})")) == "a%5Bb%5D=c");
+        REQUIRE(toQueryString(json(R"({"a": [null, "x"]})")) == "a%5B1%5D=x");
+        REQUIRE(toQueryString(json(R"({"a": [{"b": [1]}]})"))
+                == "a%5B0%5D%5Bb%5D%5B%5D=1");
+        REQUIRE(toQueryString(json(R"({"a": [], "b": {}})")) == "");
+    }
+
+    SECTION("keys starting with a digit") {
+        REQUIRE(toQueryString(json(R"({"0": {"1x": "a"}})")) == "0%5B%31x%5D=a");
+        REQUIRE(toQueryString(json(R"({"0": {"y": {"2": "b"}}})"))
+                == "0%5By%5D%5B%32%5D=b");
+    }
+
+    SECTION("keys without a query string form") {
+        REQUIRE_THROWS_AS(toQueryString(json(R"({"a": {"": 1}})")), QueryStringError);
+        REQUIRE_THROWS_AS(toQueryString(json(R"({"a": {"b]": 1}})")), QueryStringError);
+        REQUIRE_THROWS_AS(toQueryString(json(R"({"a[b]": 1})")), QueryStringError);
+        REQUIRE_THROWS_AS(toQueryString(json(R"({"": 1})")), QueryStringError);
+
+        using Map = std::map<std::string, std::map<std::string, int>>;
+        REQUIRE_THROWS_AS(toQueryString(Map{{"a", {{"", 1}}}}), QueryStringError);
+        REQUIRE_THROWS_AS(toQueryString(Map{{"a", {{"[", 1}}}}), QueryStringError);
+    }
+
+    SECTION("not a map") {
+        REQUIRE_THROWS_AS(toQueryString(json("[1]")), VariantBadType);
+        REQUIRE_THROWS_AS(toQueryString(Variant("x")), VariantBadType);
+    }
+
+    SECTION("round trip") {
+        for (auto const str : {"a=b",
+                               "a=&b=%20",
+                               "a=b&a=c",
+                               "a[]=b",
+                               "a[b][]=b&a[b][]=c",
+                               "a[1]=b",
+                               "a=1&a[2]=2",
+                               "a[b][1]=1&a[b][0]=2",
+                               "a[1][b]=1&a[1][c]=2&a[3][]=x",
+                               "a[b][c][d]=%5B%5D&x=%26%3D%25",
+                               "a=x[0]&b=%2B+",
+                               "a[%30]=1",
+                               "a[%31x]=1&a[b][%39]=2",
+                               "0=1&1x[%32]=2"}) {
+            auto const x = query_string(str);
+            REQUIRE(query_string(toQueryString(x)) == x);
+        }
+    }
+
+    SECTION("writer") {
+        QueryStringWriter writer;
+        auto const x = writer.write(json(R"({"a": "1"})"));
+        REQUIRE(x == "a=1");
+        auto const y = writer.write(json(R"({"b": ["2"]})"));
+        REQUIRE(y == "b%5B%5D=2");
+    }
+}
+
+static_assert(detail::IsQueryMap<std::map<std::string, int>>::value);
+static_assert(!detail::IsQueryMap<std::map<std::wstring, int>>::value);
+
+TEST_CASE("Check toQueryString of structs", "[query]") {
+    Search x;
+    x.query = "a&b";
+    x.order = Order::desc;
+    x.scope = Scope::read | Scope::write;
+    x.boost = 0.5;
+    x.exact = false;
+    x.tag = {"x", "y"};
+    x.pages = {{1, std::nullopt}, {2, 10}};
+    x.weight = {{"w", 3}};
+
+    SECTION("members") {
+        auto const str = toQueryString(x);
+        REQUIRE(str
+                == "q=a%26b&order=descending&scope%5B%5D=read&scope%5B%5D=write&boost=0.5"
+                   "&exact=false&tag%5B%5D=x&tag%5B%5D=y&pages%5B0%5D%5Bnumber%5D=1"
+                   "&pages%5B1%5D%5Bnumber%5D=2&pages%5B1%5D%5Bsize%5D=10"
+                   "&weight%5Bw%5D=3");
+    }
+
+    SECTION("members through toVariant") {
+        WithVariant const y{"1", json(R"({"e": [1, 2]})")};
+        REQUIRE(toQueryString(y) == "a=1&extra%5Be%5D%5B%5D=1&extra%5Be%5D%5B%5D=2");
+    }
+
+    SECTION("policy") {
+        x.order = Order::asc;
+        x.scope = Scope::none;
+        x.tag.clear();
+        x.pages.clear();
+        x.weight.clear();
+        REQUIRE(toQueryString<Search, SkipDefaults>(x)
+                == "q=a%26b&scope=&boost=0.5&exact=false");
+    }
+
+    SECTION("round trip") {
+        auto const y = fromQueryString<Search>(toQueryString(x));
+        REQUIRE(y.query == x.query);
+        REQUIRE(y.order == x.order);
+        REQUIRE(y.scope == x.scope);
+        REQUIRE(y.boost == x.boost);
+        REQUIRE(y.exact == x.exact);
+        REQUIRE(y.tag == x.tag);
+        REQUIRE(y.pages.size() == 2);
+        REQUIRE(y.pages[1].size == 10);
+        REQUIRE(y.weight == x.weight);
+    }
+}
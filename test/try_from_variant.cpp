@@ -0,0 +1,284 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/try_from_variant.hpp>
+#include <yenxo/variant_traits.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace yenxo;
+using namespace boost::hana::literals;
+
+namespace {
+
+enum class Color { red, green };
+
+struct ColorTraits {
+    using Enum [[maybe_unused]] = Color;
+    [[maybe_unused]] static constexpr size_t count = 2;
+    [[maybe_unused]] static constexpr std::array<Enum, count> values{Enum::red,
+                                                                     Enum::green};
+    [[maybe_unused]] static char const* toString(Enum x) {
+        switch (x) {
+        case Enum::red:
+            return "red";
+        case Enum::green:
+            return "green";
+        }
+        throw 1;
+    }
+    static constexpr std::string_view typeName() noexcept {
+        return "Color";
+    }
+};
+
+[[maybe_unused]] ColorTraits traits(Color) {
+    return {};
+}
+
+struct Point : trait::Var<Point> {
+    BOOST_HANA_DEFINE_STRUCT(Point, (int, x), (std::optional<int>, y));
+};
+
+struct Shape : trait::Var<Shape> {
+    BOOST_HANA_DEFINE_STRUCT(Shape,
+                             (std::string, name),
+                             (Color, color),
+                             (std::vector<Point>, points));
+};
+
+struct AB : trait::Var<AB> {
+    BOOST_HANA_DEFINE_STRUCT(AB, (int, a), (std::string, b));
+};
+
+struct StrictPolicy : trait::VarPolicy {
+    static auto constexpr allow_additional_properties = false;
+    static constexpr auto tag = "circle"_s;
+};
+
+struct Circle {
+    BOOST_HANA_DEFINE_STRUCT(Circle, (double, radius));
+    YENXO_FROM_VARIANT_P(Circle, StrictPolicy)
+};
+
+/// Only the throwing conversion
+struct Even {
+    int value;
+
+    static Even fromVariant(Variant const& x) {
+        auto const value = x.int32();
+        if (value % 2 != 0) {
+            throw std::logic_error("odd");
+        }
+        return {value};
+    }
+};
+
+/// The error and the exception of `fromVariant` agree
+template <class T>
+void checkSameAsThrowing(Variant const& var, VariantErrc code, std::string const& path) {
+    auto const ret = tryFromVariant<T>(var);
+    REQUIRE_FALSE(ret);
+    CHECK(ret.error().code() == code);
+    CHECK(ret.error().path() == path);
+    REQUIRE_THROWS_WITH(fromVariant<T>(var), ret.error().message());
+}
+
+} // namespace
+
+TEST_CASE("Check tryFromVariant", "[try_from_variant]") {
+    SECTION("built-in types") {
+        auto const i = tryFromVariant<int>(Variant(5));
+        REQUIRE(i);
+        REQUIRE(*i == 5);
+        REQUIRE(tryFromVariant<std::string>(Variant("a")).value() == "a");
+        REQUIRE(tryFromVariant<double>(Variant(2)).value() == 2.0);
+        REQUIRE(tryFromVariant<Variant>(Variant(VariantVec{})).value()
+                == Variant(VariantVec{}));
+
+        checkSameAsThrowing<int>(Variant(), VariantErrc::empty, "");
+        checkSameAsThrowing<int>(Variant("a"), VariantErrc::bad_type, "");
+        checkSameAsThrowing<std::string>(Variant(1), VariantErrc::bad_type, "");
+        checkSameAsThrowing<uint8_t>(Variant(300), VariantErrc::integral_overflow, "");
+        checkSameAsThrowing<int>(Variant(1.5), VariantErrc::integral_overflow, "");
+        checkSameAsThrowing<bool>(Variant(2), VariantErrc::integral_overflow, "");
+        checkSameAsThrowing<int8_t>(Variant::fromJson("1000"),
+                                    VariantErrc::integral_overflow,
+                                    "");
+    }
+
+    SECTION("containers") {
+        auto const vec = tryFromVariant<std::vector<int>>(Variant::fromJson("[1, 2]"));
+        REQUIRE(vec.value() == std::vector<int>{1, 2});
+
+        auto const map = tryFromVariant<std::map<std::string, int>>(
+                Variant::fromJson(R"({"a": 1})"));
+        REQUIRE(map.value() == std::map<std::string, int>{{"a", 1}});
+
+        auto const pair =
+                tryFromVariant<std::pair<int, bool>>(Variant::fromJson(R"(
+                    {"first": 1, "second": true}
+                )"));
+        REQUIRE(pair.value() == std::pair(1, true));
+
+        auto const bad = tryFromVariant<std::vector<std::vector<int>>>(
+                Variant::fromJson(R"([[1], [2, "x"]])"));
+        REQUIRE_FALSE(bad);
+        REQUIRE(bad.error().code() == VariantErrc::bad_type);
+        REQUIRE(bad.error().path() == "/1/1");
+        REQUIRE(bad.error().message() == "expected 'int32', actual 'string'");
+
+        auto const bad_key = tryFromVariant<std::map<std::string, int>>(
+                Variant::fromJson(R"({"a/b": null})"));
+        REQUIRE_FALSE(bad_key);
+        REQUIRE(bad_key.error().code() == VariantErrc::empty);
+        REQUIRE(bad_key.error().path() == "/a~1b");
+
+        checkSameAsThrowing<std::array<int, 2>>(
+                Variant::fromJson("[1]"), VariantErrc::bad_size, "");
+
+        auto const no_second =
+                tryFromVariant<std::pair<int, int>>(Variant::fromJson(R"({"first": 1})"));
+        REQUIRE_FALSE(no_second);
+        REQUIRE(no_second.error().code() == VariantErrc::missing_member);
+        REQUIRE(no_second.error().message() == "'second' is required");
+    }
+
+    SECTION("enums") {
+        REQUIRE(tryFromVariant<Color>(Variant("green")).value() == Color::green);
+        checkSameAsThrowing<Color>(Variant("blue"), VariantErrc::bad_value, "");
+    }
+
+    SECTION("structs") {
+        auto const var = Variant::fromJson(R"(
+            {
+                "name": "triangle",
+                "color": "red",
+                "points": [{"x": 1}, {"x": 2, "y": 3}]
+            }
+        )");
+        auto const shape = tryFromVariant<Shape>(var);
+        REQUIRE(shape);
+        REQUIRE(shape->points.size() == 2);
+        REQUIRE(!shape->points[0].y);
+        REQUIRE(shape->points[1].y == 3);
+
+        auto bad = var;
+        bad.modifyMap()["points"].modifyVec()[1].modifyMap()["y"] = Variant("3");
+        auto const bad_member = tryFromVariant<Shape>(bad);
+        REQUIRE_FALSE(bad_member);
+        REQUIRE(bad_member.error().code() == VariantErrc::bad_type);
+        REQUIRE(bad_member.error().path() == "/points/1/y");
+
+        auto missing = var;
+        missing.modifyMap().erase("color");
+        checkSameAsThrowing<Shape>(missing, VariantErrc::missing_member, "");
+    }
+
+    SECTION("errors are reported in member order") {
+        checkSameAsThrowing<AB>(
+                Variant::fromJson(R"({"b": 1})"), VariantErrc::missing_member, "");
+        REQUIRE_THROWS_WITH(fromVariant<AB>(Variant::fromJson(R"({"b": "x"})")),
+                            "'a' is required");
+        checkSameAsThrowing<AB>(
+                Variant::fromJson(R"({"a": "x"})"), VariantErrc::bad_type, "/a");
+        checkSameAsThrowing<AB>(
+                Variant::fromJson(R"({"b": 1, "a": "x"})"), VariantErrc::bad_type, "/a");
+        checkSameAsThrowing<AB>(
+                Variant::fromJson(R"({"a": "x", "b": 1})"), VariantErrc::bad_type, "/a");
+        REQUIRE_THROWS_WITH(fromVariant<AB>(Variant::fromJson(R"({"a": "x", "b": 1})")),
+                            "expected 'int32', actual 'string'");
+        checkSameAsThrowing<AB>(
+                Variant::fromJson(R"({"a": 1, "b": 1})"), VariantErrc::bad_type, "/b");
+    }
+
+    SECTION("policy") {
+        auto const circle = tryFromVariant<Circle>(Variant::fromJson(R"(
+            {"__tag": "circle", "radius": 1.5}
+        )"));
+        REQUIRE(circle.value().radius == 1.5);
+
+        checkSameAsThrowing<Circle>(Variant::fromJson(R"({"radius": 1.5})"),
+                                    VariantErrc::missing_member,
+                                    "");
+        checkSameAsThrowing<Circle>(Variant::fromJson(R"(
+                                        {"__tag": "circle", "radius": 1.5, "z": 0}
+                                    )"),
+                                    VariantErrc::unknown_member,
+                                    "");
+
+        auto const wrong_tag = tryFromVariant<Circle>(Variant::fromJson(R"(
+            {"__tag": "square", "radius": 1.5}
+        )"));
+        REQUIRE_FALSE(wrong_tag);
+        REQUIRE(wrong_tag.error().code() == VariantErrc::bad_value);
+        REQUIRE(wrong_tag.error().path() == "/__tag");
+    }
+
+    SECTION("library types") {
+        REQUIRE(tryFromVariant<RawJson>(Variant::fromJson("[1]")).value().json()
+                == "[1]");
+        REQUIRE(tryFromVariant<RawNumber>(Variant(5)).value().text() == "5");
+        checkSameAsThrowing<RawNumber>(Variant("5"), VariantErrc::bad_type, "");
+
+        using Tuple = decltype(boost::hana::make_tuple(1, std::string()));
+        REQUIRE(tryFromVariant<Tuple>(Variant::fromJson(R"([1, "a"])")));
+        auto const short_tuple = tryFromVariant<Tuple>(Variant::fromJson(R"([1])"));
+        REQUIRE(short_tuple.error().code() == VariantErrc::bad_size);
+        REQUIRE(short_tuple.error().message()
+                == "expected size of the tuple is 2, actual 1");
+        auto const bad_element = tryFromVariant<Tuple>(Variant::fromJson(R"([1, 2])"));
+        REQUIRE(bad_element.error().code() == VariantErrc::bad_type);
+        REQUIRE(bad_element.error().path() == "/1");
+
+        using Map = decltype(boost::hana::make_map(
+                boost::hana::make_pair("a"_s, 0), boost::hana::make_pair("b"_s, 0)));
+        auto const map = tryFromVariant<Map>(Variant::fromJson(R"({"a": 1, "b": 2})"));
+        REQUIRE(map.value()["b"_s] == 2);
+        auto const no_b = tryFromVariant<Map>(Variant::fromJson(R"({"a": 1})"));
+        REQUIRE(no_b.error().code() == VariantErrc::missing_member);
+        auto const bad_b = tryFromVariant<Map>(Variant::fromJson(R"({"a": 1, "b": ""})"));
+        REQUIRE(bad_b.error().code() == VariantErrc::bad_type);
+        REQUIRE(bad_b.error().path() == "/b");
+
+        using Two = boost::hana::integral_constant<int, 2>;
+        REQUIRE(tryFromVariant<Two>(Variant(2)));
+        REQUIRE(tryFromVariant<Two>(Variant(3)).error().code() == VariantErrc::bad_value);
+    }
+
+    SECTION("fallback to the throwing conversion") {
+        REQUIRE(tryFromVariant<Even>(Variant(2)).value().value == 2);
+
+        auto const bad = tryFromVariant<Even>(Variant(3));
+        REQUIRE_FALSE(bad);
+        REQUIRE(bad.error().code() == VariantErrc::other);
+        REQUIRE(bad.error().message() == "odd");
+    }
+}
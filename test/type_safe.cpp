@@ -27,6 +27,7 @@
 
 // tested
 #include <yenxo/comparison_traits.hpp>
+#include <yenxo/try_from_variant.hpp>
 #include <yenxo/variant.hpp>
 #include <yenxo/variant_traits.hpp>
 
@@ -76,6 +77,9 @@ TEST_CASE("Check trait::Var with type_safe::strong_typedef", "[variant_traits]")
 
     REQUIRE(Table::fromVariant(Variant(v)) == t);
     REQUIRE(Table::toVariant(t) == Variant(v));
+    REQUIRE(tryFromVariant<Table>(Variant(v)).value() == t);
+    REQUIRE(tryFromVariant<Centimetre>(Variant("1")).error().code()
+            == VariantErrc::bad_type);
 }
 
 namespace {
@@ -104,6 +108,7 @@ TEST_CASE("Check trait::Var with type_safe::constraint_type", "[variant_traits]"
 
     REQUIRE(Pen::fromVariant(Variant(v)) == pen);
     REQUIRE(Pen::toVariant(pen) == Variant(v));
+    REQUIRE(tryFromVariant<Pen>(Variant(v)).value() == pen);
 }
 
 namespace {
@@ -139,6 +144,7 @@ TEST_CASE("Check trait::Var with type_safe build-in types", "[variant_traits]")
 
     REQUIRE(RemoteControl::fromVariant(Variant(v)) == rc);
     REQUIRE(RemoteControl::toVariant(rc) == Variant(v));
+    REQUIRE(tryFromVariant<RemoteControl>(Variant(v)).value() == rc);
 }
 
 #endif
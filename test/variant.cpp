@@ -487,6 +487,42 @@ TEST_CASE("Check Variant", "[Variant]") {
             REQUIRE_THROWS_AS(Variant::fromJson("{abc"), std::runtime_error);
         }
 
+        SECTION("canonical") {
+            Variant::Map a;
+            Variant::Map b;
+            b.reserve(64);
+            for (int i = 0; i < 12; ++i) {
+                a.emplace(std::to_string(i), Variant(i));
+                b.emplace(std::to_string(11 - i), Variant(double(11 - i)));
+            }
+            REQUIRE(Variant(a).toCanonicalJson() == Variant(b).toCanonicalJson());
+
+            RawJson const raw(R"({"y": 1.0, "x": null})");
+            Variant const var(VariantMap{{"b", VariantVec{uint8_t(1), -0.0, 2.5, 1e300}},
+                                         {"a", Variant(raw)},
+                                         {"c", Variant(RawNumber("-3.0"))},
+                                         {"", Variant("\n")}});
+            auto const json = var.toCanonicalJson();
+            REQUIRE(json
+                    == R"({"":"\n","a":{"x":null,"y":1},"b":[1,0,2.5,1.0e300],"c":-3})");
+            REQUIRE(Variant::fromJson(json).toCanonicalJson() == json);
+
+            // `equal` numbers of different types
+            std::pair<Variant, Variant> const same[] = {
+                    {Variant(1e17), Variant(uint64_t(1e17))},
+                    {Variant(-0x1p63), Variant(INT64_MIN)},
+                    {Variant(0x1p63), Variant(uint64_t(1) << 63)},
+                    {Variant(RawNumber("1e17")), Variant(int64_t(1e17))}};
+            for (auto const& [x, y] : same) {
+                REQUIRE(equal(x, y));
+                REQUIRE(x.toCanonicalJson() == y.toCanonicalJson());
+            }
+            REQUIRE(Variant(1e17).toCanonicalJson() == "100000000000000000");
+            REQUIRE(Variant(0x1p64).toCanonicalJson() == "1.8446744073709552e19");
+            REQUIRE(equal(Variant(true), Variant(1)));
+            REQUIRE(Variant(true).toCanonicalJson() == "true");
+        }
+
         SECTION("char") {
             Variant const var(char(1));
             rapidjson::Document expected;
@@ -623,6 +659,21 @@ TEST_CASE("Check Variant", "[Variant]") {
             REQUIRE(equal(Variant("0"), Variant("0")));
         }
 
+        SECTION("map") {
+            REQUIRE(equal(VariantMap{{"a", 1}, {"b", VariantVec{1, 2.5}}},
+                          VariantMap{{"b", VariantVec{1, 2.5}}, {"a", 1}}));
+            VariantMap const map{{"a", 1}, {"b", 2}};
+            REQUIRE(!equal(map, VariantMap{{"a", 1}, {"c", 2}}));
+            REQUIRE(!equal(map, VariantMap{{"a", 1}, {"b", 3}}));
+            REQUIRE(!equal(VariantMap{{"a", 1}}, VariantMap{{"a", 1}, {"b", 2}}));
+        }
+
+        SECTION("array of numbers") {
+            REQUIRE(equal(VariantVec{1, 2, 3.5}, VariantVec{1, 2, 3.5}));
+            REQUIRE(!equal(VariantVec{1, 2, 3.5}, VariantVec{1, 2, 3.0}));
+            REQUIRE(equal(VariantVec{1, int64_t(2)}, VariantVec{uint8_t(1), 2.0}));
+        }
+
         SECTION("allowed conversions of arithmetic types") {
             auto const types = hana::tuple_t<bool,
                                              char,
@@ -653,3 +704,25 @@ TEST_CASE("Check Variant", "[Variant]") {
         }
     }
 }
+
+TEST_CASE("Check Variant::Map key lookup", "[Variant]") {
+    VariantMap const map{{"first", 1}, {"a key longer than the small string buffer", 2}};
+
+    SECTION("string view") {
+        REQUIRE(findKey(map, std::string_view("first"))->second == Variant(1));
+        REQUIRE(findKey(map, "a key longer than the small string buffer")->second ==
+                Variant(2));
+        REQUIRE(findKey(map, "second") == map.end());
+        REQUIRE(atKey(map, std::string("first")) == Variant(1));
+        REQUIRE_THROWS_AS(atKey(map, "second"), std::out_of_range);
+    }
+
+    SECTION("precomputed hash") {
+        constexpr HashedKey first("first");
+        static_assert(first.hash == fnv1a("first"));
+        REQUIRE(StringHash()(first) == StringHash()(std::string("first")));
+        REQUIRE(StringEqual()(first, std::string("first")));
+        REQUIRE(atKey(map, first) == Variant(1));
+        REQUIRE(findKey(map, HashedKey("second")) == map.end());
+    }
+}
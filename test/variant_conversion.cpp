@@ -33,7 +33,9 @@
 #include <boost/hana/fuse.hpp>
 
 #include <map>
+#include <optional>
 #include <set>
+#include <variant>
 
 using namespace yenxo;
 using namespace boost::hana::literals;
@@ -271,6 +273,40 @@ struct SpecialSymbol2 {
     YENXO_FROM_VARIANT(SpecialSymbol2)
     DEFINE_STRUCT(SpecialSymbol2, (int, x, Name("~x/y/~"))); };  } // namespace
 
+TEST_CASE("Check fromVariant from rvalue", "[variant_conversion]") {
+    std::string const text = "a string that does not fit the small string buffer";
+
+    SECTION("string is moved") {
+        Variant var(text);
+        auto const data = var.str().data();
+        auto const x = fromVariant<std::string>(std::move(var));
+        REQUIRE(x == text);
+        REQUIRE(x.data() == data);
+    }
+
+    SECTION("elements are moved") {
+        Variant var(VariantVec{Variant(text)});
+        auto const data = var.vec().front().str().data();
+        auto const x = fromVariant<std::vector<std::string>>(std::move(var));
+        REQUIRE(x == std::vector<std::string>{text});
+        REQUIRE(x.front().data() == data);
+    }
+
+    SECTION("pair") {
+        Variant var(VariantMap{{"first", Variant(text)}, {"second", Variant(1)}});
+        auto const data = var.map().at("first").str().data();
+        auto const x = fromVariant<std::pair<std::string, int>>(std::move(var));
+        REQUIRE(x == std::pair(text, 1));
+        REQUIRE(x.first.data() == data);
+    }
+
+    SECTION("errors are the same") {
+        Variant var(VariantVec{Variant(1)});
+        REQUIRE_THROWS_AS(fromVariant<std::vector<std::string>>(std::move(var)),
+                          VariantBadType);
+    }
+}
+
 TEST_CASE("Check VariantErr::path()", "[exception]") {
     REQUIRE_THROWS_MATCHES(fromVariant<SimpleProperty>(VariantMap{{"x", "1"}}),
                            VariantBadType,
@@ -281,8 +317,98 @@ TEST_CASE("Check VariantErr::path()", "[exception]") {
     REQUIRE_THROWS_MATCHES(fromVariant<SpecialSymbol2>(VariantMap{{"~x/y/~", "1"}}),
                            VariantBadType,
                            PathIs<VariantBadType>("/~0x~1y~1~0"));
+    REQUIRE_THROWS_MATCHES(
+            fromVariant<std::vector<std::vector<int>>>(
+                    Variant::fromJson(R"([[1], [2, "x"]])")),
+            VariantBadType,
+            ExceptionIs<VariantBadType>("expected 'int32', actual 'string'", "/1/1"));
+}
+
+namespace {
+
+struct CirclePolicy : trait::VarPolicy {
+    static constexpr auto tag = "circle"_s;
+};
+
+struct SquarePolicy : trait::VarPolicy {
+    static constexpr auto tag = "square"_s;
+};
+
+struct AnyShape : trait::Var<AnyShape> {
+    BOOST_HANA_DEFINE_STRUCT(AnyShape, (std::optional<double>, size));
+
+    static constexpr std::string_view typeName() noexcept {
+        return "AnyShape";
+    }
+};
+
+struct Circle : trait::Var<Circle, CirclePolicy> {
+    BOOST_HANA_DEFINE_STRUCT(Circle, (double, size));
+
+    static constexpr std::string_view typeName() noexcept {
+        return "Circle";
+    }
+};
+
+struct Square : trait::Var<Square, SquarePolicy> {
+    BOOST_HANA_DEFINE_STRUCT(Square, (double, size));
+
+    static constexpr std::string_view typeName() noexcept {
+        return "Square";
+    }
+};
+
+} // namespace
+
+TEST_CASE("Check std::variant dispatch", "[variant_conversion]") {
+    SECTION("by tag") {
+        using Shape = std::variant<AnyShape, Circle, Square>;
+        auto const square = Variant::fromJson(R"({"__tag": "square", "size": 2})");
+        REQUIRE(std::get<Square>(fromVariant<Shape>(square)).size == 2);
+        REQUIRE(std::get<Square>(tryFromVariant<Shape>(square).value()).size == 2);
+
+        auto const untagged = Variant::fromJson(R"({"size": 2})");
+        REQUIRE(std::holds_alternative<AnyShape>(fromVariant<Shape>(untagged)));
+        REQUIRE(std::holds_alternative<AnyShape>(
+                tryFromVariant<Shape>(untagged).value()));
+
+        auto const bad = Variant::fromJson(R"({"__tag": "circle"})");
+        REQUIRE_THROWS_WITH(fromVariant<Shape>(bad),
+                            "'{ __tag: circle; }' is not of type 'one of [AnyShape, "
+                            "Circle, Square]'");
+        REQUIRE(tryFromVariant<Shape>(bad).error().code() == VariantErrc::bad_value);
+    }
+
+    SECTION("by kind") {
+        using V = std::variant<std::string,
+                               std::vector<int>,
+                               std::map<std::string, int>,
+                               double,
+                               Variant::NullType>;
+        REQUIRE(fromVariant<V>(Variant("a")) == V("a"));
+        REQUIRE(fromVariant<V>(Variant(1)) == V(1.0));
+        REQUIRE(fromVariant<V>(Variant()).index() == 4);
+        REQUIRE(fromVariant<V>(Variant::fromJson("[1]")) == V(std::vector{1}));
+        REQUIRE(fromVariant<V>(Variant::fromJson(R"({"a": 1})"))
+                == V(std::map<std::string, int>{{"a", 1}}));
+        REQUIRE(tryFromVariant<V>(Variant::fromJson("[1]")).value() == V(std::vector{1}));
+        REQUIRE(tryFromVariant<V>(Variant(1)).value() == V(1.0));
+        REQUIRE_THROWS_AS(fromVariant<V>(Variant::fromJson(R"(["a"])")), VariantBadType);
+        REQUIRE(tryFromVariant<V>(Variant::fromJson(R"(["a"])")).error().code()
+                == VariantErrc::bad_value);
+    }
+
+    SECTION("ambiguous alternatives are probed in order") {
+        using V = std::variant<bool, int>;
+        REQUIRE(fromVariant<V>(Variant(1)) == V(true));
+        REQUIRE(fromVariant<V>(Variant(2)) == V(2));
+        REQUIRE(tryFromVariant<V>(Variant(2)).value() == V(2));
+    }
 }
 
+static_assert(detail::acceptedKinds<Circle>() == detail::kindBit(Variant::TypeTag::map));
+static_assert(detail::acceptedKinds<Test>() == detail::any_kind);
+
 static_assert(toVariantConvertible(boost::hana::type_c<Variant>));
 static_assert(toVariantConvertible(boost::hana::type_c<int>));
 static_assert(
@@ -200,6 +200,22 @@ TEST_CASE("detail::toVariant", "[variant_trait_helpers]") {
     }
 }
 
+TEST_CASE("detail::FieldIndex", "[variant_trait_helpers]") {
+    trait::detail::FieldIndex<4> const index({"id", "name", "age", "hobby"});
+    REQUIRE(index.find("id") == 0);
+    REQUIRE(index.find("name") == 1);
+    REQUIRE(index.find("age") == 2);
+    REQUIRE(index.find("hobby") == 3);
+    REQUIRE(index.find("hobb") == index.npos);
+    REQUIRE(index.find("") == index.npos);
+
+    trait::detail::FieldIndex<0> const empty({});
+    REQUIRE(empty.find("id") == empty.npos);
+
+    auto const& person = trait::detail::fieldIndex<Person, trait::VarPolicy>();
+    REQUIRE(person.find("hobby") == 2);
+}
+
 TEST_CASE("Check trait::Var and trait::UpdateFromVar", "[variant_traits]") {
     SECTION("optional") {
         struct Opt
@@ -298,6 +314,42 @@ TEST_CASE("Check trait::Var and trait::UpdateFromVar", "[variant_traits]") {
         REQUIRE(person == person_expected);
     }
 
+    SECTION("Check updateVar with optional nested struct") {
+        struct Parent
+                : trait::Var<Parent>
+                , trait::UpdateFromVar<Parent>
+                , trait::EqualityComparison<Parent> {
+            Parent()
+                    : name("a")
+                    , age(30) {
+            }
+            BOOST_HANA_DEFINE_STRUCT(Parent, (std::string, name), (int, age));
+        };
+
+        struct Person
+                : trait::UpdateFromVar<Person>
+                , trait::EqualityComparison<Person> {
+            BOOST_HANA_DEFINE_STRUCT(Person, (std::optional<Parent>, parent));
+        };
+
+        Person person;
+        person.parent.emplace();
+        person.parent->age = 99;
+
+        person.updateVar(Variant::fromJson(R"({"parent": {"name": "b"}})"));
+        REQUIRE(person.parent);
+        REQUIRE(person.parent->name == "b");
+        REQUIRE(person.parent->age == 99);
+
+        person.updateVar(Variant::fromJson(R"({"parent": null})"));
+        REQUIRE_FALSE(person.parent);
+
+        person.updateVar(Variant::fromJson(R"({"parent": {"name": "c", "age": 1}})"));
+        REQUIRE(person.parent);
+        REQUIRE(person.parent->name == "c");
+        REQUIRE(person.parent->age == 1);
+    }
+
     SECTION("Check updateOpt") {
         OptPerson opt;
         opt.age = 27;
@@ -660,6 +712,14 @@ struct Tagged : trait::Var<Tagged, TagPolicy> {
     BOOST_HANA_DEFINE_STRUCT(Tagged, (int, value));
 };
 
+struct StrictTagPolicy : TagPolicy {
+    static auto constexpr allow_additional_properties = false;
+};
+
+struct StrictTagged : trait::Var<StrictTagged, StrictTagPolicy> {
+    BOOST_HANA_DEFINE_STRUCT(StrictTagged, (int, value), (std::optional<int>, extra));
+};
+
 } // namespace
 
 TEST_CASE("Check Policy::Tag", "[variant_traits]") {
@@ -679,3 +739,38 @@ TEST_CASE("Check Policy::Tag", "[variant_traits]") {
                                        "'foo' is not of type 'a tag literal'", "/__tag"));
     }
 }
+
+TEST_CASE("Check Policy::Tag with allow_additional_properties=false", "[variant_traits]") {
+    Variant var(VariantMap{{"__tag", Variant("a tag")}, {"value", Variant(10)}});
+    REQUIRE(fromVariant<StrictTagged>(var).value == 10);
+    REQUIRE(!fromVariant<StrictTagged>(var).extra);
+
+    var.modifyMap()["u"] = Variant(3);
+    REQUIRE_THROWS_WITH(fromVariant<StrictTagged>(var), "'u' is unknown");
+
+    var.modifyMap().erase("value");
+    REQUIRE_THROWS_WITH(fromVariant<StrictTagged>(var), "'value' is required");
+
+    var.modifyMap().erase("__tag");
+    REQUIRE_THROWS_WITH(fromVariant<StrictTagged>(var), "'__tag' is required");
+
+    // the tag goes first, then the members in declaration order, then the unknown keys
+    auto const precedence = [](char const* json) -> std::string {
+        try {
+            fromVariant<StrictTagged>(Variant::fromJson(json));
+        } catch (std::exception const& e) {
+            return e.what();
+        }
+        return {};
+    };
+    REQUIRE(precedence(R"({"__tag": "a tag", "value": "x", "u": 1})")
+            == "expected 'int32', actual 'string'");
+    REQUIRE(precedence(R"({"__tag": "a tag", "extra": "x", "u": 1})")
+            == "'value' is required");
+    REQUIRE(precedence(R"({"__tag": "a tag", "extra": "x", "value": []})")
+            == "expected 'int32', actual 'list of variant'");
+    REQUIRE(precedence(R"({"__tag": "a tag", "value": 1, "extra": "x", "u": 1})")
+            == "expected 'int32', actual 'string'");
+    REQUIRE(precedence(R"({"__tag": "b tag", "value": "x"})")
+            == "'b tag' is not of type 'a tag literal'");
+}
@@ -0,0 +1,202 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Nicolai Trandafil
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include <yenxo/define_enum.hpp>
+#include <yenxo/exception.hpp>
+#include <yenxo/variant_traits.hpp>
+#include <yenxo/variant_view.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <rapidjson/document.h>
+
+#include <map>
+#include <optional>
+#include <sstream>
+#include <vector>
+
+using namespace yenxo;
+
+namespace {
+
+DEFINE_ENUM(Level, low, high);
+
+struct Id {
+    std::string value;
+};
+
+struct Item : trait::Var<Item> {
+    Id id;
+    std::vector<int> counts;
+};
+
+struct Order : trait::Var<Order> {
+    std::string name;
+    std::optional<double> price;
+    Level level;
+    std::map<std::string, int> totals;
+    std::vector<Item> items;
+    std::pair<int, bool> pair;
+    Variant extra;
+};
+
+struct StrictPolicy : trait::VarPolicy {
+    static auto constexpr allow_additional_properties = false;
+};
+
+struct Strict : trait::Var<Strict, StrictPolicy> {
+    int x;
+};
+
+} // namespace
+
+BOOST_HANA_ADAPT_STRUCT(Item, id, counts);
+BOOST_HANA_ADAPT_STRUCT(Order, name, price, level, totals, items, pair, extra);
+BOOST_HANA_ADAPT_STRUCT(Strict, x);
+
+namespace yenxo {
+
+template <>
+struct FromVariantImpl<Id> {
+    static Id apply(Variant const& x) {
+        return {x.str()};
+    }
+};
+
+} // namespace yenxo
+
+TEST_CASE("Check VariantView", "[VariantView]") {
+    rapidjson::Document doc;
+    doc.Parse(R"({
+        "name": "order",
+        "level": "high",
+        "totals": {"a": 1, "b": -2},
+        "items": [{"id": "i1", "counts": [1, 2]}, {"id": "i2", "counts": []}],
+        "pair": {"first": 3, "second": true},
+        "extra": {"k": [null, 0.5]},
+        "ignored": 1
+    })");
+    VariantView const view(doc);
+
+    SECTION("accessors") {
+        REQUIRE(view.type() == Variant::TypeTag::map);
+        REQUIRE(view.map().size() == 7);
+        REQUIRE(view.map().at("name").str() == "order");
+        REQUIRE(view.map().at("totals").map().at("b").int8() == -2);
+        REQUIRE(view.map().at("totals").map().at("a").type() == Variant::TypeTag::int32);
+        REQUIRE(view.map().count("price") == 0);
+        REQUIRE(view.map().at("items").vec().size() == 2);
+        REQUIRE(view.map().at("items").vec()[1].map().at("id").str() == "i2");
+        REQUIRE(view.map().at("extra").map().at("k").vec()[0].null());
+        REQUIRE(view.map().at("extra").map().at("k").vec()[1].floating() == 0.5);
+        REQUIRE(view.map().at("pair").map().at("second").boolean());
+        REQUIRE(view.variant() == Variant::from(doc));
+
+        std::vector<std::string> keys;
+        for (auto const [key, x] : view.map().at("totals").map()) {
+            keys.emplace_back(key);
+            (void)x;
+        }
+        REQUIRE(keys == std::vector<std::string>{"a", "b"});
+    }
+
+    SECTION("errors are those of Variant") {
+        REQUIRE_THROWS_WITH(view.map().at("items").int32(),
+                            "expected 'int32', actual 'list of variant'");
+        REQUIRE_THROWS_AS(view.map().at("name").vec(), VariantBadType);
+        REQUIRE_THROWS_AS(view.map().at("totals").map().at("b").uint32(),
+                          VariantIntegralOverflow);
+        REQUIRE_THROWS_AS(view.map().at("extra").map().at("k").vec()[0].str(),
+                          VariantEmpty);
+        REQUIRE_THROWS_AS(view.map().at("missing"), std::out_of_range);
+        REQUIRE_THROWS_AS(view.map().at("items").vec().at(2), std::out_of_range);
+    }
+
+    SECTION("fromVariant") {
+        auto const order = fromVariant<Order>(view);
+        auto const expected = fromVariant<Order>(Variant::from(doc));
+        REQUIRE(order.name == "order");
+        REQUIRE(!order.price);
+        REQUIRE(order.level == Level::high);
+        REQUIRE(order.totals == std::map<std::string, int>{{"a", 1}, {"b", -2}});
+        REQUIRE(order.items.size() == 2);
+        REQUIRE(order.items[0].id.value == "i1");
+        REQUIRE(order.items[0].counts == std::vector<int>{1, 2});
+        REQUIRE(order.pair == std::make_pair(3, true));
+        REQUIRE(order.extra == expected.extra);
+        REQUIRE(fromVariant<std::vector<int>>(
+                        view.map().at("items").vec()[0].map().at("counts"))
+                == std::vector<int>{1, 2});
+        REQUIRE(static_cast<std::string>(view.map().at("name")) == "order");
+    }
+
+    SECTION("fromVariant errors") {
+        rapidjson::Document bad;
+        bad.Parse(R"({"name": "x", "level": "high", "totals": {}, "items": [{"id": "i",
+                      "counts": [1, "2"]}], "pair": {"first": 1, "second": false},
+                      "extra": null})");
+        REQUIRE_THROWS_WITH(fromVariant<Order>(VariantView(bad)),
+                            "expected 'int32', actual 'string'");
+
+        rapidjson::Document strict;
+        strict.Parse(R"({"x": 1, "y": 2})");
+        REQUIRE_THROWS_WITH(fromVariant<Strict>(VariantView(strict)), "'y' is unknown");
+    }
+
+    SECTION("repeated keys") {
+        rapidjson::Document repeated;
+        repeated.Parse(R"({"x": 1, "x": 2})");
+        REQUIRE(VariantView(repeated).map().at("x").int32() == 2);
+        REQUIRE(VariantView(repeated).map().at("x").int32()
+                == Variant::from(repeated).map().at("x").int32());
+        REQUIRE(fromVariant<Strict>(VariantView(repeated)).x == 2);
+
+        repeated.Parse(R"({"x": 1, "y": 3, "x": 2, "z": 4, "y": 5})");
+        auto const map = VariantView(repeated).map();
+        REQUIRE(map.size() == 3);
+        REQUIRE(std::distance(map.begin(), map.end()) == 3);
+        REQUIRE(map.find("x")->second.int32() == 2);
+        REQUIRE(map.find("y")->second.int32() == 5);
+        REQUIRE(map.find("z")->second.int32() == 4);
+        using StdMap = std::map<std::string, int>;
+        REQUIRE(fromVariant<StdMap>(VariantView(repeated))
+                == StdMap{{"x", 2}, {"y", 5}, {"z", 4}});
+        REQUIRE(fromVariant<StdMap>(VariantView(repeated))
+                == fromVariant<StdMap>(Variant::from(repeated)));
+
+        // an object too big for the pairwise check
+        std::string json = "{";
+        for (int i = 0; i < 40; ++i) {
+            json += "\"k" + std::to_string(i % 30) + "\": " + std::to_string(i) + ",";
+        }
+        json.back() = '}';
+        repeated.Parse(json.c_str());
+        auto const big = VariantView(repeated).map();
+        REQUIRE(big.size() == 30);
+        REQUIRE(big.at("k5").int32() == 35);
+        REQUIRE(big.at("k15").int32() == 15);
+        REQUIRE(fromVariant<StdMap>(VariantView(repeated))
+                == fromVariant<StdMap>(Variant::from(repeated)));
+    }
+}